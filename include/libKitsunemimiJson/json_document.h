@@ -0,0 +1,59 @@
+/**
+ *  @file    json_document.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_DOCUMENT_H
+#define JSON_DOCUMENT_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <libKitsunemimiJson/json_lazy_item.h>
+#include <libKitsunemimiCommon/logger.h>
+
+namespace Kitsunemimi
+{
+class JsonSimdParser;
+
+class JsonDocument
+{
+public:
+    JsonDocument();
+    ~JsonDocument();
+
+    bool parse(std::string_view input,
+               ErrorContainer &error);
+    bool parse(const char* input,
+               const uint64_t inputSize,
+               ErrorContainer &error);
+
+    JsonLazyItem getRoot() const;
+    JsonLazyItem operator[](const std::string &key) const;
+    JsonLazyItem operator[](const uint32_t index) const;
+
+private:
+    friend class JsonLazyItem;
+
+    JsonSimdParser* m_parser = nullptr;
+    const char* m_input = nullptr;
+    uint64_t m_inputSize = 0;
+    const uint32_t* m_positions = nullptr;
+    uint64_t m_numberOfPositions = 0;
+    bool m_isValid = false;
+
+    // index of the matching closing bracket for each opening bracket within the structural
+    // index, to jump over a whole map or array at once
+    std::vector<uint32_t> m_closeIndex;
+    std::vector<uint32_t> m_openStack;
+
+    uint64_t skipValue(const uint64_t index) const;
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_DOCUMENT_H
@@ -0,0 +1,56 @@
+/**
+ *  @file    json_handler.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_HANDLER_H
+#define JSON_HANDLER_H
+
+#include <string>
+#include <string_view>
+
+#include <libKitsunemimiJson/json_item.h>
+#include <libKitsunemimiCommon/logger.h>
+
+namespace Kitsunemimi
+{
+class JsonKeyPool;
+
+class JsonHandler
+{
+public:
+    JsonHandler();
+    virtual ~JsonHandler();
+
+    virtual bool startObject();
+    virtual bool key(const std::string &key);
+    virtual bool endObject();
+    virtual bool startArray();
+    virtual bool endArray();
+    virtual bool stringValue(const std::string &value);
+    virtual bool integerValue(const long value);
+    virtual bool doubleValue(const double value);
+    virtual bool boolValue(const bool value);
+    virtual bool nullValue();
+};
+
+bool parseJson(std::string_view input,
+               JsonHandler &handler,
+               ErrorContainer &error,
+               const JsonItem::parserTypes parserType = JsonItem::DEFAULT_PARSER,
+               const bool strictMode = false,
+               JsonKeyPool* keyPool = nullptr);
+bool parseJson(const char* input,
+               const uint64_t inputSize,
+               JsonHandler &handler,
+               ErrorContainer &error,
+               const JsonItem::parserTypes parserType = JsonItem::DEFAULT_PARSER,
+               const bool strictMode = false,
+               JsonKeyPool* keyPool = nullptr);
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_HANDLER_H
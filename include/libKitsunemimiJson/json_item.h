@@ -10,23 +10,39 @@
 #define JSON_ITEM_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
+#include <iosfwd>
 
 #include <libKitsunemimiCommon/logger.h>
 
 namespace Kitsunemimi
 {
 class DataItem;
+class DataMap;
+class DataArray;
+class JsonPathMatcher;
+class JsonArena;
 
 class JsonItem
 {
 public:
+    enum parserTypes
+    {
+        DEFAULT_PARSER = 0,
+        BISON_PARSER = 1,
+        SIMD_PARSER = 2,
+    };
+
     JsonItem();
     JsonItem(const JsonItem &otherItem);
+    JsonItem(JsonItem &&otherItem) noexcept;
     JsonItem(DataItem* dataItem, const bool copy = false);
     JsonItem(std::map<std::string, JsonItem> &value);
+    JsonItem(std::map<std::string, JsonItem> &&value);
     JsonItem(std::vector<JsonItem> &value);
+    JsonItem(std::vector<JsonItem> &&value);
     JsonItem(const char* value);
     JsonItem(const std::string &value);
     JsonItem(const int value);
@@ -37,11 +53,40 @@ public:
 
     ~JsonItem();
 
-    bool parse(const std::string &input,
+    bool parse(std::string_view input,
+               ErrorContainer &error,
+               const parserTypes parserType = DEFAULT_PARSER,
+               const bool strictMode = false,
+               const bool useArena = false);
+    bool parse(const char* input,
+               const uint64_t inputSize,
+               ErrorContainer &error,
+               const parserTypes parserType = DEFAULT_PARSER,
+               const bool strictMode = false,
+               const bool useArena = false);
+    bool parseFile(const std::string &filePath,
+                   ErrorContainer &error,
+                   const parserTypes parserType = DEFAULT_PARSER,
+                   const bool strictMode = false,
+                   const bool useArena = false);
+    bool parse(std::string_view input,
+               const JsonPathMatcher &paths,
+               ErrorContainer &error);
+    bool parse(std::string_view input,
+               const std::vector<std::string> &paths,
                ErrorContainer &error);
+    bool parseParallel(std::string_view input,
+                       ErrorContainer &error,
+                       const uint32_t numberOfThreads = 0,
+                       const parserTypes parserType = DEFAULT_PARSER);
+    bool fromCbor(std::string_view input,
+                  ErrorContainer &error);
+    bool fromMsgPack(std::string_view input,
+                     ErrorContainer &error);
 
     // setter
     JsonItem& operator=(const JsonItem& other);
+    JsonItem& operator=(JsonItem&& other);
     JsonItem& operator=(const DataItem* other);
     bool setValue(const char* value);
     bool setValue(const std::string &value);
@@ -53,9 +98,15 @@ public:
     bool insert(const std::string &key,
                 const JsonItem &value,
                 bool force = false);
+    bool insert(const std::string &key,
+                JsonItem &&value,
+                bool force = false);
     bool append(const JsonItem &value);
+    bool append(JsonItem &&value);
     bool replaceItem(const uint32_t index,
                      const JsonItem &value);
+    bool replaceItem(const uint32_t index,
+                     JsonItem &&value);
     bool deleteContent();
 
     // getter
@@ -92,12 +143,43 @@ public:
 
     // output
     const std::string toString(bool indent=false) const;
+    void writeTo(std::string &output,
+                 const bool indent = false) const;
+    bool writeTo(const int fd,
+                 ErrorContainer &error,
+                 const bool indent = false) const;
+    bool writeTo(std::ostream &output,
+                 ErrorContainer &error,
+                 const bool indent = false) const;
+    const std::string toCbor() const;
+    const std::string toMsgPack() const;
+    const std::string toCanonicalString() const;
+    uint64_t hash() const;
+    void hash128(uint64_t &first,
+                 uint64_t &second) const;
+    bool saveSnapshot(const std::string &filePath,
+                      ErrorContainer &error) const;
 
 private:
+    friend class JsonStreamParser;
+    friend class JsonReusableParser;
+
+    JsonItem(JsonArena* arena,
+             DataItem* dataItem);
+
     void clear();
+    bool detachArena();
+    DataItem* takeContent(JsonItem &value);
+    DataMap* prepareInsert(const std::string &key,
+                           const JsonItem &value,
+                           const bool force);
+    DataArray* prepareArray(const JsonItem &value);
 
     bool m_deletable = true;
     DataItem* m_content = nullptr;
+
+    // arena of the document, which is owned by the root-item of the document
+    JsonArena* m_arena = nullptr;
 };
 
 }  // namespace Kitsunemimi
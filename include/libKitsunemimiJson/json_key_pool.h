@@ -0,0 +1,55 @@
+/**
+ *  @file    json_key_pool.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_KEY_POOL_H
+#define JSON_KEY_POOL_H
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include <atomic>
+#include <shared_mutex>
+
+namespace Kitsunemimi
+{
+
+class JsonKeyPool
+{
+public:
+    JsonKeyPool(const uint64_t maxNumberOfKeys = 65536);
+    ~JsonKeyPool();
+
+    const std::string* intern(std::string_view key);
+    const std::string* find(std::string_view key);
+    void clear();
+
+    uint64_t getNumberOfKeys();
+    uint64_t getNumberOfHits() const;
+    uint64_t getSavedBytes() const;
+
+private:
+    friend class JsonKeyCache;
+
+    // the strings are stored in a deque, because it never moves existing elements, so the
+    // views within the map and the returned pointers stay valid until clear is called
+    std::deque<std::string> m_keys;
+    std::unordered_map<std::string_view, const std::string*> m_index;
+    std::shared_mutex m_mutex;
+
+    const uint64_t m_maxNumberOfKeys;
+    std::atomic<uint64_t> m_numberOfHits;
+    std::atomic<uint64_t> m_savedBytes;
+
+    void addStatistics(const uint64_t numberOfHits,
+                       const uint64_t savedBytes);
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_KEY_POOL_H
@@ -0,0 +1,80 @@
+/**
+ *  @file    json_lazy_item.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_LAZY_ITEM_H
+#define JSON_LAZY_ITEM_H
+
+#include <string>
+#include <vector>
+
+#include <libKitsunemimiJson/json_item.h>
+
+namespace Kitsunemimi
+{
+class JsonDocument;
+
+class JsonLazyItem
+{
+public:
+    JsonLazyItem();
+
+    // getter
+    JsonLazyItem operator[](const std::string &key) const;
+    JsonLazyItem operator[](const uint32_t index) const;
+    JsonLazyItem get(const std::string &key) const;
+    JsonLazyItem get(const uint32_t index) const;
+    const std::string getString() const;
+    int getInt() const;
+    float getFloat() const;
+    long getLong() const;
+    double getDouble() const;
+    bool getBool() const;
+    uint64_t size() const;
+    const std::vector<std::string> getKeys() const;
+
+    // checks
+    bool contains(const std::string &key) const;
+    bool isValid() const;
+    bool isNull() const;
+    bool isMap() const;
+    bool isArray() const;
+    bool isValue() const;
+    bool isString() const;
+    bool isFloat() const;
+    bool isInteger() const;
+    bool isBool() const;
+
+    // output
+    JsonItem toJsonItem() const;
+    const std::string toString(bool indent=false) const;
+
+private:
+    friend class JsonDocument;
+
+    JsonLazyItem(const JsonDocument* document,
+                 const uint64_t index);
+
+    // document, which contains the input and its index, and the position of the value
+    // within the structural index
+    const JsonDocument* m_document = nullptr;
+    uint64_t m_index = 0;
+
+    char getFirstChar() const;
+    bool getScalar(const char* &scalar,
+                   uint64_t &length,
+                   bool &quoted) const;
+    uint64_t getKey(const uint64_t index,
+                    const char* &key,
+                    uint64_t &keyLength,
+                    std::string &keyBuffer) const;
+    uint32_t getScalarType() const;
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_LAZY_ITEM_H
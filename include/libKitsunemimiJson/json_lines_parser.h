@@ -0,0 +1,94 @@
+/**
+ *  @file    json_lines_parser.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_LINES_PARSER_H
+#define JSON_LINES_PARSER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <libKitsunemimiJson/json_item.h>
+#include <libKitsunemimiCommon/logger.h>
+
+namespace Kitsunemimi
+{
+
+class JsonLinesParser
+{
+public:
+    struct Record
+    {
+        uint64_t lineNumber = 0;
+        bool success = false;
+        JsonItem item;
+        ErrorContainer error;
+    };
+
+    JsonLinesParser(const uint32_t numberOfThreads = 0,
+                    const JsonItem::parserTypes parserType = JsonItem::DEFAULT_PARSER);
+    ~JsonLinesParser();
+
+    bool parse(std::string_view input,
+               std::vector<Record> &results);
+    bool parse(std::string_view input,
+               const std::function<bool(Record &record)> &callback);
+    bool parseFile(const std::string &filePath,
+                   const std::function<bool(Record &record)> &callback,
+                   ErrorContainer &error);
+
+    uint32_t getNumberOfThreads() const;
+
+private:
+    struct Batch
+    {
+        std::vector<std::string_view> lines;
+        std::vector<uint64_t> lineNumbers;
+        Record* records = nullptr;
+        std::vector<Record> ownRecords;
+        bool done = false;
+    };
+
+    struct LineSplitter
+    {
+        std::string_view input;
+        uint64_t position = 0;
+        uint64_t lineNumber = 0;
+
+        bool nextLine(std::string_view &line,
+                      uint64_t &lineNumber);
+    };
+
+    JsonItem::parserTypes m_parserType = JsonItem::DEFAULT_PARSER;
+    std::vector<std::thread> m_workers;
+    std::deque<Batch*> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_queueCondition;
+    std::condition_variable m_doneCondition;
+    bool m_stop = false;
+
+    // limits for the size of a batch, which is processed by one worker at once
+    const uint64_t m_maxBatchRecords = 1024;
+    const uint64_t m_maxBatchBytes = 256 * 1024;
+
+    bool fillBatch(LineSplitter &splitter,
+                   Batch &batch);
+    void addBatch(Batch* batch);
+    void waitForBatch(Batch* batch);
+    void processBatch(Batch* batch);
+    void run();
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_LINES_PARSER_H
@@ -0,0 +1,54 @@
+/**
+ *  @file    json_path_matcher.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_PATH_MATCHER_H
+#define JSON_PATH_MATCHER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+
+#include <libKitsunemimiCommon/logger.h>
+
+namespace Kitsunemimi
+{
+
+class JsonPathMatcher
+{
+public:
+    JsonPathMatcher();
+    ~JsonPathMatcher();
+
+    bool addPath(const std::string &path,
+                 ErrorContainer &error);
+    uint64_t getNumberOfPaths() const;
+
+private:
+    friend class JsonProjectionParser;
+
+    struct PathNode
+    {
+        std::map<std::string, uint32_t, std::less<>> children;
+        // child for the wildcard '*', which matches all keys and indexes
+        uint32_t anyChild = UINT32_MAX;
+        bool isEnd = false;
+    };
+
+    std::vector<PathNode> m_nodes;
+    uint64_t m_numberOfPaths = 0;
+
+    void getChildren(const std::vector<uint32_t> &nodes,
+                     const std::string_view &key,
+                     std::vector<uint32_t> &result) const;
+    bool isEnd(const std::vector<uint32_t> &nodes) const;
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_PATH_MATCHER_H
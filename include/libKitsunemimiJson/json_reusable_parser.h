@@ -0,0 +1,73 @@
+/**
+ *  @file    json_reusable_parser.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_REUSABLE_PARSER_H
+#define JSON_REUSABLE_PARSER_H
+
+#include <string>
+#include <string_view>
+
+#include <libKitsunemimiJson/json_item.h>
+#include <libKitsunemimiJson/json_tree_handler.h>
+#include <libKitsunemimiCommon/logger.h>
+
+namespace Kitsunemimi
+{
+class JsonHandler;
+class JsonTapeDocument;
+class JsonParserInterface;
+class JsonSimdParser;
+class JsonTapeBuilder;
+class JsonNodePool;
+
+class JsonReusableParser
+{
+public:
+    JsonReusableParser(const JsonItem::parserTypes parserType = JsonItem::DEFAULT_PARSER,
+                       const bool strictMode = false);
+    ~JsonReusableParser();
+
+    bool parse(std::string_view input,
+               JsonItem &result,
+               ErrorContainer &error);
+    bool parse(const char* input,
+               const uint64_t inputSize,
+               JsonItem &result,
+               ErrorContainer &error);
+    bool parse(std::string_view input,
+               JsonTapeDocument &result,
+               ErrorContainer &error);
+    bool parse(std::string_view input,
+               JsonHandler &handler,
+               ErrorContainer &error);
+
+    void recycle(JsonItem &item);
+    void clearPool();
+    uint64_t getNumberOfPooledItems() const;
+
+private:
+    JsonItem::parserTypes m_parserType = JsonItem::DEFAULT_PARSER;
+    bool m_strictMode = false;
+
+    // parser-engines, which are created at the first use and kept with all of their buffers
+    JsonParserInterface* m_bisonParser = nullptr;
+    JsonSimdParser* m_simdParser = nullptr;
+
+    JsonTreeHandler m_treeHandler;
+    JsonTapeBuilder* m_tapeBuilder = nullptr;
+    JsonNodePool* m_pool = nullptr;
+
+    bool runParser(const char* input,
+                   const uint64_t inputSize,
+                   JsonHandler &handler,
+                   ErrorContainer &error);
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_REUSABLE_PARSER_H
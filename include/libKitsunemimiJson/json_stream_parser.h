@@ -0,0 +1,114 @@
+/**
+ *  @file    json_stream_parser.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_STREAM_PARSER_H
+#define JSON_STREAM_PARSER_H
+
+#include <string>
+#include <vector>
+
+#include <libKitsunemimiCommon/logger.h>
+
+namespace Kitsunemimi
+{
+class JsonItem;
+class JsonHandler;
+class JsonTreeHandler;
+class JsonKeyPool;
+class JsonKeyCache;
+
+class JsonStreamParser
+{
+public:
+    JsonStreamParser(const bool strictMode = false);
+    JsonStreamParser(JsonHandler &handler,
+                     const bool strictMode = false,
+                     JsonKeyPool* keyPool = nullptr);
+    ~JsonStreamParser();
+
+    bool feed(const char* data,
+              const uint64_t dataSize,
+              ErrorContainer &error);
+    bool finish(JsonItem &result,
+                ErrorContainer &error);
+    bool finish(ErrorContainer &error);
+    void reset();
+
+    bool hasFailed() const;
+
+private:
+    enum lexerStates
+    {
+        NO_TOKEN_STATE = 0,
+        STRING_STATE = 1,
+        STRING_ESCAPE_STATE = 2,
+        SCALAR_STATE = 3,
+    };
+
+    enum parserStates
+    {
+        VALUE_STATE = 0,
+        VALUE_OR_END_STATE = 1,
+        KEY_STATE = 2,
+        KEY_OR_END_STATE = 3,
+        ASSIGN_STATE = 4,
+        NEXT_STATE = 5,
+        DONE_STATE = 6,
+    };
+
+    enum tokenTypes
+    {
+        MAP_START_TOKEN = 0,
+        MAP_END_TOKEN = 1,
+        ARRAY_START_TOKEN = 2,
+        ARRAY_END_TOKEN = 3,
+        COMMA_TOKEN = 4,
+        ASSIGN_TOKEN = 5,
+        STRING_TOKEN = 6,
+        SCALAR_TOKEN = 7,
+    };
+
+    // lexer-state
+    lexerStates m_lexerState = NO_TOKEN_STATE;
+    std::string m_token = "";
+    uint32_t m_tokenLine = 1;
+    uint32_t m_tokenColumn = 1;
+    uint32_t m_line = 1;
+    uint32_t m_column = 1;
+    uint64_t m_numberOfBytes = 0;
+
+    // parser-state with one entry for each open map (true) or array (false)
+    parserStates m_parserState = VALUE_STATE;
+    std::vector<bool> m_stack;
+    JsonHandler* m_handler = nullptr;
+    JsonTreeHandler* m_treeHandler = nullptr;
+    std::string m_stringBuffer = "";
+    bool m_strictMode = false;
+    JsonKeyCache* m_keyCache = nullptr;
+    bool m_failed = false;
+    std::string m_errorMessage = "";
+
+    bool processToken(const tokenTypes type);
+    bool processValue(const tokenTypes type);
+    bool processKey(const tokenTypes type);
+    bool processClose(const tokenTypes type);
+    bool processScalar(const tokenTypes type);
+    bool decodeToken();
+    bool forwardKey(const std::string &key);
+    bool checkHandlerResult(const bool result);
+    void finishValue();
+
+    bool endScalar();
+    void setError(const std::string &message,
+                  const std::string &brokenPart);
+    void resetState();
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_STREAM_PARSER_H
@@ -0,0 +1,87 @@
+/**
+ *  @file    json_tape_document.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_TAPE_DOCUMENT_H
+#define JSON_TAPE_DOCUMENT_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <libKitsunemimiJson/json_tape_item.h>
+#include <libKitsunemimiCommon/logger.h>
+
+namespace Kitsunemimi
+{
+class JsonFileMapping;
+
+class JsonTapeDocument
+{
+public:
+    JsonTapeDocument();
+    ~JsonTapeDocument();
+
+    bool parse(std::string_view input,
+               ErrorContainer &error,
+               const JsonItem::parserTypes parserType = JsonItem::DEFAULT_PARSER,
+               const bool strictMode = false);
+    bool parse(const char* input,
+               const uint64_t inputSize,
+               ErrorContainer &error,
+               const JsonItem::parserTypes parserType = JsonItem::DEFAULT_PARSER,
+               const bool strictMode = false);
+    bool fromItem(const JsonItem &item,
+                  ErrorContainer &error);
+
+    // snapshot
+    bool saveSnapshot(const std::string &filePath,
+                      ErrorContainer &error) const;
+    bool loadSnapshot(const std::string &filePath,
+                      ErrorContainer &error);
+    bool isSnapshot() const;
+
+    JsonTapeItem getRoot() const;
+    JsonTapeItem operator[](const std::string &key) const;
+    JsonTapeItem operator[](const uint32_t index) const;
+
+    uint64_t getUsedBytes() const;
+
+private:
+    friend class JsonTapeItem;
+    friend class JsonReusableParser;
+
+    // all values in document-order as tagged 64-bit words and the content of all strings
+    std::vector<uint64_t> m_tape;
+    std::string m_strings;
+
+    // positions of the elements of all arrays on the tape, for a direct access by index
+    std::vector<uint32_t> m_arrayIndex;
+
+    // hash-tables of all big maps, for a search of a key without comparing all keys of the map
+    std::vector<uint32_t> m_mapIndex;
+    bool m_isValid = false;
+
+    // content, which is read by the tape-items. It points to the buffers above or into the
+    // mapped file of a snapshot.
+    const uint64_t* m_tapeData = nullptr;
+    const char* m_stringData = nullptr;
+    const uint32_t* m_arrayIndexData = nullptr;
+    const uint32_t* m_mapIndexData = nullptr;
+    uint64_t m_tapeSize = 0;
+    uint64_t m_stringsSize = 0;
+    uint64_t m_arrayIndexSize = 0;
+    uint64_t m_mapIndexSize = 0;
+    JsonFileMapping* m_mapping = nullptr;
+
+    void clearTape();
+    bool finishTape(const bool parseResult);
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_TAPE_DOCUMENT_H
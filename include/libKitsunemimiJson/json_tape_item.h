@@ -0,0 +1,82 @@
+/**
+ *  @file    json_tape_item.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_TAPE_ITEM_H
+#define JSON_TAPE_ITEM_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <libKitsunemimiJson/json_item.h>
+
+namespace Kitsunemimi
+{
+class JsonTapeDocument;
+
+class JsonTapeItem
+{
+public:
+    JsonTapeItem();
+
+    // getter
+    JsonTapeItem operator[](const std::string &key) const;
+    JsonTapeItem operator[](const uint32_t index) const;
+    JsonTapeItem get(const std::string &key) const;
+    JsonTapeItem get(const uint32_t index) const;
+    const std::string getString() const;
+    std::string_view getStringView() const;
+    int getInt() const;
+    float getFloat() const;
+    long getLong() const;
+    double getDouble() const;
+    bool getBool() const;
+    uint64_t size() const;
+    const std::vector<std::string> getKeys(const bool documentOrder = false) const;
+
+    // checks
+    bool contains(const std::string &key) const;
+    bool isValid() const;
+    bool isNull() const;
+    bool isMap() const;
+    bool isArray() const;
+    bool isValue() const;
+    bool isString() const;
+    bool isFloat() const;
+    bool isInteger() const;
+    bool isBool() const;
+
+    // output
+    const std::string toString(bool indent=false,
+                               const bool documentOrder=false) const;
+
+private:
+    friend class JsonTapeDocument;
+
+    JsonTapeItem(const JsonTapeDocument* document,
+                 const uint64_t index);
+
+    // document, which contains the tape, and the position of the value on the tape
+    const JsonTapeDocument* m_document = nullptr;
+    uint64_t m_index = 0;
+
+    uint64_t getWord() const;
+    uint64_t skipValue(const uint64_t index) const;
+    uint64_t findKey(std::string_view key) const;
+    void getEntries(std::vector<std::pair<std::string_view, uint64_t>> &entries,
+                    const bool documentOrder) const;
+    void writeValue(const uint64_t index,
+                    const bool indent,
+                    const bool documentOrder,
+                    const uint32_t level,
+                    std::string &output) const;
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_TAPE_ITEM_H
@@ -0,0 +1,76 @@
+/**
+ *  @file    json_tree_handler.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_TREE_HANDLER_H
+#define JSON_TREE_HANDLER_H
+
+#include <string>
+#include <vector>
+
+#include <libKitsunemimiJson/json_handler.h>
+
+namespace Kitsunemimi
+{
+class DataItem;
+class JsonArena;
+class JsonNodePool;
+
+class JsonTreeHandler
+        : public JsonHandler
+{
+public:
+    JsonTreeHandler();
+    ~JsonTreeHandler();
+
+    bool startObject();
+    bool key(const std::string &key);
+    bool endObject();
+    bool startArray();
+    bool endArray();
+    bool stringValue(const std::string &value);
+    bool integerValue(const long value);
+    bool doubleValue(const double value);
+    bool boolValue(const bool value);
+    bool nullValue();
+
+    DataItem* stealResult();
+    void reset();
+
+private:
+    friend class JsonItem;
+    friend class JsonReusableParser;
+
+    struct StackEntry
+    {
+        DataItem* item = nullptr;
+        bool isMap = false;
+        // true, if the item was not added to the tree because of a duplicate key
+        bool isOrphan = false;
+        std::string key = "";
+    };
+
+    std::vector<StackEntry> m_stack;
+    DataItem* m_root = nullptr;
+
+    // optional arena, where all items are created, instead of allocating each item separately
+    JsonArena* m_arena = nullptr;
+
+    // optional pool of the reusable parser, where items are taken from and given back
+    JsonNodePool* m_pool = nullptr;
+
+    bool addContainer(DataItem* item,
+                      const bool isMap);
+    bool endContainer();
+    bool addValue(DataItem* item);
+    bool attachItem(DataItem* item);
+    void deleteItem(DataItem* item);
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_TREE_HANDLER_H
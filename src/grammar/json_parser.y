@@ -23,13 +23,6 @@
 {
 #include <string>
 #include <iostream>
-#include <libKitsunemimiCommon/items/data_items.h>
-
-using Kitsunemimi::DataItem;
-using Kitsunemimi::DataArray;
-using Kitsunemimi::DataValue;
-using Kitsunemimi::DataMap;
-
 
 namespace Kitsunemimi
 {
@@ -41,6 +34,7 @@ class JsonParserInterface;
 
 // The parsing context.
 %param { Kitsunemimi::JsonParserInterface& driver }
+%param { void* scanner }
 
 %locations
 
@@ -49,7 +43,8 @@ class JsonParserInterface;
 #include <json_parsing/json_parser_interface.h>
 # undef YY_DECL
 # define YY_DECL \
-    Kitsunemimi::JsonParser::symbol_type jsonlex (Kitsunemimi::JsonParserInterface& driver)
+    Kitsunemimi::JsonParser::symbol_type jsonlex (Kitsunemimi::JsonParserInterface& driver, \
+                                                  void* yyscanner)
 YY_DECL;
 }
 
@@ -75,222 +70,156 @@ YY_DECL;
 %token <long> NUMBER "number"
 %token <double> FLOAT "float"
 
-%type  <DataItem*> json_abstract
-%type  <DataValue*> json_value
-%type  <DataArray*> json_array
-%type  <DataArray*> json_array_content
-%type  <DataMap*> json_object
-%type  <DataMap*> json_object_content
-
 %%
 %start startpoint;
 
+// The parser doesn't build any tree by itself. Instead it forwards all parts of the input as
+// events to the handler of the interface in the order of the input. Each event can abort the
+// parsing.
 
 startpoint:
     json_abstract
-    {
-        if(driver.dryRun == false) {
-            driver.setOutput($1);
-        }
-    }
 
 json_abstract:
     json_object
-    {
-        if(driver.dryRun == false) {
-            $$ = (DataItem*)$1;
-        } else {
-            $$ = nullptr;
-        }
-    }
 |
     json_array
-    {
-        if(driver.dryRun == false) {
-            $$ = (DataItem*)$1;
-        } else {
-            $$ = nullptr;
-        }
-    }
 |
     json_value
-    {
-        if(driver.dryRun == false) {
-            $$ = (DataItem*)$1;
-        } else {
-            $$ = nullptr;
-        }
-    }
 
 json_object:
-    "{" json_object_content "}"
+    json_object_start json_object_content "}"
     {
-        $$ = $2;
+        if(driver.endObject() == false) {
+            YYABORT;
+        }
     }
 |
-   "{" "}"
+    json_object_start "}"
     {
-        if(driver.dryRun == false) {
-            $$ = new DataMap();
-        } else {
-            $$ = nullptr;
+        if(driver.endObject() == false) {
+            YYABORT;
         }
     }
 
-json_object_content:
-    json_object_content "," "identifier" ":" json_abstract
+json_object_start:
+    "{"
     {
-        if(driver.dryRun == false) {
-            $1->insert($3, $5);
+        if(driver.startObject() == false) {
+            YYABORT;
         }
-        $$ = $1;
     }
+
+json_object_content:
+    json_object_content "," json_object_key ":" json_abstract
 |
-    "identifier" ":" json_abstract
+    json_object_key ":" json_abstract
+
+json_object_key:
+    "identifier"
     {
-        if(driver.dryRun == false) {
-            $$ = new DataMap();
-            $$->insert($1, $3);
-        } else {
-            $$ = nullptr;
+        if(driver.key($1) == false) {
+            YYABORT;
         }
     }
 |
-    json_object_content "," "string_pln" ":" json_abstract
+    "string_pln"
     {
-        if(driver.dryRun == false) {
-            $1->insert(driver.removeQuotes($3), $5);
+        if(driver.key($1) == false) {
+            YYABORT;
         }
-        $$ = $1;
     }
 |
-    "string_pln" ":" json_abstract
+    "string"
     {
-        if(driver.dryRun == false) {
-            $$ = new DataMap();
-            $$->insert(driver.removeQuotes($1), $3);
-        } else {
-            $$ = nullptr;
+        if(driver.key($1) == false) {
+            YYABORT;
         }
     }
-|
-    json_object_content "," "string" ":" json_abstract
+
+json_array:
+    json_array_start json_array_content "]"
     {
-        if(driver.dryRun == false) {
-            $1->insert(driver.removeQuotes($3), $5);
+        if(driver.endArray() == false) {
+            YYABORT;
         }
-        $$ = $1;
     }
 |
-    "string" ":" json_abstract
+    json_array_start "]"
     {
-        if(driver.dryRun == false) {
-            $$ = new DataMap();
-            $$->insert(driver.removeQuotes($1), $3);
-        } else {
-            $$ = nullptr;
+        if(driver.endArray() == false) {
+            YYABORT;
         }
     }
 
-json_array:
-    "[" json_array_content "]"
-    {
-        $$ = $2;
-    }
-|
-    "[" "]"
+json_array_start:
+    "["
     {
-        if(driver.dryRun == false) {
-            $$ = new DataArray();
-        } else {
-            $$ = nullptr;
+        if(driver.startArray() == false) {
+            YYABORT;
         }
     }
 
 json_array_content:
     json_array_content "," json_abstract
-    {
-        if(driver.dryRun == false) {
-            $1->append($3);
-        }
-        $$ = $1;
-    }
 |
     json_abstract
-    {
-        if(driver.dryRun == false) {
-            $$ = new DataArray();
-            $$->append($1);
-        } else {
-            $$ = nullptr;
-        }
-    }
 
 json_value:
     "string_pln"
     {
-        if(driver.dryRun == false) {
-            $$ = new DataValue($1);
+        if(driver.stringValue($1) == false) {
+            YYABORT;
         }
     }
 |
     "identifier"
     {
-        if(driver.dryRun == false) {
-            $$ = new DataValue($1);
-        } else {
-            $$ = nullptr;
+        if(driver.stringValue($1) == false) {
+            YYABORT;
         }
     }
 |
     "number"
     {
-        if(driver.dryRun == false) {
-            $$ = new DataValue($1);
-        } else {
-            $$ = nullptr;
+        if(driver.integerValue($1) == false) {
+            YYABORT;
         }
     }
 |
     "float"
     {
-        if(driver.dryRun == false) {
-            $$ = new DataValue($1);
-        } else {
-            $$ = nullptr;
+        if(driver.doubleValue($1) == false) {
+            YYABORT;
         }
     }
 |
     "string"
     {
-        if(driver.dryRun == false) {
-            $$ = new DataValue(driver.removeQuotes($1));
-        } else {
-            $$ = nullptr;
+        if(driver.stringValue($1) == false) {
+            YYABORT;
         }
     }
 |
     "true"
     {
-        if(driver.dryRun == false) {
-            $$ = new DataValue(true);
-        } else {
-            $$ = nullptr;
+        if(driver.boolValue(true) == false) {
+            YYABORT;
         }
     }
 |
     "false"
     {
-        if(driver.dryRun == false) {
-            $$ = new DataValue(false);
-        } else {
-            $$ = nullptr;
+        if(driver.boolValue(false) == false) {
+            YYABORT;
         }
     }
 |
     "null"
     {
-        $$ = nullptr;
+        if(driver.nullValue() == false) {
+            YYABORT;
+        }
     }
 
 %%
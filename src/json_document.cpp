@@ -0,0 +1,187 @@
+/**
+ *  @file    json_document.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <libKitsunemimiJson/json_document.h>
+
+#include <libKitsunemimiJson/json_handler.h>
+#include <json_parsing/json_simd_parser.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief The document only checks and indexes the input while parsing. The values are read
+ *        on demand by lazy items, which jump over all unrelated maps and arrays with the help
+ *        of the index, so the input must stay valid as long as the document is used.
+ */
+JsonDocument::JsonDocument()
+{
+    m_parser = new JsonSimdParser();
+}
+
+/**
+ * @brief destructor
+ */
+JsonDocument::~JsonDocument()
+{
+    delete m_parser;
+}
+
+/**
+ * @brief check and index a json-formated string
+ *
+ * @param input string which should be parsed. It is read in place and not copied, so it must
+ *              be valid as long as the document is used.
+ * @param error reference for error-message
+ *
+ * @return true, if successful, else false
+ */
+bool
+JsonDocument::parse(std::string_view input,
+                    ErrorContainer &error)
+{
+    return parse(input.data(), input.size(), error);
+}
+
+/**
+ * @brief check and index a json-formated string
+ *
+ * @param input pointer to the string which should be parsed. It is read in place and not
+ *              copied, so it must be valid as long as the document is used.
+ * @param inputSize length of the string
+ * @param error reference for error-message
+ *
+ * @return true, if successful, else false
+ */
+bool
+JsonDocument::parse(const char* input,
+                    const uint64_t inputSize,
+                    ErrorContainer &error)
+{
+    m_isValid = false;
+    m_input = input;
+    m_inputSize = inputSize;
+
+    // an empty string results in an empty map like in the json-item
+    if(m_inputSize == 0)
+    {
+        m_input = "{}";
+        m_inputSize = 2;
+    }
+
+    // check the syntax without building a tree
+    JsonHandler handler;
+    if(m_parser->parse(m_input, m_inputSize, handler, error) == false) {
+        return false;
+    }
+
+    const JsonStructuralIndex &index = m_parser->getIndex();
+    m_positions = index.getPositions();
+    m_numberOfPositions = index.size();
+
+    // find matching brackets
+    m_closeIndex.resize(m_numberOfPositions);
+    m_openStack.clear();
+    for(uint64_t i = 0; i < m_numberOfPositions; i++)
+    {
+        switch(m_input[m_positions[i]])
+        {
+            case '"':
+                // skip the closing quote, because the index contains both quotes of a string
+                i++;
+                break;
+            case '{':
+            case '[':
+                m_openStack.push_back(static_cast<uint32_t>(i));
+                break;
+            case '}':
+            case ']':
+                m_closeIndex[m_openStack.back()] = static_cast<uint32_t>(i);
+                m_openStack.pop_back();
+                break;
+            default:
+                break;
+        }
+    }
+
+    m_isValid = true;
+
+    // null as only value is also no valid result
+    if(getRoot().isNull())
+    {
+        m_isValid = false;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief get the root-value of the document
+ *
+ * @return root-value, which is invalid, if the document was not successfully parsed
+ */
+JsonLazyItem
+JsonDocument::getRoot() const
+{
+    if(m_isValid == false) {
+        return JsonLazyItem();
+    }
+
+    return JsonLazyItem(this, 0);
+}
+
+/**
+ * @brief get a specific entry of the root-map
+ *
+ * @param key key of the requested value
+ *
+ * @return invalid item, if the key doesn't exist, else the requested value
+ */
+JsonLazyItem
+JsonDocument::operator[](const std::string &key) const
+{
+    return getRoot().get(key);
+}
+
+/**
+ * @brief get a specific entry of the root-array
+ *
+ * @param index index of the requested value
+ *
+ * @return invalid item, if the index is too high, else the requested value
+ */
+JsonLazyItem
+JsonDocument::operator[](const uint32_t index) const
+{
+    return getRoot().get(index);
+}
+
+/**
+ * @brief get the position behind a value within the structural index
+ *
+ * @param index position of the value within the structural index
+ *
+ * @return position of the first token behind the value
+ */
+uint64_t
+JsonDocument::skipValue(const uint64_t index) const
+{
+    switch(m_input[m_positions[index]])
+    {
+        case '{':
+        case '[':
+            return m_closeIndex[index] + 1;
+        case '"':
+            return index + 2;
+        default:
+            return index + 1;
+    }
+}
+
+}  // namespace Kitsunemimi
@@ -0,0 +1,229 @@
+/**
+ *  @file    json_handler.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <libKitsunemimiJson/json_handler.h>
+
+#include <json_parsing/json_parser_interface.h>
+#include <json_parsing/json_simd_parser.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief Base-class for all receivers of parser-events. The parser calls the functions directly
+ *        in the order of the input, without building any tree. Each function can return false to
+ *        abort the parsing. The default-implementations ignore the events, so a handler only has
+ *        to override the events, which are relevant for it.
+ */
+JsonHandler::JsonHandler() {}
+
+/**
+ * @brief destructor
+ */
+JsonHandler::~JsonHandler() {}
+
+/**
+ * @brief called at the beginning of a map
+ *
+ * @return false to abort the parsing, else true
+ */
+bool
+JsonHandler::startObject()
+{
+    return true;
+}
+
+/**
+ * @brief called for the key of each key-value-pair of a map, before the events of the value
+ *
+ * @param key key of the pair
+ *
+ * @return false to abort the parsing, else true
+ */
+bool
+JsonHandler::key(const std::string &)
+{
+    return true;
+}
+
+/**
+ * @brief called at the end of a map
+ *
+ * @return false to abort the parsing, else true
+ */
+bool
+JsonHandler::endObject()
+{
+    return true;
+}
+
+/**
+ * @brief called at the beginning of an array
+ *
+ * @return false to abort the parsing, else true
+ */
+bool
+JsonHandler::startArray()
+{
+    return true;
+}
+
+/**
+ * @brief called at the end of an array
+ *
+ * @return false to abort the parsing, else true
+ */
+bool
+JsonHandler::endArray()
+{
+    return true;
+}
+
+/**
+ * @brief called for a string-value and for an unquoted value, which is no number or keyword
+ *
+ * @param value string-value
+ *
+ * @return false to abort the parsing, else true
+ */
+bool
+JsonHandler::stringValue(const std::string &)
+{
+    return true;
+}
+
+/**
+ * @brief called for an integer-value
+ *
+ * @param value integer-value
+ *
+ * @return false to abort the parsing, else true
+ */
+bool
+JsonHandler::integerValue(const long)
+{
+    return true;
+}
+
+/**
+ * @brief called for a floating-point-value
+ *
+ * @param value floating-point-value
+ *
+ * @return false to abort the parsing, else true
+ */
+bool
+JsonHandler::doubleValue(const double)
+{
+    return true;
+}
+
+/**
+ * @brief called for true and false
+ *
+ * @param value bool-value
+ *
+ * @return false to abort the parsing, else true
+ */
+bool
+JsonHandler::boolValue(const bool)
+{
+    return true;
+}
+
+/**
+ * @brief called for null
+ *
+ * @return false to abort the parsing, else true
+ */
+bool
+JsonHandler::nullValue()
+{
+    return true;
+}
+
+/**
+ * @brief parse a json-formated string and forward its content as events to a handler
+ *
+ * @param input json-formated string, which should be parsed. It is never copied as a whole: the
+ *              simd-parser reads it in place and the bison-parser copies it in small parts into
+ *              the buffer of its scanner.
+ * @param handler handler, which receives the events
+ * @param error reference for error-message output
+ * @param parserType parser, which should be used
+ * @param strictMode true to reject strings with invalid escape-sequences, control characters
+ *                   or invalid utf-8
+ * @param keyPool optional pool to intern the keys. If set, the handler gets for equal keys
+ *                always the same string-object from the pool.
+ *
+ * @return false, if the input is invalid or the handler has aborted the parsing, else true. In
+ *         case of an error, the handler can already have received the events of the input
+ *         before the error.
+ */
+bool
+parseJson(std::string_view input,
+          JsonHandler &handler,
+          ErrorContainer &error,
+          const JsonItem::parserTypes parserType,
+          const bool strictMode,
+          JsonKeyPool* keyPool)
+{
+    return parseJson(input.data(), input.size(), handler, error, parserType, strictMode, keyPool);
+}
+
+/**
+ * @brief parse a json-formated string and forward its content as events to a handler
+ *
+ * @param input pointer to the json-formated string, which should be parsed. It doesn't have to
+ *              be null-terminated and is never copied as a whole: the simd-parser reads it in
+ *              place and the bison-parser copies it in small parts into the buffer of its scanner.
+ * @param inputSize length of the json-formated string
+ * @param handler handler, which receives the events
+ * @param error reference for error-message output
+ * @param parserType parser, which should be used. The default is the bison-parser, or the
+ *                   simd-parser, if the library was build with "CONFIG += simd_parser_default".
+ *                   Both create the same events.
+ * @param strictMode true to reject strings with invalid escape-sequences, control characters
+ *                   or invalid utf-8
+ * @param keyPool optional pool to intern the keys. If set, the handler gets for equal keys
+ *                always the same string-object from the pool.
+ *
+ * @return false, if the input is invalid or the handler has aborted the parsing, else true
+ */
+bool
+parseJson(const char* input,
+          const uint64_t inputSize,
+          JsonHandler &handler,
+          ErrorContainer &error,
+          const JsonItem::parserTypes parserType,
+          const bool strictMode,
+          JsonKeyPool* keyPool)
+{
+    JsonItem::parserTypes usedParser = parserType;
+    if(usedParser == JsonItem::DEFAULT_PARSER)
+    {
+#ifdef JSON_SIMD_PARSER_DEFAULT
+        usedParser = JsonItem::SIMD_PARSER;
+#else
+        usedParser = JsonItem::BISON_PARSER;
+#endif
+    }
+
+    // use a parser-instance only for this call, so parallel calls doesn't have to wait for
+    // each other
+    if(usedParser == JsonItem::SIMD_PARSER)
+    {
+        JsonSimdParser parser;
+        return parser.parse(input, inputSize, handler, error, strictMode, keyPool);
+    }
+
+    JsonParserInterface parser;
+    return parser.parse(input, inputSize, handler, error, strictMode, keyPool);
+}
+
+}  // namespace Kitsunemimi
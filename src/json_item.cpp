@@ -9,7 +9,16 @@
 #include <libKitsunemimiJson/json_item.h>
 
 #include <libKitsunemimiCommon/items/data_items.h>
-#include <json_parsing/json_parser_interface.h>
+#include <libKitsunemimiJson/json_tree_handler.h>
+#include <libKitsunemimiJson/json_tape_document.h>
+#include <json_parsing/json_file_mapping.h>
+#include <json_parsing/json_parallel_parser.h>
+#include <json_parsing/json_projection_parser.h>
+#include <json_parsing/json_writer.h>
+#include <json_parsing/json_arena.h>
+#include <json_parsing/json_binary_parser.h>
+#include <json_parsing/json_binary_writer.h>
+#include <json_parsing/json_canonical_writer.h>
 
 using Kitsunemimi::DataItem;
 using Kitsunemimi::DataArray;
@@ -42,6 +51,33 @@ JsonItem::JsonItem(const JsonItem &otherItem)
     }
 }
 
+/**
+ * @brief creates a new item by taking the content of another item without copy. The other item
+ *        is empty afterwards. An item, which only points into the tree of another item, doesn't
+ *        own its content, so in this case the content is copied like by the copy-constructor.
+ *        The constructor is noexcept, so containers like std::vector move their items instead of
+ *        copying them. Items, which are moved into a container, are always copied from a view
+ *        there, so for the moves of a growing container only the owned content is taken, which
+ *        never allocates.
+ *
+ * @param otherItem other item, whose content should be taken
+ */
+JsonItem::JsonItem(JsonItem &&otherItem) noexcept
+{
+    if(otherItem.m_deletable == false)
+    {
+        if(otherItem.m_content != nullptr) {
+            m_content = otherItem.m_content->copy();
+        }
+        return;
+    }
+
+    m_content = otherItem.m_content;
+    m_arena = otherItem.m_arena;
+    otherItem.m_content = nullptr;
+    otherItem.m_arena = nullptr;
+}
+
 /**
  * @brief creates a new item
  *
@@ -63,6 +99,20 @@ JsonItem::JsonItem(DataItem* dataItem,
     }
 }
 
+/**
+ * @brief creates an item, which points to a part of an arena-document
+ *
+ * @param arena arena of the document
+ * @param dataItem pointer to the part of the document
+ */
+JsonItem::JsonItem(JsonArena* arena,
+                   DataItem* dataItem)
+{
+    m_content = dataItem;
+    m_deletable = false;
+    m_arena = arena;
+}
+
 /**
  * @brief creates an object-item
  *
@@ -81,6 +131,24 @@ JsonItem::JsonItem(std::map<std::string, JsonItem> &value)
     }
 }
 
+/**
+ * @brief creates an object-item, which takes the content of the items of the map without copy
+ *
+ * @param value map for the new object, which can be empty. Its items are empty afterwards.
+ */
+JsonItem::JsonItem(std::map<std::string, JsonItem> &&value)
+{
+    m_content = new DataMap();
+
+    std::map<std::string, JsonItem>::iterator it;
+    for(it = value.begin();
+        it != value.end();
+        it++)
+    {
+        insert(it->first, std::move(it->second));
+    }
+}
+
 /**
  * @brief creates an array-item
  *
@@ -99,6 +167,24 @@ JsonItem::JsonItem(std::vector<JsonItem> &value)
     }
 }
 
+/**
+ * @brief creates an array-item, which takes the content of the items of the vector without copy
+ *
+ * @param value vector for the new object, which can be empty. Its items are empty afterwards.
+ */
+JsonItem::JsonItem(std::vector<JsonItem> &&value)
+{
+    m_content = new DataArray();
+
+    std::vector<JsonItem>::iterator it;
+    for(it = value.begin();
+        it != value.end();
+        it++)
+    {
+        append(std::move(*it));
+    }
+}
+
 JsonItem::JsonItem(const char* value)
 {
     m_content = new DataValue(value);
@@ -145,26 +231,271 @@ JsonItem::~JsonItem()
 /**
  * @brief convert a json-formated string into a json-object-tree
  *
- * @param input json-formated string, which should be parsed
+ * @param input json-formated string, which should be parsed. It is never copied as a whole: the
+ *              simd-parser reads it in place and the bison-parser copies it in small parts into
+ *              the buffer of its scanner.
  * @param error reference for error-message output
+ * @param parserType parser, which should be used. The default is the bison-parser, or the
+ *                   simd-parser, if the library was build with "CONFIG += simd_parser_default".
+ *                   Both create the same tree.
+ * @param strictMode true to reject strings with invalid escape-sequences, control characters
+ *                   or invalid utf-8
+ * @param useArena true to create all items of the tree within one arena, which is deleted at
+ *                 once together with the item. Parts of such a tree can only be read. Changes
+ *                 of the root-item convert the tree into normal items before.
  *
  * @return true, if successful, else false
  */
 bool
-JsonItem::parse(const std::string &input,
+JsonItem::parse(std::string_view input,
+                ErrorContainer &error,
+                const parserTypes parserType,
+                const bool strictMode,
+                const bool useArena)
+{
+    return parse(input.data(), input.size(), error, parserType, strictMode, useArena);
+}
+
+/**
+ * @brief convert a json-formated string into a json-object-tree
+ *
+ * @param input pointer to the json-formated string, which should be parsed. It doesn't have to
+ *              be null-terminated and is never copied as a whole: the simd-parser reads it in
+ *              place and the bison-parser copies it in small parts into the buffer of its scanner.
+ * @param inputSize length of the json-formated string
+ * @param error reference for error-message output
+ * @param parserType parser, which should be used
+ * @param strictMode true to reject strings with invalid escape-sequences, control characters
+ *                   or invalid utf-8
+ * @param useArena true to create all items of the tree within one arena
+ *
+ * @return true, if successful, else false
+ */
+bool
+JsonItem::parse(const char* input,
+                const uint64_t inputSize,
+                ErrorContainer &error,
+                const parserTypes parserType,
+                const bool strictMode,
+                const bool useArena)
+{
+    // an empty string results in an empty map
+    if(inputSize == 0)
+    {
+        clear();
+        m_content = new DataMap();
+        m_deletable = true;
+        return true;
+    }
+
+    // build the tree out of the events of the parser
+    JsonArena* arena = nullptr;
+    if(useArena) {
+        arena = new JsonArena();
+    }
+    JsonTreeHandler handler;
+    handler.m_arena = arena;
+    if(parseJson(input, inputSize, handler, error, parserType, strictMode) == false)
+    {
+        handler.reset();
+        delete arena;
+        return false;
+    }
+
+    // process a failure, where null as only value is also no valid result
+    DataItem* result = handler.stealResult();
+    if(result == nullptr)
+    {
+        delete arena;
+        return false;
+    }
+
+    clear();
+
+    m_content = result;
+    m_deletable = true;
+    m_arena = arena;
+
+    return true;
+}
+
+/**
+ * @brief convert the content of a json-formated file into a json-object-tree. The file is mapped
+ *        into the memory and parsed directly from there, so it is never completely copied.
+ *
+ * @param filePath path to the file, which should be parsed
+ * @param error reference for error-message output
+ * @param parserType parser, which should be used
+ * @param strictMode true to reject strings with invalid escape-sequences, control characters
+ *                   or invalid utf-8
+ * @param useArena true to create all items of the tree within one arena
+ *
+ * @return true, if successful, else false
+ */
+bool
+JsonItem::parseFile(const std::string &filePath,
+                    ErrorContainer &error,
+                    const parserTypes parserType,
+                    const bool strictMode,
+                    const bool useArena)
+{
+    JsonFileMapping file;
+    if(file.open(filePath, error) == false) {
+        return false;
+    }
+
+    return parse(file.getData(), file.getSize(), error, parserType, strictMode, useArena);
+}
+
+/**
+ * @brief parse only the parts of a string, which match with a set of paths. All maps and arrays,
+ *        which can not match, are skipped without parsing them, so their content is only
+ *        checked for matching brackets and quotes.
+ *
+ * @param input string which should be parsed
+ * @param paths compiled set of paths in the JSON-Pointer-format
+ * @param error reference for error-message
+ *
+ * @return true, if successful, else false
+ */
+bool
+JsonItem::parse(std::string_view input,
+                const JsonPathMatcher &paths,
                 ErrorContainer &error)
 {
-    JsonParserInterface* parser = JsonParserInterface::getInstance();
+    // an empty string results in an empty map
+    if(input.size() == 0)
+    {
+        clear();
+        m_content = new DataMap();
+        m_deletable = true;
+        return true;
+    }
 
-    // parse ini-template into a json-tree
+    JsonProjectionParser parser;
     DataItem* result = nullptr;
-    if(input.size() > 0) {
-        result = parser->parse(input, error);
-    } else {
-        result = new DataMap();
+    if(parser.parse(input.data(), input.size(), paths, result, error) == false) {
+        return false;
+    }
+
+    clear();
+
+    m_content = result;
+    m_deletable = true;
+
+    return true;
+}
+
+/**
+ * @brief parse only the parts of a string, which match with a set of paths
+ *
+ * @param input string which should be parsed
+ * @param paths list of paths in the JSON-Pointer-format like "/items/0/price", where a
+ *              segment '*' matches all keys or indexes
+ * @param error reference for error-message
+ *
+ * @return true, if successful, else false
+ */
+bool
+JsonItem::parse(std::string_view input,
+                const std::vector<std::string> &paths,
+                ErrorContainer &error)
+{
+    JsonPathMatcher matcher;
+    for(const std::string &path : paths)
+    {
+        if(matcher.addPath(path, error) == false) {
+            return false;
+        }
     }
 
-    // process a failure
+    return parse(input, matcher, error);
+}
+
+/**
+ * @brief parse a string, which consists of one big array, where the elements of the array are
+ *        parsed in parallel by multiple threads. Input, which is no array or too small, is
+ *        parsed like with the normal parse-function.
+ *
+ * @param input string which should be parsed. It is never copied as a whole, but the
+ *              bison-parser copies the elements in small parts into the buffer of its scanner.
+ * @param error reference for error-message
+ * @param numberOfThreads number of threads (0 = number of available cpu-cores)
+ * @param parserType parser, which should be used for the parsing
+ *
+ * @return true, if successful, else false
+ */
+bool
+JsonItem::parseParallel(std::string_view input,
+                        ErrorContainer &error,
+                        const uint32_t numberOfThreads,
+                        const parserTypes parserType)
+{
+    JsonParallelParser parser;
+    DataItem* result = parser.parse(input.data(), input.size(), numberOfThreads, parserType);
+
+    // fallback to the serial parser, which also creates the exact error-message in case of
+    // an invalid input
+    if(result == nullptr) {
+        return parse(input, error, parserType);
+    }
+
+    clear();
+
+    m_content = result;
+    m_deletable = true;
+
+    return true;
+}
+
+/**
+ * @brief convert binary data into a tree of items
+ *
+ * @param input data, which should be parsed
+ * @param format format of the data
+ * @param error reference for error-message
+ *
+ * @return root of the new tree, or nullptr, if the data are invalid
+ */
+static DataItem*
+parseBinary(std::string_view input,
+            const JsonBinaryParser::binaryFormats format,
+            ErrorContainer &error)
+{
+    JsonTreeHandler handler;
+    JsonBinaryParser parser;
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(input.data());
+    if(parser.parse(data, input.size(), format, handler, error) == false)
+    {
+        handler.reset();
+        return nullptr;
+    }
+
+    // null as only value is also no valid result
+    DataItem* result = handler.stealResult();
+    if(result == nullptr)
+    {
+        error.addMeesage("null as only value is not a valid result");
+        LOG_ERROR(error);
+    }
+
+    return result;
+}
+
+/**
+ * @brief convert CBOR-data (RFC 8949) directly into a json-object-tree without any intermediate
+ *        json-string
+ *
+ * @param input CBOR-data, which should be parsed. They are read in place and not copied.
+ * @param error reference for error-message
+ *
+ * @return true, if successful, else false
+ */
+bool
+JsonItem::fromCbor(std::string_view input,
+                   ErrorContainer &error)
+{
+    DataItem* result = parseBinary(input, JsonBinaryParser::CBOR_FORMAT, error);
     if(result == nullptr) {
         return false;
     }
@@ -172,6 +503,33 @@ JsonItem::parse(const std::string &input,
     clear();
 
     m_content = result;
+    m_deletable = true;
+
+    return true;
+}
+
+/**
+ * @brief convert MessagePack-data directly into a json-object-tree without any intermediate
+ *        json-string
+ *
+ * @param input MessagePack-data, which should be parsed. They are read in place and not copied.
+ * @param error reference for error-message
+ *
+ * @return true, if successful, else false
+ */
+bool
+JsonItem::fromMsgPack(std::string_view input,
+                      ErrorContainer &error)
+{
+    DataItem* result = parseBinary(input, JsonBinaryParser::MSGPACK_FORMAT, error);
+    if(result == nullptr) {
+        return false;
+    }
+
+    clear();
+
+    m_content = result;
+    m_deletable = true;
 
     return true;
 }
@@ -188,17 +546,51 @@ JsonItem::operator=(const JsonItem &other)
 {
     if(this != &other)
     {
-        clear();
+        // copy before the old content is deleted, because the other item can point into it
+        DataItem* content = nullptr;
         if(other.m_content != nullptr) {
-            m_content = other.m_content->copy();
-        } else {
-            m_content = other.m_content;
+            content = other.m_content->copy();
         }
+
+        clear();
+        m_deletable = true;
+        m_content = content;
     }
 
     return *this;
 }
 
+/**
+ * @brief replace the content of the item with the content of another item without copy. Like
+ *        for the move-constructor, the content of an item, which only points into another
+ *        tree, is copied, before the old content is deleted, because the other item can point
+ *        into it. The copy can fail, so the assignment is not noexcept.
+ *
+ * @param other other item, whose content should be taken
+ *
+ * @return pointer to this current item
+ */
+JsonItem&
+JsonItem::operator=(JsonItem &&other)
+{
+    if(this == &other) {
+        return *this;
+    }
+
+    if(other.m_deletable == false) {
+        return operator=(static_cast<const JsonItem&>(other));
+    }
+
+    clear();
+    m_deletable = true;
+    m_content = other.m_content;
+    m_arena = other.m_arena;
+    other.m_content = nullptr;
+    other.m_arena = nullptr;
+
+    return *this;
+}
+
 
 /**
  * @brief replace the content of the item with the content of another item
@@ -210,13 +602,15 @@ JsonItem::operator=(const JsonItem &other)
 JsonItem&
 JsonItem::operator=(const DataItem* other)
 {
-    clear();
+    DataItem* content = nullptr;
     if(other != nullptr) {
-        m_content = other->copy();
-    } else {
-        m_content = nullptr;
+        content = other->copy();
     }
 
+    clear();
+    m_deletable = true;
+    m_content = content;
+
     return *this;
 }
 
@@ -226,6 +620,10 @@ JsonItem::operator=(const DataItem* other)
 bool
 JsonItem::setValue(const char* value)
 {
+    if(detachArena() == false) {
+        return false;
+    }
+
     if(m_content == nullptr) {
         m_content = new DataValue();
     }
@@ -245,6 +643,10 @@ JsonItem::setValue(const char* value)
 bool
 JsonItem::setValue(const std::string &value)
 {
+    if(detachArena() == false) {
+        return false;
+    }
+
     if(m_content == nullptr) {
         m_content = new DataValue();
     }
@@ -264,6 +666,10 @@ JsonItem::setValue(const std::string &value)
 bool
 JsonItem::setValue(const int &value)
 {
+    if(detachArena() == false) {
+        return false;
+    }
+
     if(m_content == nullptr) {
         m_content = new DataValue();
     }
@@ -283,6 +689,10 @@ JsonItem::setValue(const int &value)
 bool
 JsonItem::setValue(const float &value)
 {
+    if(detachArena() == false) {
+        return false;
+    }
+
     if(m_content == nullptr) {
         m_content = new DataValue();
     }
@@ -302,6 +712,10 @@ JsonItem::setValue(const float &value)
 bool
 JsonItem::setValue(const long &value)
 {
+    if(detachArena() == false) {
+        return false;
+    }
+
     if(m_content == nullptr) {
         m_content = new DataValue();
     }
@@ -321,6 +735,10 @@ JsonItem::setValue(const long &value)
 bool
 JsonItem::setValue(const double &value)
 {
+    if(detachArena() == false) {
+        return false;
+    }
+
     if(m_content == nullptr) {
         m_content = new DataValue();
     }
@@ -340,6 +758,10 @@ JsonItem::setValue(const double &value)
 bool
 JsonItem::setValue(const bool &value)
 {
+    if(detachArena() == false) {
+        return false;
+    }
+
     if(m_content == nullptr) {
         m_content = new DataValue();
     }
@@ -367,24 +789,36 @@ JsonItem::insert(const std::string &key,
                  const JsonItem &value,
                  bool force)
 {
-    if(value.m_content == nullptr
-            || key == "")
-    {
+    DataMap* map = prepareInsert(key, value, force);
+    if(map == nullptr) {
         return false;
     }
 
-    if(m_content == nullptr) {
-        m_content = new DataMap();
-    }
+    return map->insert(key, value.m_content->copy(), force);
+}
 
-    if(m_content->getType() == DataItem::MAP_TYPE)
-    {
-        return m_content->toMap()->insert(key,
-                                          value.m_content->copy(),
-                                          force);
+/**
+ * @brief insert a key-value-pair if the current item is a json-object, where the content of the
+ *        value is taken without copy, so a tree can be build bottom-up in linear time
+ *
+ * @param key key of the new pair
+ * @param value new json-item-object, which is empty afterwards. It stays unchanged, if the
+ *              insert failed.
+ * @param force true to overwrite an existing key (default: false)
+ *
+ * @return false, if item is not a json-object, else true
+ */
+bool
+JsonItem::insert(const std::string &key,
+                 JsonItem &&value,
+                 bool force)
+{
+    DataMap* map = prepareInsert(key, value, force);
+    if(map == nullptr) {
+        return false;
     }
 
-    return false;
+    return map->insert(key, takeContent(value), force);
 }
 
 /**
@@ -397,21 +831,34 @@ JsonItem::insert(const std::string &key,
 bool
 JsonItem::append(const JsonItem &value)
 {
-    if(value.m_content == nullptr) {
+    DataArray* array = prepareArray(value);
+    if(array == nullptr) {
         return false;
     }
 
-    if(m_content == nullptr) {
-        m_content = new DataArray();
-    }
+    array->append(value.m_content->copy());
+    return true;
+}
 
-    if(m_content->getType() == DataItem::ARRAY_TYPE)
-    {
-        m_content->toArray()->append(value.m_content->copy());
-        return true;
+/**
+ * @brief add a new item, if the current item is a json-array, where the content of the new item
+ *        is taken without copy
+ *
+ * @param value new json-item-object, which is empty afterwards. It stays unchanged, if the
+ *              append failed.
+ *
+ * @return false, if item is not a json-array, else true
+ */
+bool
+JsonItem::append(JsonItem &&value)
+{
+    DataArray* array = prepareArray(value);
+    if(array == nullptr) {
+        return false;
     }
 
-    return false;
+    array->append(takeContent(value));
+    return true;
 }
 
 /**
@@ -426,23 +873,41 @@ bool
 JsonItem::replaceItem(const uint32_t index,
                       const JsonItem &value)
 {
-    if(value.m_content == nullptr) {
+    DataArray* array = prepareArray(value);
+    if(array == nullptr
+            || array->array.size() <= index)
+    {
         return false;
     }
 
-    if(m_content == nullptr) {
-        m_content = new DataArray();
-    }
+    delete array->array[index];
+    array->array[index] = value.m_content->copy();
+    return true;
+}
 
-    if(m_content->getType() == DataItem::ARRAY_TYPE
-            && m_content->toArray()->array.size() > index)
+/**
+ * @brief replace an item within a array, where the content of the new item is taken without copy
+ *
+ * @param index position in the array
+ * @param value new json-item-object, which is empty afterwards. It stays unchanged, if the
+ *              replacement failed.
+ *
+ * @return false, if items not valid of index too high, else true
+ */
+bool
+JsonItem::replaceItem(const uint32_t index,
+                      JsonItem &&value)
+{
+    DataArray* array = prepareArray(value);
+    if(array == nullptr
+            || array->array.size() <= index)
     {
-        delete m_content->toArray()->array[index];
-        m_content->toArray()->array[index] = value.m_content->copy();
-        return true;
+        return false;
     }
 
-    return false;
+    delete array->array[index];
+    array->array[index] = takeContent(value);
+    return true;
 }
 
 /**
@@ -457,6 +922,17 @@ JsonItem::deleteContent()
         return false;
     }
 
+    // an arena-document can only be deleted completely by its root-item
+    if(m_arena != nullptr)
+    {
+        if(m_deletable == false) {
+            return false;
+        }
+
+        clear();
+        return true;
+    }
+
     delete m_content;
     m_content = nullptr;
 
@@ -475,13 +951,17 @@ JsonItem::getItemContent() const
 
 /**
  * @brief steal the content of the item to avoid copy the content, when the json-item is not longer
- *        necessary
+ *        necessary. The content of an arena-document is converted into normal items before.
  *
- * @return content of the json-item
+ * @return content of the json-item, or nullptr, if the item is only a part of an arena-document
  */
 DataItem*
 JsonItem::stealItemContent()
 {
+    if(detachArena() == false) {
+        return nullptr;
+    }
+
     DataItem* tempVar = m_content;
     m_content = nullptr;
     return tempVar;
@@ -501,6 +981,10 @@ JsonItem::operator[](const std::string key)
         return JsonItem();
     }
 
+    if(m_arena != nullptr) {
+        return JsonItem(m_arena, m_content->get(key));
+    }
+
     return JsonItem(m_content->get(key));
 }
 
@@ -518,6 +1002,10 @@ JsonItem::operator[](const uint32_t index)
         return JsonItem();
     }
 
+    if(m_arena != nullptr) {
+        return JsonItem(m_arena, m_content->get(index));
+    }
+
     return JsonItem(m_content->get(index));
 }
 
@@ -536,6 +1024,13 @@ JsonItem::get(const std::string key,
         return JsonItem();
     }
 
+    // a copy out of an arena-document consists of normal items
+    if(m_arena != nullptr
+            && copy == false)
+    {
+        return JsonItem(m_arena, m_content->get(key));
+    }
+
     return JsonItem(m_content->get(key), copy);
 }
 
@@ -554,6 +1049,13 @@ JsonItem::get(const uint32_t index,
         return JsonItem();
     }
 
+    // a copy out of an arena-document consists of normal items
+    if(m_arena != nullptr
+            && copy == false)
+    {
+        return JsonItem(m_arena, m_content->get(index));
+    }
+
     return JsonItem(m_content->get(index), copy);
 }
 
@@ -883,6 +1385,10 @@ JsonItem::isBool() const
 bool
 JsonItem::remove(const std::string &key)
 {
+    if(detachArena() == false) {
+        return false;
+    }
+
     if(m_content != nullptr) {
         return m_content->remove(key);
     }
@@ -900,6 +1406,10 @@ JsonItem::remove(const std::string &key)
 bool
 JsonItem::remove(const uint32_t index)
 {
+    if(detachArena() == false) {
+        return false;
+    }
+
     if(m_content != nullptr) {
         return m_content->remove(index);
     }
@@ -907,17 +1417,178 @@ JsonItem::remove(const uint32_t index)
 }
 
 /**
- * @brief prints the content of the object
+ * @brief prints the content of the object, where all strings are escaped
+ *
+ * @param indent true to add indents and line-breaks
  *
- * @param output pointer to the output-string on which the object-content as string will be appended
+ * @return json-formated string, which can be parsed again
  */
 const std::string
 JsonItem::toString(bool indent) const
 {
-    if(m_content != nullptr) {
-        return m_content->toString(indent);
+    std::string output = "";
+    JsonWriter writer;
+    writer.write(m_content, indent, output);
+
+    return output;
+}
+
+/**
+ * @brief append the content of the object in the same format like toString to an existing
+ *        string. The tree is written in one run into the string, so a string, which is reused
+ *        for multiple items, doesn't have to allocate new memory, as long as its capacity is
+ *        big enough.
+ *
+ * @param output string, where the result should be appended
+ * @param indent true to add indents and line-breaks
+ */
+void
+JsonItem::writeTo(std::string &output,
+                  const bool indent) const
+{
+    JsonWriter writer;
+    writer.write(m_content, indent, output);
+}
+
+/**
+ * @brief write the content of the object in the same format like toString into a
+ *        file-descriptor. The tree is converted and written in chunks of a fixed size, so even
+ *        for huge trees the output is never completely in the memory.
+ *
+ * @param fd file-descriptor, where the output should be written. It is not closed afterwards.
+ * @param error reference for error-message output
+ * @param indent true to add indents and line-breaks
+ *
+ * @return false, if writing failed, else true. In case of an error a part of the output can
+ *         be already written.
+ */
+bool
+JsonItem::writeTo(const int fd,
+                  ErrorContainer &error,
+                  const bool indent) const
+{
+    JsonWriter writer;
+    return writer.write(m_content, indent, fd, error);
+}
+
+/**
+ * @brief write the content of the object in the same format like toString into a stream in
+ *        chunks of a fixed size
+ *
+ * @param output stream, where the output should be written
+ * @param error reference for error-message output
+ * @param indent true to add indents and line-breaks
+ *
+ * @return false, if writing failed, else true. In case of an error a part of the output can
+ *         be already written.
+ */
+bool
+JsonItem::writeTo(std::ostream &output,
+                  ErrorContainer &error,
+                  const bool indent) const
+{
+    JsonWriter writer;
+    return writer.write(m_content, indent, output, error);
+}
+
+/**
+ * @brief convert the content of the object directly into the CBOR-format (RFC 8949) without any
+ *        intermediate json-string
+ *
+ * @return CBOR-data, which can be converted back with fromCbor
+ */
+const std::string
+JsonItem::toCbor() const
+{
+    std::string output = "";
+    JsonBinaryWriter::writeCbor(m_content, output);
+
+    return output;
+}
+
+/**
+ * @brief convert the content of the object directly into the MessagePack-format without any
+ *        intermediate json-string
+ *
+ * @return MessagePack-data, which can be converted back with fromMsgPack
+ */
+const std::string
+JsonItem::toMsgPack() const
+{
+    std::string output = "";
+    JsonBinaryWriter::writeMsgPack(m_content, output);
+
+    return output;
+}
+
+/**
+ * @brief convert the content of the object into its canonical json-form, which is the same for
+ *        all equal items, independent of the order of the keys in the original input. It has no
+ *        whitespace, sorted keys, normalized numbers like in RFC 8785 and a minimal escaping.
+ *        Integers and floating-point-values without fraction like 42 and 42.0 have the same
+ *        form. Unlike toString, a single string-value is written with quotes.
+ *
+ * @return canonical json-string, which can be parsed again
+ */
+const std::string
+JsonItem::toCanonicalString() const
+{
+    std::string output = "";
+    JsonCanonicalWriter::write(m_content, output);
+
+    return output;
+}
+
+/**
+ * @brief calculate a 64-bit hash of the content of the object, which is the same for all items
+ *        with the same canonical form. It is the first half of the result of hash128.
+ *
+ * @return 64-bit hash
+ */
+uint64_t
+JsonItem::hash() const
+{
+    uint64_t first = 0;
+    uint64_t second = 0;
+    JsonCanonicalWriter::hash(m_content, first, second);
+
+    return first;
+}
+
+/**
+ * @brief calculate the 128-bit MurmurHash3 of the canonical form of the content, while walking
+ *        through the tree, so the canonical string is never created. The result is exactly the
+ *        same like the hash of the output of toCanonicalString.
+ *
+ * @param first reference for the first 64 bits of the hash
+ * @param second reference for the second 64 bits of the hash
+ */
+void
+JsonItem::hash128(uint64_t &first,
+                  uint64_t &second) const
+{
+    JsonCanonicalWriter::hash(m_content, first, second);
+}
+
+/**
+ * @brief write the content of the object into a snapshot-file, which can be mapped into the
+ *        memory with JsonTapeDocument::loadSnapshot and read without any parsing
+ *
+ * @param filePath path of the snapshot-file
+ * @param error reference for error-message output
+ *
+ * @return false, if the item is empty or the file can not be written, else true
+ */
+bool
+JsonItem::saveSnapshot(const std::string &filePath,
+                       ErrorContainer &error) const
+{
+    JsonTapeDocument document;
+    if(document.fromItem(*this, error) == false) {
+        return false;
     }
-    return "";
+
+    return document.saveSnapshot(filePath, error);
 }
 
 /**
@@ -929,9 +1600,137 @@ JsonItem::clear()
     if(m_content != nullptr
             && m_deletable)
     {
-        delete m_content;
+        // all items of an arena-document are deleted at once together with the arena
+        if(m_arena != nullptr) {
+            delete m_arena;
+        } else {
+            delete m_content;
+        }
         m_content = nullptr;
     }
+
+    m_arena = nullptr;
+}
+
+/**
+ * @brief convert an arena-document into normal items, before it is changed, because the items
+ *        of the arena can not be deleted separately. All items, which point into the document,
+ *        become invalid.
+ *
+ * @return false, if the item is only a part of an arena-document, which can not be changed,
+ *         else true
+ */
+bool
+JsonItem::detachArena()
+{
+    if(m_arena == nullptr) {
+        return true;
+    }
+
+    if(m_deletable == false) {
+        return false;
+    }
+
+    DataItem* content = m_content->copy();
+    delete m_arena;
+    m_arena = nullptr;
+    m_content = content;
+
+    return true;
+}
+
+/**
+ * @brief take the content of an item, which should be added to this item. The content is only
+ *        copied, if the other item doesn't own it, because it points into another tree, or if
+ *        it is this item itself.
+ *
+ * @param value item, whose content should be taken
+ *
+ * @return content for this item
+ */
+DataItem*
+JsonItem::takeContent(JsonItem &value)
+{
+    if(value.m_deletable == false
+            || &value == this)
+    {
+        return value.m_content->copy();
+    }
+
+    // items of an arena-document are converted into normal items before
+    return value.stealItemContent();
+}
+
+/**
+ * @brief check if a key-value-pair can be inserted and convert the item into a map, if it is
+ *        empty. All checks are done before, so the value is never taken, when the insert fails.
+ *
+ * @param key key of the new pair
+ * @param value new json-item-object
+ * @param force true to overwrite an existing key
+ *
+ * @return map, where the pair should be inserted, or nullptr, if the insert is not possible
+ */
+DataMap*
+JsonItem::prepareInsert(const std::string &key,
+                        const JsonItem &value,
+                        const bool force)
+{
+    if(value.m_content == nullptr
+            || key == "")
+    {
+        return nullptr;
+    }
+
+    if(detachArena() == false) {
+        return nullptr;
+    }
+
+    if(m_content == nullptr) {
+        m_content = new DataMap();
+    }
+
+    if(m_content->getType() != DataItem::MAP_TYPE) {
+        return nullptr;
+    }
+
+    DataMap* map = m_content->toMap();
+    if(force == false
+            && map->map.find(key) != map->map.end())
+    {
+        return nullptr;
+    }
+
+    return map;
+}
+
+/**
+ * @brief check if an item can be added to this item and convert it into an array, if it is empty
+ *
+ * @param value new json-item-object
+ *
+ * @return array, where the item should be added, or nullptr, if it is not possible
+ */
+DataArray*
+JsonItem::prepareArray(const JsonItem &value)
+{
+    if(value.m_content == nullptr) {
+        return nullptr;
+    }
+
+    if(detachArena() == false) {
+        return nullptr;
+    }
+
+    if(m_content == nullptr) {
+        m_content = new DataArray();
+    }
+
+    if(m_content->getType() != DataItem::ARRAY_TYPE) {
+        return nullptr;
+    }
+
+    return m_content->toArray();
 }
 
 }  // namespace Kitsunemimi
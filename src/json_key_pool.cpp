@@ -0,0 +1,168 @@
+/**
+ *  @file    json_key_pool.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <libKitsunemimiJson/json_key_pool.h>
+
+#include <mutex>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief Table of interned keys, which can be shared by multiple parsers and threads. Each
+ *        different key is stored only once and all parsers, which use the pool, forward
+ *        the same string-object to the handler for equal keys. So a handler can compare keys
+ *        by pointer with the result of find or intern, instead of comparing the content.
+ *
+ * @param maxNumberOfKeys maximum number of keys within the pool. If the pool is full, new keys
+ *                        are not added anymore, so input with many different keys can not
+ *                        fill the memory.
+ */
+JsonKeyPool::JsonKeyPool(const uint64_t maxNumberOfKeys)
+    : m_maxNumberOfKeys(maxNumberOfKeys),
+      m_numberOfHits(0),
+      m_savedBytes(0) {}
+
+/**
+ * @brief destructor
+ */
+JsonKeyPool::~JsonKeyPool() {}
+
+/**
+ * @brief get the interned string for a key and add the key to the pool, if it doesn't
+ *        exist there
+ *
+ * @param key key to intern
+ *
+ * @return pointer to the interned string, which is valid until the pool is cleared or deleted,
+ *         or nullptr, if the key is not in the pool and the pool is already full
+ */
+const std::string*
+JsonKeyPool::intern(std::string_view key)
+{
+    // most keys already exist, so first try to find them with a shared lock, which doesn't
+    // block parsers in other threads
+    {
+        std::shared_lock<std::shared_mutex> guard(m_mutex);
+        const auto it = m_index.find(key);
+        if(it != m_index.end())
+        {
+            m_numberOfHits.fetch_add(1, std::memory_order_relaxed);
+            m_savedBytes.fetch_add(key.size(), std::memory_order_relaxed);
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> guard(m_mutex);
+
+    // check again, because another thread could have added the key in the meantime
+    const auto it = m_index.find(key);
+    if(it != m_index.end())
+    {
+        m_numberOfHits.fetch_add(1, std::memory_order_relaxed);
+        m_savedBytes.fetch_add(key.size(), std::memory_order_relaxed);
+        return it->second;
+    }
+
+    if(m_keys.size() >= m_maxNumberOfKeys) {
+        return nullptr;
+    }
+
+    m_keys.emplace_back(key);
+    const std::string* interned = &m_keys.back();
+    m_index.emplace(std::string_view(*interned), interned);
+
+    return interned;
+}
+
+/**
+ * @brief get the interned string for a key without adding it to the pool
+ *
+ * @param key key to search
+ *
+ * @return pointer to the interned string, or nullptr, if the key is not in the pool
+ */
+const std::string*
+JsonKeyPool::find(std::string_view key)
+{
+    std::shared_lock<std::shared_mutex> guard(m_mutex);
+
+    const auto it = m_index.find(key);
+    if(it == m_index.end()) {
+        return nullptr;
+    }
+
+    return it->second;
+}
+
+/**
+ * @brief remove all keys from the pool and reset the statistics. All pointers, which were
+ *        returned by the pool before, become invalid, so it must not be called while a parser
+ *        uses the pool.
+ */
+void
+JsonKeyPool::clear()
+{
+    std::unique_lock<std::shared_mutex> guard(m_mutex);
+
+    m_index.clear();
+    m_keys.clear();
+    m_numberOfHits = 0;
+    m_savedBytes = 0;
+}
+
+/**
+ * @brief get number of different keys within the pool
+ *
+ * @return number of keys
+ */
+uint64_t
+JsonKeyPool::getNumberOfKeys()
+{
+    std::shared_lock<std::shared_mutex> guard(m_mutex);
+    return m_keys.size();
+}
+
+/**
+ * @brief get number of requests, which were answered with an already existing key
+ *
+ * @return number of hits
+ */
+uint64_t
+JsonKeyPool::getNumberOfHits() const
+{
+    return m_numberOfHits.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief get number of bytes of all keys, which were found in the pool and so didn't have to be
+ *        stored again
+ *
+ * @return number of saved bytes
+ */
+uint64_t
+JsonKeyPool::getSavedBytes() const
+{
+    return m_savedBytes.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief add the statistics, which were collected by the local key-cache of a parser
+ *
+ * @param numberOfHits number of keys, which were found in the cache
+ * @param savedBytes number of bytes of these keys
+ */
+void
+JsonKeyPool::addStatistics(const uint64_t numberOfHits,
+                           const uint64_t savedBytes)
+{
+    m_numberOfHits.fetch_add(numberOfHits, std::memory_order_relaxed);
+    m_savedBytes.fetch_add(savedBytes, std::memory_order_relaxed);
+}
+
+}  // namespace Kitsunemimi
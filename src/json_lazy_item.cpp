@@ -0,0 +1,611 @@
+/**
+ *  @file    json_lazy_item.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <libKitsunemimiJson/json_lazy_item.h>
+
+#include <algorithm>
+#include <string.h>
+
+#include <libKitsunemimiJson/json_document.h>
+#include <json_parsing/json_scalar_types.h>
+#include <json_parsing/json_number_parser.h>
+#include <json_parsing/json_string_decoder.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief creates an invalid item
+ */
+JsonLazyItem::JsonLazyItem() {}
+
+/**
+ * @brief creates an item, which points to a value within a document
+ *
+ * @param document document, which contains the value
+ * @param index position of the value within the structural index of the document
+ */
+JsonLazyItem::JsonLazyItem(const JsonDocument* document,
+                           const uint64_t index)
+{
+    m_document = document;
+    m_index = index;
+}
+
+/**
+ * @brief get a specific entry of the item
+ *
+ * @param key key of the requested value
+ *
+ * @return invalid item, if the key doesn't exist or the item is no map, else the value
+ */
+JsonLazyItem
+JsonLazyItem::operator[](const std::string &key) const
+{
+    return get(key);
+}
+
+/**
+ * @brief get a specific entry of the item
+ *
+ * @param index index of the requested value
+ *
+ * @return invalid item, if the index is too high or the item is no array, else the value
+ */
+JsonLazyItem
+JsonLazyItem::operator[](const uint32_t index) const
+{
+    return get(index);
+}
+
+/**
+ * @brief get a specific entry of the item, where all values in front of the requested one are
+ *        skipped without reading them. In case of duplicate keys the first one is returned.
+ *
+ * @param key key of the requested value
+ *
+ * @return invalid item, if the key doesn't exist or the item is no map, else the value
+ */
+JsonLazyItem
+JsonLazyItem::get(const std::string &key) const
+{
+    if(isMap() == false) {
+        return JsonLazyItem();
+    }
+
+    const JsonDocument* doc = m_document;
+    uint64_t i = m_index + 1;
+    std::string keyBuffer;
+    while(doc->m_input[doc->m_positions[i]] != '}')
+    {
+        const char* entryKey = nullptr;
+        uint64_t keyLength = 0;
+        i = getKey(i, entryKey, keyLength, keyBuffer);
+
+        if(keyLength == key.size()
+                && memcmp(entryKey, key.c_str(), keyLength) == 0)
+        {
+            return JsonLazyItem(doc, i);
+        }
+
+        // skip value and comma
+        i = doc->skipValue(i);
+        if(doc->m_input[doc->m_positions[i]] == ',') {
+            i++;
+        }
+    }
+
+    return JsonLazyItem();
+}
+
+/**
+ * @brief get a specific entry of the item, where all values in front of the requested one are
+ *        skipped without reading them
+ *
+ * @param index index of the requested value
+ *
+ * @return invalid item, if the index is too high or the item is no array, else the value
+ */
+JsonLazyItem
+JsonLazyItem::get(const uint32_t index) const
+{
+    if(isArray() == false) {
+        return JsonLazyItem();
+    }
+
+    const JsonDocument* doc = m_document;
+    uint64_t i = m_index + 1;
+    for(uint32_t counter = 0; doc->m_input[doc->m_positions[i]] != ']'; counter++)
+    {
+        if(counter == index) {
+            return JsonLazyItem(doc, i);
+        }
+
+        // skip value and comma
+        i = doc->skipValue(i);
+        if(doc->m_input[doc->m_positions[i]] == ',') {
+            i++;
+        }
+    }
+
+    return JsonLazyItem();
+}
+
+/**
+ * @brief get string of the item
+ *
+ * @return string, of the item if string-type, else empty string
+ */
+const std::string
+JsonLazyItem::getString() const
+{
+    const char* scalar = nullptr;
+    uint64_t length = 0;
+    bool quoted = false;
+    if(getScalar(scalar, length, quoted) == false) {
+        return "";
+    }
+
+    if(quoted)
+    {
+        std::string result;
+        uint64_t errorPosition = 0;
+        std::string errorMessage;
+        decodeJsonString(scalar, length, result, false, errorPosition, errorMessage);
+        return result;
+    }
+
+    if(getJsonScalarType(scalar, length) == STRING_SCALAR) {
+        return std::string(scalar, length);
+    }
+
+    return "";
+}
+
+/**
+ * @brief get int-value of the item
+ *
+ * @return int-value, of the item if int-type, else 0
+ */
+int
+JsonLazyItem::getInt() const
+{
+    return static_cast<int>(getLong());
+}
+
+/**
+ * @brief get float-value of the item
+ *
+ * @return float-value, of the item if float-type, else 0
+ */
+float
+JsonLazyItem::getFloat() const
+{
+    return static_cast<float>(getDouble());
+}
+
+/**
+ * @brief get long-value of the item
+ *
+ * @return long-value, of the item if int-type, else 0
+ */
+long
+JsonLazyItem::getLong() const
+{
+    const char* scalar = nullptr;
+    uint64_t length = 0;
+    bool quoted = false;
+    if(getScalar(scalar, length, quoted) == false
+            || quoted
+            || getJsonScalarType(scalar, length) != LONG_SCALAR)
+    {
+        return 0;
+    }
+
+    long value = 0;
+    parseJsonInteger(scalar, length, value);
+
+    return value;
+}
+
+/**
+ * @brief get double-value of the item
+ *
+ * @return double-value, of the item if float-type, else 0
+ */
+double
+JsonLazyItem::getDouble() const
+{
+    const char* scalar = nullptr;
+    uint64_t length = 0;
+    bool quoted = false;
+    if(getScalar(scalar, length, quoted) == false
+            || quoted
+            || getJsonScalarType(scalar, length) != DOUBLE_SCALAR)
+    {
+        return 0.0;
+    }
+
+    double value = 0.0;
+    parseJsonDouble(scalar, length, value);
+
+    return value;
+}
+
+/**
+ * @brief get bool-value of the item
+ *
+ * @return bool-value, of the item if bool-type, else false
+ */
+bool
+JsonLazyItem::getBool() const
+{
+    return getScalarType() == TRUE_SCALAR;
+}
+
+/**
+ * @brief getter for the number of elements in the item
+ *
+ * @return number of elements in the item
+ */
+uint64_t
+JsonLazyItem::size() const
+{
+    if(isMap()) {
+        return getKeys().size();
+    }
+
+    if(isArray() == false) {
+        return 0;
+    }
+
+    const JsonDocument* doc = m_document;
+    uint64_t i = m_index + 1;
+    uint64_t counter = 0;
+    while(doc->m_input[doc->m_positions[i]] != ']')
+    {
+        counter++;
+        i = doc->skipValue(i);
+        if(doc->m_input[doc->m_positions[i]] == ',') {
+            i++;
+        }
+    }
+
+    return counter;
+}
+
+/**
+ * @brief get list of keys if the item is a map. The list is sorted and doesn't contain
+ *        duplicate keys like the list of the json-item.
+ *
+ * @return string-list with the keys of the map
+ */
+const std::vector<std::string>
+JsonLazyItem::getKeys() const
+{
+    std::vector<std::string> keys;
+    if(isMap() == false) {
+        return keys;
+    }
+
+    const JsonDocument* doc = m_document;
+    uint64_t i = m_index + 1;
+    std::string keyBuffer;
+    while(doc->m_input[doc->m_positions[i]] != '}')
+    {
+        const char* key = nullptr;
+        uint64_t keyLength = 0;
+        i = getKey(i, key, keyLength, keyBuffer);
+        keys.push_back(std::string(key, keyLength));
+
+        i = doc->skipValue(i);
+        if(doc->m_input[doc->m_positions[i]] == ',') {
+            i++;
+        }
+    }
+
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    return keys;
+}
+
+/**
+ * @brief check if a key is in the map
+ *
+ * @param key key-string which should be searched in the map
+ *
+ * @return false if the key doesn't exist or the item is no map, else true
+ */
+bool
+JsonLazyItem::contains(const std::string &key) const
+{
+    return get(key).m_document != nullptr;
+}
+
+/**
+ * @brief check if the current item is valid
+ *
+ * @return false, if the item doesn't exist or is a null-value, else true
+ */
+bool
+JsonLazyItem::isValid() const
+{
+    return isNull() == false;
+}
+
+/**
+ * @brief check if the current item is null
+ *
+ * @return true, if the item doesn't exist or is a null-value, else false
+ */
+bool
+JsonLazyItem::isNull() const
+{
+    if(m_document == nullptr) {
+        return true;
+    }
+
+    return getScalarType() == NULL_SCALAR;
+}
+
+/**
+ * @brief check if current item is a map
+ *
+ * @return true if current item is a json-object, else false
+ */
+bool
+JsonLazyItem::isMap() const
+{
+    return getFirstChar() == '{';
+}
+
+/**
+ * @brief check if current item is an array
+ *
+ * @return true if current item is a json-array, else false
+ */
+bool
+JsonLazyItem::isArray() const
+{
+    return getFirstChar() == '[';
+}
+
+/**
+ * @brief check if current item is a value
+ *
+ * @return true if current item is a json-value, else false
+ */
+bool
+JsonLazyItem::isValue() const
+{
+    const char* scalar = nullptr;
+    uint64_t length = 0;
+    bool quoted = false;
+
+    return getScalar(scalar, length, quoted)
+           && isNull() == false;
+}
+
+/**
+ * @brief check if current item is a string-value
+ *
+ * @return true if current item is a string-value, else false
+ */
+bool
+JsonLazyItem::isString() const
+{
+    return getFirstChar() == '"'
+           || getScalarType() == STRING_SCALAR;
+}
+
+/**
+ * @brief check if current item is a float-value
+ *
+ * @return true if current item is a float-value, else false
+ */
+bool
+JsonLazyItem::isFloat() const
+{
+    return getScalarType() == DOUBLE_SCALAR;
+}
+
+/**
+ * @brief check if current item is a int-value
+ *
+ * @return true if current item is a int-value, else false
+ */
+bool
+JsonLazyItem::isInteger() const
+{
+    return getScalarType() == LONG_SCALAR;
+}
+
+/**
+ * @brief check if current item is a bool-value
+ *
+ * @return true if current item is a bool-value, else false
+ */
+bool
+JsonLazyItem::isBool() const
+{
+    const uint32_t type = getScalarType();
+    return type == TRUE_SCALAR
+           || type == FALSE_SCALAR;
+}
+
+/**
+ * @brief convert the item with all of its content into a json-item
+ *
+ * @return json-item with a copy of the content, which is invalid for a null-value
+ */
+JsonItem
+JsonLazyItem::toJsonItem() const
+{
+    if(isNull()) {
+        return JsonItem();
+    }
+
+    // parse only the part of the input, which belongs to the map or array
+    if(isMap() || isArray())
+    {
+        const JsonDocument* doc = m_document;
+        const uint64_t start = doc->m_positions[m_index];
+        const uint64_t end = doc->m_positions[doc->m_closeIndex[m_index]] + 1;
+
+        JsonItem result;
+        ErrorContainer error;
+        result.parse(&doc->m_input[start], end - start, error, JsonItem::SIMD_PARSER);
+        return result;
+    }
+
+    switch(getScalarType())
+    {
+        case LONG_SCALAR:
+            return JsonItem(getLong());
+        case DOUBLE_SCALAR:
+            return JsonItem(getDouble());
+        case TRUE_SCALAR:
+        case FALSE_SCALAR:
+            return JsonItem(getBool());
+        default:
+            return JsonItem(getString());
+    }
+}
+
+/**
+ * @brief convert the content of the item into a string
+ *
+ * @param indent true to add indents and line-breaks
+ *
+ * @return item as json-formated string
+ */
+const std::string
+JsonLazyItem::toString(bool indent) const
+{
+    return toJsonItem().toString(indent);
+}
+
+/**
+ * @brief get the first character of the value
+ *
+ * @return first character or 0, if the item is invalid
+ */
+char
+JsonLazyItem::getFirstChar() const
+{
+    if(m_document == nullptr) {
+        return '\0';
+    }
+
+    return m_document->m_input[m_document->m_positions[m_index]];
+}
+
+/**
+ * @brief get the content of a value, which is no map or array
+ *
+ * @param scalar reference for the start of the content
+ * @param length reference for the length of the content
+ * @param quoted reference for the information, if the value was a string with quotes
+ *
+ * @return false, if the item is invalid or a map or array, else true
+ */
+bool
+JsonLazyItem::getScalar(const char* &scalar,
+                        uint64_t &length,
+                        bool &quoted) const
+{
+    const char firstChar = getFirstChar();
+    if(firstChar == '\0'
+            || firstChar == '{'
+            || firstChar == '[')
+    {
+        return false;
+    }
+
+    const JsonDocument* doc = m_document;
+    const uint64_t start = doc->m_positions[m_index];
+
+    if(firstChar == '"')
+    {
+        scalar = &doc->m_input[start + 1];
+        length = doc->m_positions[m_index + 1] - start - 1;
+        quoted = true;
+        return true;
+    }
+
+    scalar = &doc->m_input[start];
+    length = getJsonScalarLength(scalar, doc->m_inputSize - start);
+    quoted = false;
+
+    return true;
+}
+
+/**
+ * @brief read the key of a key-value-pair of a map
+ *
+ * @param index position of the key within the structural index
+ * @param key reference for the start of the key
+ * @param keyLength reference for the length of the key
+ * @param keyBuffer buffer for the decoded key, if the key contains escape-sequences
+ *
+ * @return position of the value behind the key within the structural index
+ */
+uint64_t
+JsonLazyItem::getKey(const uint64_t index,
+                     const char* &key,
+                     uint64_t &keyLength,
+                     std::string &keyBuffer) const
+{
+    JsonLazyItem keyItem(m_document, index);
+    bool quoted = false;
+    keyItem.getScalar(key, keyLength, quoted);
+
+    // keys with escape-sequences have to be decoded for the compare
+    if(quoted
+            && memchr(key, '\\', keyLength) != nullptr)
+    {
+        uint64_t errorPosition = 0;
+        std::string errorMessage;
+        decodeJsonString(key, keyLength, keyBuffer, false, errorPosition, errorMessage);
+        key = keyBuffer.c_str();
+        keyLength = keyBuffer.size();
+    }
+
+    // skip key and colon
+    if(quoted) {
+        return index + 3;
+    }
+
+    return index + 2;
+}
+
+/**
+ * @brief get the type of a value, which is no map or array
+ *
+ * @return type of the value as jsonScalarTypes or UINT32_MAX, if the item is invalid or a map
+ *         or array
+ */
+uint32_t
+JsonLazyItem::getScalarType() const
+{
+    const char* scalar = nullptr;
+    uint64_t length = 0;
+    bool quoted = false;
+    if(getScalar(scalar, length, quoted) == false) {
+        return UINT32_MAX;
+    }
+
+    if(quoted) {
+        return STRING_SCALAR;
+    }
+
+    return getJsonScalarType(scalar, length);
+}
+
+}  // namespace Kitsunemimi
@@ -0,0 +1,377 @@
+/**
+ *  @file    json_lines_parser.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <libKitsunemimiJson/json_lines_parser.h>
+
+#include <string.h>
+
+#include <json_parsing/json_file_mapping.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief The class parses newline-delimited json-records (NDJSON / JSON Lines). The input is
+ *        split into batches of records, which are parsed in parallel by a persistent pool of
+ *        worker-threads, while the results are delivered in the order of the input.
+ *
+ * @param numberOfThreads number of worker-threads (0 = number of available cpu-cores)
+ * @param parserType parser-engine, which is used for each record
+ */
+JsonLinesParser::JsonLinesParser(const uint32_t numberOfThreads,
+                                 const JsonItem::parserTypes parserType)
+{
+    m_parserType = parserType;
+
+    uint32_t threads = numberOfThreads;
+    if(threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    if(threads == 0) {
+        threads = 1;
+    }
+
+    for(uint32_t i = 0; i < threads; i++) {
+        m_workers.emplace_back(&JsonLinesParser::run, this);
+    }
+}
+
+/**
+ * @brief destructor, which stops and joins all worker-threads
+ */
+JsonLinesParser::~JsonLinesParser()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_stop = true;
+    }
+    m_queueCondition.notify_all();
+
+    for(uint64_t i = 0; i < m_workers.size(); i++) {
+        m_workers[i].join();
+    }
+}
+
+/**
+ * @brief parse all records of the input and store the results in the order of the input
+ *
+ * @param input newline-delimited records. They are never copied as a whole, so they must be
+ *              valid until the end of the parsing. Only the bison-parser copies each record in
+ *              small parts into the buffer of its scanner.
+ * @param results reference for the resulting records. Empty lines are skipped and don't
+ *                create an entry.
+ *
+ * @return true, if all records were valid, else false
+ */
+bool
+JsonLinesParser::parse(std::string_view input,
+                       std::vector<Record> &results)
+{
+    results.clear();
+
+    // split the whole input at first, so all results can be written directly into the vector
+    std::vector<Batch> batches;
+    LineSplitter splitter;
+    splitter.input = input;
+    uint64_t numberOfRecords = 0;
+    while(true)
+    {
+        batches.emplace_back();
+        if(fillBatch(splitter, batches.back()) == false)
+        {
+            batches.pop_back();
+            break;
+        }
+        numberOfRecords += batches.back().lines.size();
+    }
+
+    results.resize(numberOfRecords);
+
+    uint64_t recordPos = 0;
+    for(uint64_t i = 0; i < batches.size(); i++)
+    {
+        batches[i].records = &results[recordPos];
+        recordPos += batches[i].lines.size();
+        addBatch(&batches[i]);
+    }
+
+    // wait until all records are parsed
+    for(uint64_t i = 0; i < batches.size(); i++) {
+        waitForBatch(&batches[i]);
+    }
+
+    bool success = true;
+    for(uint64_t i = 0; i < results.size(); i++) {
+        success = success && results[i].success;
+    }
+
+    return success;
+}
+
+/**
+ * @brief parse all records of the input and forward the results in the order of the input to
+ *        a callback. Only a limited window of batches is processed at the same time, so the
+ *        memory-consumption doesn't depend on the size of the input.
+ *
+ * @param input newline-delimited records. They are never copied as a whole, so they must be
+ *              valid until the end of the parsing. Only the bison-parser copies each record in
+ *              small parts into the buffer of its scanner.
+ * @param callback function, which is called in the calling thread for each record. If it
+ *                 returns false, the parsing is stopped.
+ *
+ * @return true, if all records were valid and the callback has not stopped the parsing,
+ *         else false
+ */
+bool
+JsonLinesParser::parse(std::string_view input,
+                       const std::function<bool(Record &record)> &callback)
+{
+    // the deque is only changed at its ends, so the references to the other batches, which
+    // are hold by the worker-threads, stay valid
+    std::deque<Batch> window;
+    const uint64_t windowSize = 2 * m_workers.size();
+
+    LineSplitter splitter;
+    splitter.input = input;
+    bool inputDone = false;
+    bool success = true;
+    bool stopped = false;
+
+    while(true)
+    {
+        // refill window with new batches
+        while(inputDone == false
+              && stopped == false
+              && window.size() < windowSize)
+        {
+            window.emplace_back();
+            Batch* batch = &window.back();
+            if(fillBatch(splitter, *batch) == false)
+            {
+                window.pop_back();
+                inputDone = true;
+                break;
+            }
+
+            batch->ownRecords.resize(batch->lines.size());
+            batch->records = &batch->ownRecords[0];
+            addBatch(batch);
+        }
+
+        if(window.size() == 0) {
+            break;
+        }
+
+        // deliver the oldest batch
+        Batch* batch = &window.front();
+        waitForBatch(batch);
+        for(uint64_t i = 0; i < batch->lines.size() && stopped == false; i++)
+        {
+            success = success && batch->records[i].success;
+            if(callback(batch->records[i]) == false)
+            {
+                success = false;
+                stopped = true;
+            }
+        }
+        window.pop_front();
+    }
+
+    return success;
+}
+
+/**
+ * @brief parse all records of a file and forward the results in the order of the file to a
+ *        callback. The file is mapped read-only into the memory and not copied.
+ *
+ * @param filePath path to the file with the newline-delimited records
+ * @param callback function, which is called in the calling thread for each record. If it
+ *                 returns false, the parsing is stopped.
+ * @param error reference for error-output, if the file can not be read
+ *
+ * @return true, if all records were valid and the callback has not stopped the parsing,
+ *         else false
+ */
+bool
+JsonLinesParser::parseFile(const std::string &filePath,
+                           const std::function<bool(Record &record)> &callback,
+                           ErrorContainer &error)
+{
+    JsonFileMapping file;
+    if(file.open(filePath, error) == false) {
+        return false;
+    }
+
+    return parse(std::string_view(file.getData(), file.getSize()), callback);
+}
+
+/**
+ * @brief get number of worker-threads
+ *
+ * @return number of worker-threads
+ */
+uint32_t
+JsonLinesParser::getNumberOfThreads() const
+{
+    return static_cast<uint32_t>(m_workers.size());
+}
+
+/**
+ * @brief get the next non-empty line of the input
+ *
+ * @param line reference for the line without line-break
+ * @param lineNumber reference for the number of the line, starting with 1
+ *
+ * @return false, if the end of the input was reached, else true
+ */
+bool
+JsonLinesParser::LineSplitter::nextLine(std::string_view &line,
+                                        uint64_t &lineNumber)
+{
+    while(position < input.size())
+    {
+        const char* start = &input[position];
+        const uint64_t remaining = input.size() - position;
+        const char* end = static_cast<const char*>(memchr(start, '\n', remaining));
+        uint64_t length = remaining;
+        if(end != nullptr) {
+            length = static_cast<uint64_t>(end - start);
+        }
+
+        position += length + 1;
+        this->lineNumber++;
+
+        // remove line-break of windows
+        if(length > 0
+                && start[length - 1] == '\r')
+        {
+            length--;
+        }
+
+        // skip lines, which contain only whitespaces
+        bool empty = true;
+        for(uint64_t i = 0; i < length && empty; i++) {
+            empty = start[i] == ' ' || start[i] == '\t';
+        }
+        if(empty) {
+            continue;
+        }
+
+        line = std::string_view(start, length);
+        lineNumber = this->lineNumber;
+
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief fill a batch with the next lines of the input
+ *
+ * @param splitter splitter with the current position in the input
+ * @param batch batch to fill
+ *
+ * @return false, if there were no more lines in the input, else true
+ */
+bool
+JsonLinesParser::fillBatch(LineSplitter &splitter,
+                           Batch &batch)
+{
+    uint64_t numberOfBytes = 0;
+    std::string_view line;
+    uint64_t lineNumber = 0;
+
+    while(batch.lines.size() < m_maxBatchRecords
+          && numberOfBytes < m_maxBatchBytes
+          && splitter.nextLine(line, lineNumber))
+    {
+        batch.lines.push_back(line);
+        batch.lineNumbers.push_back(lineNumber);
+        numberOfBytes += line.size();
+    }
+
+    return batch.lines.size() > 0;
+}
+
+/**
+ * @brief add batch to the queue of the worker-threads
+ *
+ * @param batch batch to process
+ */
+void
+JsonLinesParser::addBatch(Batch* batch)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_queue.push_back(batch);
+    }
+    m_queueCondition.notify_one();
+}
+
+/**
+ * @brief block until a batch was processed by a worker-thread
+ *
+ * @param batch batch to wait for
+ */
+void
+JsonLinesParser::waitForBatch(Batch* batch)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [batch] { return batch->done; });
+}
+
+/**
+ * @brief parse all records of a batch
+ *
+ * @param batch batch to process
+ */
+void
+JsonLinesParser::processBatch(Batch* batch)
+{
+    for(uint64_t i = 0; i < batch->lines.size(); i++)
+    {
+        Record* record = &batch->records[i];
+        record->lineNumber = batch->lineNumbers[i];
+        record->success = record->item.parse(batch->lines[i], record->error, m_parserType);
+    }
+}
+
+/**
+ * @brief loop of the worker-threads
+ */
+void
+JsonLinesParser::run()
+{
+    while(true)
+    {
+        Batch* batch = nullptr;
+
+        // get next batch from the queue
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_queueCondition.wait(lock, [this] { return m_stop || m_queue.size() > 0; });
+            if(m_queue.size() == 0) {
+                return;
+            }
+
+            batch = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        processBatch(batch);
+
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            batch->done = true;
+        }
+        m_doneCondition.notify_all();
+    }
+}
+
+}  // namespace Kitsunemimi
@@ -0,0 +1,226 @@
+/**
+ *  @file    json_arena.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <json_parsing/json_arena.h>
+
+#include <string.h>
+#include <new>
+
+#include <libKitsunemimiCommon/items/data_items.h>
+
+namespace Kitsunemimi
+{
+
+// size of the first block and upper limit for the growing block-size
+static const uint64_t minBlockSize = 64 * 1024;
+static const uint64_t maxBlockSize = 4 * 1024 * 1024;
+
+/**
+ * @brief string-value, which points to a string within the arena. It only exist to set the
+ *        value-type without the allocation of the constructor of the data-value. Copies of it
+ *        are normal data-values with an own string.
+ */
+class ArenaStringValue
+        : public DataValue
+{
+public:
+    ArenaStringValue(char* value)
+        : DataValue(0L)
+    {
+        m_valueType = STRING_TYPE;
+        content.stringValue = value;
+    }
+};
+
+/**
+ * @brief Bump-allocator for all items of one parsed tree. The items are created one after
+ *        another in big memory-blocks and the destructors of the items are never called. So the
+ *        whole tree is deleted at once by releasing the blocks. Only the containers of maps and
+ *        arrays have own memory, which is freed in the release too.
+ */
+JsonArena::JsonArena()
+{
+    m_nextBlockSize = minBlockSize;
+}
+
+/**
+ * @brief destructor, which releases all items
+ */
+JsonArena::~JsonArena()
+{
+    release();
+}
+
+/**
+ * @brief create a new empty map within the arena
+ *
+ * @return pointer to the new map
+ */
+DataMap*
+JsonArena::createMap()
+{
+    DataMap* map = new(allocate(sizeof(DataMap), alignof(DataMap))) DataMap();
+    m_containers.push_back(map);
+    return map;
+}
+
+/**
+ * @brief create a new empty array within the arena
+ *
+ * @return pointer to the new array
+ */
+DataArray*
+JsonArena::createArray()
+{
+    DataArray* array = new(allocate(sizeof(DataArray), alignof(DataArray))) DataArray();
+    m_containers.push_back(array);
+    return array;
+}
+
+/**
+ * @brief create a new string-value, where also the string is stored within the arena
+ *
+ * @param value string to store
+ *
+ * @return pointer to the new value
+ */
+DataValue*
+JsonArena::createValue(const std::string &value)
+{
+    char* text = static_cast<char*>(allocate(value.size() + 1, 1));
+    memcpy(text, value.c_str(), value.size() + 1);
+
+    void* buffer = allocate(sizeof(ArenaStringValue), alignof(ArenaStringValue));
+    return new(buffer) ArenaStringValue(text);
+}
+
+/**
+ * @brief create a new integer-value within the arena
+ *
+ * @param value integer to store
+ *
+ * @return pointer to the new value
+ */
+DataValue*
+JsonArena::createValue(const long value)
+{
+    return new(allocate(sizeof(DataValue), alignof(DataValue))) DataValue(value);
+}
+
+/**
+ * @brief create a new floating-point-value within the arena
+ *
+ * @param value floating-point-value to store
+ *
+ * @return pointer to the new value
+ */
+DataValue*
+JsonArena::createValue(const double value)
+{
+    return new(allocate(sizeof(DataValue), alignof(DataValue))) DataValue(value);
+}
+
+/**
+ * @brief create a new bool-value within the arena
+ *
+ * @param value bool-value to store
+ *
+ * @return pointer to the new value
+ */
+DataValue*
+JsonArena::createValue(const bool value)
+{
+    return new(allocate(sizeof(DataValue), alignof(DataValue))) DataValue(value);
+}
+
+/**
+ * @brief delete all items of the arena at once. The maps and arrays are only cleared without
+ *        deleting their children, because the children are also part of the arena.
+ */
+void
+JsonArena::release()
+{
+    for(DataItem* item : m_containers)
+    {
+        if(item->isMap()) {
+            item->toMap()->map.clear();
+        } else {
+            std::vector<DataItem*>().swap(item->toArray()->array);
+        }
+    }
+    m_containers.clear();
+
+    for(char* block : m_blocks) {
+        delete[] block;
+    }
+    m_blocks.clear();
+
+    m_current = nullptr;
+    m_remaining = 0;
+    m_nextBlockSize = minBlockSize;
+    m_usedBytes = 0;
+}
+
+/**
+ * @brief get number of bytes, which are used by items and strings within the arena
+ *
+ * @return number of used bytes
+ */
+uint64_t
+JsonArena::getUsedBytes() const
+{
+    return m_usedBytes;
+}
+
+/**
+ * @brief get memory from the current block or create a new block, if the current is full
+ *
+ * @param size number of requested bytes
+ * @param alignment requested alignment, which has to be a power of two
+ *
+ * @return pointer to the memory
+ */
+void*
+JsonArena::allocate(const uint64_t size,
+                    const uint64_t alignment)
+{
+    uint64_t padding = (alignment - (reinterpret_cast<uintptr_t>(m_current) & (alignment - 1)))
+                       & (alignment - 1);
+
+    if(m_current == nullptr
+            || padding + size > m_remaining)
+    {
+        // big strings get an own block, so the rest of the current block is not wasted
+        if(size > m_nextBlockSize / 4)
+        {
+            char* block = new char[size];
+            m_blocks.push_back(block);
+            m_usedBytes += size;
+            return block;
+        }
+
+        char* block = new char[m_nextBlockSize];
+        m_blocks.push_back(block);
+        m_current = block;
+        m_remaining = m_nextBlockSize;
+        padding = 0;
+
+        if(m_nextBlockSize < maxBlockSize) {
+            m_nextBlockSize *= 2;
+        }
+    }
+
+    void* result = m_current + padding;
+    m_current += padding + size;
+    m_remaining -= padding + size;
+    m_usedBytes += size;
+
+    return result;
+}
+
+}  // namespace Kitsunemimi
@@ -0,0 +1,54 @@
+/**
+ *  @file    json_arena.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_ARENA_H
+#define JSON_ARENA_H
+
+#include <string>
+#include <vector>
+
+namespace Kitsunemimi
+{
+class DataItem;
+class DataMap;
+class DataArray;
+class DataValue;
+
+class JsonArena
+{
+public:
+    JsonArena();
+    ~JsonArena();
+
+    DataMap* createMap();
+    DataArray* createArray();
+    DataValue* createValue(const std::string &value);
+    DataValue* createValue(const long value);
+    DataValue* createValue(const double value);
+    DataValue* createValue(const bool value);
+
+    void release();
+    uint64_t getUsedBytes() const;
+
+private:
+    std::vector<char*> m_blocks;
+    char* m_current = nullptr;
+    uint64_t m_remaining = 0;
+    uint64_t m_nextBlockSize = 0;
+    uint64_t m_usedBytes = 0;
+
+    // all maps and arrays, because their containers have own memory, which is not in the arena
+    std::vector<DataItem*> m_containers;
+
+    void* allocate(const uint64_t size,
+                   const uint64_t alignment);
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_ARENA_H
@@ -0,0 +1,661 @@
+/**
+ *  @file    json_binary_parser.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <json_parsing/json_binary_parser.h>
+
+#include <string.h>
+#include <climits>
+#include <cmath>
+
+#include <libKitsunemimiJson/json_handler.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief convert a floating-point-value with half precision into a double
+ *
+ * @param half bits of the value
+ *
+ * @return converted value
+ */
+static double
+decodeHalf(const uint16_t half)
+{
+    const int exponent = (half >> 10) & 0x1f;
+    const int mantissa = half & 0x3ff;
+
+    double value = 0.0;
+    if(exponent == 0) {
+        value = std::ldexp(mantissa, -24);
+    } else if(exponent != 31) {
+        value = std::ldexp(mantissa + 1024, exponent - 25);
+    } else {
+        value = mantissa == 0 ? INFINITY : NAN;
+    }
+
+    return (half & 0x8000) ? -value : value;
+}
+
+/**
+ * @brief The class converts CBOR- (RFC 8949) or MessagePack-data into the same events like the
+ *        json-parsers, so the binary data can be converted with the same handlers into a tree
+ *        or another structure without any intermediate json-string. Only the types, which
+ *        exist in json, are supported. So keys of maps must be strings and byte-strings are
+ *        handled like normal strings.
+ */
+JsonBinaryParser::JsonBinaryParser() {}
+
+/**
+ * @brief destructor
+ */
+JsonBinaryParser::~JsonBinaryParser() {}
+
+/**
+ * @brief parse binary data
+ *
+ * @param input pointer to the data, which should be parsed. It is read in place and not copied.
+ * @param inputSize number of bytes of the data
+ * @param format format of the data
+ * @param handler handler, which receives all events of the parser
+ * @param error reference for error-message output
+ *
+ * @return false, if the input is invalid or the handler has aborted, else true
+ */
+bool
+JsonBinaryParser::parse(const uint8_t* input,
+                        const uint64_t inputSize,
+                        const binaryFormats format,
+                        JsonHandler &handler,
+                        ErrorContainer &error)
+{
+    // init global values
+    m_input = input;
+    m_inputSize = inputSize;
+    m_position = 0;
+    m_format = format;
+    m_handler = &handler;
+    m_stack.clear();
+    m_errorMessage = "";
+
+    // forward the content to the handler
+    bool success = parseContent();
+
+    // there must be nothing behind the first item
+    if(success
+            && m_position != m_inputSize)
+    {
+        success = setError("unexpected data behind the end of the first item");
+    }
+
+    m_handler = nullptr;
+    m_stack.clear();
+
+    // handle negative result
+    if(success == false)
+    {
+        error.addMeesage(m_errorMessage);
+        LOG_ERROR(error);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief read items until the first item of the input and all of its children are complete
+ *
+ * @return false, if the input is invalid or the handler has aborted, else true
+ */
+bool
+JsonBinaryParser::parseContent()
+{
+    while(true)
+    {
+        if(m_stack.size() > 0)
+        {
+            StackEntry &entry = m_stack.back();
+
+            // check if the current map or array is complete
+            bool isComplete = entry.remaining == 0;
+            if(entry.indefinite)
+            {
+                if(m_position >= m_inputSize) {
+                    return setError("unexpected end of the input");
+                }
+
+                isComplete = m_input[m_position] == 0xff;
+                if(isComplete) {
+                    m_position++;
+                }
+            }
+
+            if(isComplete)
+            {
+                const bool isMap = entry.isMap;
+                m_stack.pop_back();
+                const bool result = isMap ? m_handler->endObject() : m_handler->endArray();
+                if(finishValue(result) == false) {
+                    return false;
+                }
+
+                if(m_stack.size() == 0) {
+                    return true;
+                }
+                continue;
+            }
+
+            // entries of maps start with their key
+            if(entry.expectKey)
+            {
+                entry.expectKey = false;
+                const bool result = m_format == CBOR_FORMAT ? parseCborItem(true)
+                                                            : parseMsgPackItem(true);
+                if(result == false) {
+                    return false;
+                }
+            }
+        }
+
+        const bool result = m_format == CBOR_FORMAT ? parseCborItem(false)
+                                                    : parseMsgPackItem(false);
+        if(result == false) {
+            return false;
+        }
+
+        // the first item was a single value or the first item was complete
+        if(m_stack.size() == 0) {
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief parse the next CBOR-item. Maps and arrays are only opened and their entries are
+ *        parsed by the following calls.
+ *
+ * @param isKey true, if the item is the key of a map-entry
+ *
+ * @return false, if the input is invalid or the handler has aborted, else true
+ */
+bool
+JsonBinaryParser::parseCborItem(const bool isKey)
+{
+    uint8_t majorType = 0;
+    uint8_t info = 0;
+    uint64_t argument = 0;
+
+    // tags only add a meaning to the following item, which is not relevant for json
+    do
+    {
+        if(m_position >= m_inputSize) {
+            return setError("unexpected end of the input");
+        }
+
+        majorType = m_input[m_position] >> 5;
+        info = m_input[m_position] & 0x1f;
+        if(isKey
+                && majorType != 2
+                && majorType != 3
+                && majorType != 6)
+        {
+            return setError("key of a map is not a string");
+        }
+        if(info == 31
+                && (majorType < 2 || majorType == 6))
+        {
+            return setError("integers and tags can not have an indefinite length");
+        }
+        m_position++;
+
+        // read the argument of all items, which don't have an indefinite length
+        if(majorType != 7
+                && info != 31)
+        {
+            if(readCborArgument(info, argument) == false) {
+                return false;
+            }
+        }
+    }
+    while(majorType == 6);
+
+    switch(majorType)
+    {
+        case 0:
+        {
+            if(argument > LONG_MAX) {
+                return setError("integer is too big");
+            }
+            return finishValue(m_handler->integerValue(static_cast<long>(argument)));
+        }
+        case 1:
+        {
+            if(argument > LONG_MAX) {
+                return setError("integer is too small");
+            }
+            return finishValue(m_handler->integerValue(-1 - static_cast<long>(argument)));
+        }
+        case 2:
+        case 3:
+        {
+            m_stringBuffer.clear();
+            if(info != 31) {
+                return readString(argument) && forwardString(isKey);
+            }
+
+            // indefinite strings consist of chunks with definite length until a break-byte
+            while(true)
+            {
+                if(m_position >= m_inputSize) {
+                    return setError("unexpected end of the input");
+                }
+                if(m_input[m_position] == 0xff)
+                {
+                    m_position++;
+                    return forwardString(isKey);
+                }
+                if(m_input[m_position] >> 5 != majorType
+                        || (m_input[m_position] & 0x1f) == 31)
+                {
+                    return setError("invalid chunk of an indefinite string");
+                }
+
+                const uint8_t chunkInfo = m_input[m_position] & 0x1f;
+                m_position++;
+                if(readCborArgument(chunkInfo, argument) == false
+                        || readString(argument) == false)
+                {
+                    return false;
+                }
+            }
+        }
+        case 4:
+        case 5:
+        {
+            return startContainer(argument, majorType == 5, info == 31);
+        }
+        default:
+            break;
+    }
+
+    // major-type 7 contains the simple values and the floating-point-values
+    uint64_t bits = 0;
+    switch(info)
+    {
+        case 20:
+            return finishValue(m_handler->boolValue(false));
+        case 21:
+            return finishValue(m_handler->boolValue(true));
+        case 22:
+        case 23:
+            return finishValue(m_handler->nullValue());
+        case 25:
+        {
+            if(readBigEndian(2, bits) == false) {
+                return false;
+            }
+            return forwardDouble(decodeHalf(static_cast<uint16_t>(bits)));
+        }
+        case 26:
+        {
+            if(readBigEndian(4, bits) == false) {
+                return false;
+            }
+            const uint32_t floatBits = static_cast<uint32_t>(bits);
+            float value = 0.0f;
+            memcpy(&value, &floatBits, 4);
+            return forwardDouble(static_cast<double>(value));
+        }
+        case 27:
+        {
+            if(readBigEndian(8, bits) == false) {
+                return false;
+            }
+            double value = 0.0;
+            memcpy(&value, &bits, 8);
+            return forwardDouble(value);
+        }
+        case 31:
+            m_position--;
+            return setError("break outside of an indefinite map, array or string");
+        default:
+            m_position--;
+            return setError("unsupported simple value");
+    }
+}
+
+/**
+ * @brief parse the next MessagePack-item. Maps and arrays are only opened and their entries
+ *        are parsed by the following calls.
+ *
+ * @param isKey true, if the item is the key of a map-entry
+ *
+ * @return false, if the input is invalid or the handler has aborted, else true
+ */
+bool
+JsonBinaryParser::parseMsgPackItem(const bool isKey)
+{
+    if(m_position >= m_inputSize) {
+        return setError("unexpected end of the input");
+    }
+
+    const uint8_t type = m_input[m_position];
+    const bool isString = (type >= 0xa0 && type <= 0xbf)
+                          || (type >= 0xc4 && type <= 0xc6)
+                          || (type >= 0xd9 && type <= 0xdb);
+    if(isKey
+            && isString == false)
+    {
+        return setError("key of a map is not a string");
+    }
+    m_position++;
+
+    // types, which store their value or length within the type-byte
+    if(type <= 0x7f) {
+        return finishValue(m_handler->integerValue(type));
+    }
+    if(type >= 0xe0) {
+        return finishValue(m_handler->integerValue(static_cast<int8_t>(type)));
+    }
+    if(type <= 0x8f) {
+        return startContainer(type & 0x0f, true, false);
+    }
+    if(type <= 0x9f) {
+        return startContainer(type & 0x0f, false, false);
+    }
+    if(type <= 0xbf)
+    {
+        m_stringBuffer.clear();
+        return readString(type & 0x1f) && forwardString(isKey);
+    }
+
+    uint64_t value = 0;
+    switch(type)
+    {
+        case 0xc0:
+            return finishValue(m_handler->nullValue());
+        case 0xc2:
+            return finishValue(m_handler->boolValue(false));
+        case 0xc3:
+            return finishValue(m_handler->boolValue(true));
+        case 0xc4:
+        case 0xc5:
+        case 0xc6:
+        case 0xd9:
+        case 0xda:
+        case 0xdb:
+        {
+            // byte-strings are handled like normal strings
+            const uint8_t sizeType = type >= 0xd9 ? type - 0xd9 : type - 0xc4;
+            m_stringBuffer.clear();
+            return readBigEndian(1u << sizeType, value)
+                   && readString(value)
+                   && forwardString(isKey);
+        }
+        case 0xca:
+        {
+            if(readBigEndian(4, value) == false) {
+                return false;
+            }
+            const uint32_t floatBits = static_cast<uint32_t>(value);
+            float floatValue = 0.0f;
+            memcpy(&floatValue, &floatBits, 4);
+            return forwardDouble(static_cast<double>(floatValue));
+        }
+        case 0xcb:
+        {
+            if(readBigEndian(8, value) == false) {
+                return false;
+            }
+            double doubleValue = 0.0;
+            memcpy(&doubleValue, &value, 8);
+            return forwardDouble(doubleValue);
+        }
+        case 0xcc:
+        case 0xcd:
+        case 0xce:
+        case 0xcf:
+        {
+            if(readBigEndian(1u << (type - 0xcc), value) == false) {
+                return false;
+            }
+            if(value > LONG_MAX) {
+                return setError("integer is too big");
+            }
+            return finishValue(m_handler->integerValue(static_cast<long>(value)));
+        }
+        case 0xd0:
+        case 0xd1:
+        case 0xd2:
+        case 0xd3:
+        {
+            const uint32_t numberOfBytes = 1u << (type - 0xd0);
+            if(readBigEndian(numberOfBytes, value) == false) {
+                return false;
+            }
+
+            // extend the sign of the smaller types
+            const uint32_t shift = 64 - 8 * numberOfBytes;
+            const long intValue = static_cast<long>(value << shift) >> shift;
+            return finishValue(m_handler->integerValue(intValue));
+        }
+        case 0xdc:
+        case 0xdd:
+        case 0xde:
+        case 0xdf:
+        {
+            const uint32_t numberOfBytes = (type & 0x01) ? 4 : 2;
+            if(readBigEndian(numberOfBytes, value) == false) {
+                return false;
+            }
+            return startContainer(value, type >= 0xde, false);
+        }
+        case 0xc7:
+        case 0xc8:
+        case 0xc9:
+        case 0xd4:
+        case 0xd5:
+        case 0xd6:
+        case 0xd7:
+        case 0xd8:
+            m_position--;
+            return setError("extension-types are not supported");
+        default:
+            m_position--;
+            return setError("invalid type-byte");
+    }
+}
+
+/**
+ * @brief forward the start of a map or array to the handler and add it to the stack
+ *
+ * @param numberOfEntries number of entries of the map or array
+ * @param isMap true for a map, false for an array
+ * @param indefinite true, if the container is closed by a break-byte instead of a length
+ *
+ * @return false, if the handler has aborted, else true
+ */
+bool
+JsonBinaryParser::startContainer(const uint64_t numberOfEntries,
+                                 const bool isMap,
+                                 const bool indefinite)
+{
+    const bool result = isMap ? m_handler->startObject() : m_handler->startArray();
+    if(result == false) {
+        return setError("parsing was aborted by the handler");
+    }
+
+    StackEntry entry;
+    entry.remaining = numberOfEntries;
+    entry.isMap = isMap;
+    entry.indefinite = indefinite;
+    entry.expectKey = isMap;
+    m_stack.push_back(entry);
+
+    return true;
+}
+
+/**
+ * @brief forward the string of the string-buffer as key or value to the handler
+ *
+ * @param isKey true, if the string is the key of a map-entry
+ *
+ * @return false, if the handler has aborted, else true
+ */
+bool
+JsonBinaryParser::forwardString(const bool isKey)
+{
+    if(isKey)
+    {
+        if(m_handler->key(m_stringBuffer) == false) {
+            return setError("parsing was aborted by the handler");
+        }
+        return true;
+    }
+
+    return finishValue(m_handler->stringValue(m_stringBuffer));
+}
+
+/**
+ * @brief forward a floating-point-value to the handler
+ *
+ * @param value value to forward
+ *
+ * @return false, if the value doesn't exist in json or the handler has aborted, else true
+ */
+bool
+JsonBinaryParser::forwardDouble(const double value)
+{
+    if(std::isfinite(value) == false) {
+        return setError("infinite values and NaN are not supported");
+    }
+
+    return finishValue(m_handler->doubleValue(value));
+}
+
+/**
+ * @brief count a complete value for the current map or array
+ *
+ * @param result result of the handler for the value
+ *
+ * @return false, if the handler has aborted, else true
+ */
+bool
+JsonBinaryParser::finishValue(const bool result)
+{
+    if(result == false) {
+        return setError("parsing was aborted by the handler");
+    }
+
+    if(m_stack.size() > 0)
+    {
+        StackEntry &entry = m_stack.back();
+        if(entry.indefinite == false) {
+            entry.remaining--;
+        }
+        entry.expectKey = entry.isMap;
+    }
+
+    return true;
+}
+
+/**
+ * @brief read the argument of a CBOR-item, which follows the initial byte
+ *
+ * @param info additional information of the initial byte
+ * @param value reference for the resulting value
+ *
+ * @return false, if the argument is invalid or incomplete, else true
+ */
+bool
+JsonBinaryParser::readCborArgument(const uint8_t info,
+                                   uint64_t &value)
+{
+    if(info < 24)
+    {
+        value = info;
+        return true;
+    }
+
+    if(info > 27)
+    {
+        m_position--;
+        return setError("invalid additional information");
+    }
+
+    return readBigEndian(1u << (info - 24), value);
+}
+
+/**
+ * @brief read an unsigned integer in big-endian byte-order
+ *
+ * @param numberOfBytes number of bytes to read (1, 2, 4 or 8)
+ * @param value reference for the resulting value
+ *
+ * @return false, if the input is too short, else true
+ */
+bool
+JsonBinaryParser::readBigEndian(const uint32_t numberOfBytes,
+                                uint64_t &value)
+{
+    if(numberOfBytes > m_inputSize - m_position) {
+        return setError("unexpected end of the input");
+    }
+
+    value = 0;
+    for(uint32_t i = 0; i < numberOfBytes; i++) {
+        value = (value << 8) | m_input[m_position + i];
+    }
+    m_position += numberOfBytes;
+
+    return true;
+}
+
+/**
+ * @brief append the next bytes of the input to the string-buffer
+ *
+ * @param length number of bytes to append
+ *
+ * @return false, if the input is too short, else true
+ */
+bool
+JsonBinaryParser::readString(const uint64_t length)
+{
+    if(length > m_inputSize - m_position) {
+        return setError("string is longer than the remaining input");
+    }
+
+    m_stringBuffer.append(reinterpret_cast<const char*>(&m_input[m_position]), length);
+    m_position += length;
+
+    return true;
+}
+
+/**
+ * @brief create the error-message for the current position, if there is not already one
+ *
+ * @param message message of the error
+ *
+ * @return always false
+ */
+bool
+JsonBinaryParser::setError(const std::string &message)
+{
+    if(m_errorMessage.size() > 0) {
+        return false;
+    }
+
+    const std::string formatName = m_format == CBOR_FORMAT ? "cbor" : "msgpack";
+    m_errorMessage =  "ERROR while parsing " + formatName + "-data \n";
+    m_errorMessage += "parser-message: " + message + " \n";
+    m_errorMessage += "position: " + std::to_string(m_position);
+
+    return false;
+}
+
+}  // namespace Kitsunemimi
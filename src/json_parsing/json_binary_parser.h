@@ -0,0 +1,81 @@
+/**
+ *  @file    json_binary_parser.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_BINARY_PARSER_H
+#define JSON_BINARY_PARSER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <libKitsunemimiCommon/logger.h>
+
+namespace Kitsunemimi
+{
+class JsonHandler;
+
+class JsonBinaryParser
+{
+public:
+    enum binaryFormats
+    {
+        CBOR_FORMAT = 0,
+        MSGPACK_FORMAT = 1,
+    };
+
+    JsonBinaryParser();
+    ~JsonBinaryParser();
+
+    bool parse(const uint8_t* input,
+               const uint64_t inputSize,
+               const binaryFormats format,
+               JsonHandler &handler,
+               ErrorContainer &error);
+
+private:
+    struct StackEntry
+    {
+        // number of remaining entries of the map or array
+        uint64_t remaining = 0;
+        bool isMap = false;
+        // true for CBOR-containers, which are closed by a break-byte instead of a length
+        bool indefinite = false;
+        bool expectKey = false;
+    };
+
+    JsonHandler* m_handler = nullptr;
+    const uint8_t* m_input = nullptr;
+    uint64_t m_inputSize = 0;
+    uint64_t m_position = 0;
+    binaryFormats m_format = CBOR_FORMAT;
+    std::vector<StackEntry> m_stack;
+    std::string m_stringBuffer = "";
+    std::string m_errorMessage = "";
+
+    bool parseContent();
+    bool parseCborItem(const bool isKey);
+    bool parseMsgPackItem(const bool isKey);
+
+    bool startContainer(const uint64_t numberOfEntries,
+                        const bool isMap,
+                        const bool indefinite);
+    bool forwardString(const bool isKey);
+    bool forwardDouble(const double value);
+    bool finishValue(const bool result);
+    bool readCborArgument(const uint8_t info,
+                          uint64_t &value);
+    bool readBigEndian(const uint32_t numberOfBytes,
+                       uint64_t &value);
+    bool readString(const uint64_t length);
+
+    bool setError(const std::string &message);
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_BINARY_PARSER_H
@@ -0,0 +1,353 @@
+/**
+ *  @file    json_binary_writer.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <json_parsing/json_binary_writer.h>
+
+#include <string.h>
+#include <cfloat>
+#include <cmath>
+
+#include <libKitsunemimiCommon/items/data_items.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief check if a floating-point-value can be stored with single precision without changing
+ *        its value
+ *
+ * @param value value to check
+ *
+ * @return true, if the value fits into a float
+ */
+static inline bool
+fitsIntoFloat(const double value)
+{
+    // the conversion of values out of the range of float is undefined
+    if(std::fabs(value) > static_cast<double>(FLT_MAX)) {
+        return false;
+    }
+
+    return static_cast<double>(static_cast<float>(value)) == value;
+}
+
+/**
+ * @brief convert an item and all of its children into the CBOR-format (RFC 8949). All maps,
+ *        arrays and strings are written with definite length. Floating-point-values are written
+ *        with single precision, if this doesn't change their value, else with double precision.
+ *
+ * @param item item to convert
+ * @param output string, where the result should be appended
+ */
+void
+JsonBinaryWriter::writeCbor(DataItem* item,
+                            std::string &output)
+{
+    if(item == nullptr)
+    {
+        output.push_back(static_cast<char>(0xf6));
+        return;
+    }
+
+    if(item->isMap())
+    {
+        const std::map<std::string, DataItem*> &map = item->toMap()->map;
+        writeCborHead(5, map.size(), output);
+        for(const auto &[key, value] : map)
+        {
+            writeCborHead(3, key.size(), output);
+            output.append(key);
+            writeCbor(value, output);
+        }
+        return;
+    }
+
+    if(item->isArray())
+    {
+        const std::vector<DataItem*> &array = item->toArray()->array;
+        writeCborHead(4, array.size(), output);
+        for(DataItem* value : array) {
+            writeCbor(value, output);
+        }
+        return;
+    }
+
+    DataValue* value = item->toValue();
+    switch(value->getValueType())
+    {
+        case DataItem::STRING_TYPE:
+        {
+            const char* content = value->content.stringValue;
+            const uint64_t length = strlen(content);
+            writeCborHead(3, length, output);
+            output.append(content, length);
+            break;
+        }
+        case DataItem::INT_TYPE:
+        {
+            const long intValue = value->content.longValue;
+            if(intValue >= 0) {
+                writeCborHead(0, static_cast<uint64_t>(intValue), output);
+            } else {
+                // negative integers are stored as -1 - n
+                writeCborHead(1, static_cast<uint64_t>(-(intValue + 1)), output);
+            }
+            break;
+        }
+        case DataItem::FLOAT_TYPE:
+        {
+            const double doubleValue = value->content.doubleValue;
+            if(fitsIntoFloat(doubleValue))
+            {
+                const float floatValue = static_cast<float>(doubleValue);
+                uint32_t bits = 0;
+                memcpy(&bits, &floatValue, 4);
+                output.push_back(static_cast<char>(0xfa));
+                writeBigEndian(bits, 4, output);
+            }
+            else
+            {
+                uint64_t bits = 0;
+                memcpy(&bits, &doubleValue, 8);
+                output.push_back(static_cast<char>(0xfb));
+                writeBigEndian(bits, 8, output);
+            }
+            break;
+        }
+        case DataItem::BOOL_TYPE:
+            output.push_back(static_cast<char>(value->content.boolValue ? 0xf5 : 0xf4));
+            break;
+        default:
+            output.push_back(static_cast<char>(0xf6));
+            break;
+    }
+}
+
+/**
+ * @brief convert an item and all of its children into the MessagePack-format. Each value is
+ *        written with the smallest type, which can hold it.
+ *
+ * @param item item to convert
+ * @param output string, where the result should be appended
+ */
+void
+JsonBinaryWriter::writeMsgPack(DataItem* item,
+                               std::string &output)
+{
+    if(item == nullptr)
+    {
+        output.push_back(static_cast<char>(0xc0));
+        return;
+    }
+
+    if(item->isMap())
+    {
+        const std::map<std::string, DataItem*> &map = item->toMap()->map;
+        writeMsgPackHead(0x80, 0xde, map.size(), output);
+        for(const auto &[key, value] : map)
+        {
+            writeMsgPackHead(0xa0, 0xd9, key.size(), output);
+            output.append(key);
+            writeMsgPack(value, output);
+        }
+        return;
+    }
+
+    if(item->isArray())
+    {
+        const std::vector<DataItem*> &array = item->toArray()->array;
+        writeMsgPackHead(0x90, 0xdc, array.size(), output);
+        for(DataItem* value : array) {
+            writeMsgPack(value, output);
+        }
+        return;
+    }
+
+    DataValue* value = item->toValue();
+    switch(value->getValueType())
+    {
+        case DataItem::STRING_TYPE:
+        {
+            const char* content = value->content.stringValue;
+            const uint64_t length = strlen(content);
+            writeMsgPackHead(0xa0, 0xd9, length, output);
+            output.append(content, length);
+            break;
+        }
+        case DataItem::INT_TYPE:
+        {
+            const long intValue = value->content.longValue;
+            if(intValue >= -32
+                    && intValue <= 127)
+            {
+                // positive and negative fixint
+                output.push_back(static_cast<char>(intValue));
+            }
+            else if(intValue > 0)
+            {
+                if(intValue <= 0xff) {
+                    output.push_back(static_cast<char>(0xcc));
+                    writeBigEndian(static_cast<uint64_t>(intValue), 1, output);
+                } else if(intValue <= 0xffff) {
+                    output.push_back(static_cast<char>(0xcd));
+                    writeBigEndian(static_cast<uint64_t>(intValue), 2, output);
+                } else if(intValue <= 0xffffffffL) {
+                    output.push_back(static_cast<char>(0xce));
+                    writeBigEndian(static_cast<uint64_t>(intValue), 4, output);
+                } else {
+                    output.push_back(static_cast<char>(0xcf));
+                    writeBigEndian(static_cast<uint64_t>(intValue), 8, output);
+                }
+            }
+            else
+            {
+                if(intValue >= INT8_MIN) {
+                    output.push_back(static_cast<char>(0xd0));
+                    writeBigEndian(static_cast<uint64_t>(intValue), 1, output);
+                } else if(intValue >= INT16_MIN) {
+                    output.push_back(static_cast<char>(0xd1));
+                    writeBigEndian(static_cast<uint64_t>(intValue), 2, output);
+                } else if(intValue >= INT32_MIN) {
+                    output.push_back(static_cast<char>(0xd2));
+                    writeBigEndian(static_cast<uint64_t>(intValue), 4, output);
+                } else {
+                    output.push_back(static_cast<char>(0xd3));
+                    writeBigEndian(static_cast<uint64_t>(intValue), 8, output);
+                }
+            }
+            break;
+        }
+        case DataItem::FLOAT_TYPE:
+        {
+            const double doubleValue = value->content.doubleValue;
+            if(fitsIntoFloat(doubleValue))
+            {
+                const float floatValue = static_cast<float>(doubleValue);
+                uint32_t bits = 0;
+                memcpy(&bits, &floatValue, 4);
+                output.push_back(static_cast<char>(0xca));
+                writeBigEndian(bits, 4, output);
+            }
+            else
+            {
+                uint64_t bits = 0;
+                memcpy(&bits, &doubleValue, 8);
+                output.push_back(static_cast<char>(0xcb));
+                writeBigEndian(bits, 8, output);
+            }
+            break;
+        }
+        case DataItem::BOOL_TYPE:
+            output.push_back(static_cast<char>(value->content.boolValue ? 0xc3 : 0xc2));
+            break;
+        default:
+            output.push_back(static_cast<char>(0xc0));
+            break;
+    }
+}
+
+/**
+ * @brief write the initial byte of a CBOR-item together with its argument, which is the value
+ *        of an integer or the length of a string, array or map
+ *
+ * @param majorType major-type of the item (0 - 7)
+ * @param value argument of the item
+ * @param output string, where the result should be appended
+ */
+void
+JsonBinaryWriter::writeCborHead(const uint8_t majorType,
+                                const uint64_t value,
+                                std::string &output)
+{
+    const uint8_t type = static_cast<uint8_t>(majorType << 5);
+
+    if(value < 24) {
+        output.push_back(static_cast<char>(type | value));
+    } else if(value <= 0xff) {
+        output.push_back(static_cast<char>(type | 24));
+        writeBigEndian(value, 1, output);
+    } else if(value <= 0xffff) {
+        output.push_back(static_cast<char>(type | 25));
+        writeBigEndian(value, 2, output);
+    } else if(value <= 0xffffffffULL) {
+        output.push_back(static_cast<char>(type | 26));
+        writeBigEndian(value, 4, output);
+    } else {
+        output.push_back(static_cast<char>(type | 27));
+        writeBigEndian(value, 8, output);
+    }
+}
+
+/**
+ * @brief write the type-byte and the length of a MessagePack-string, -array or -map
+ *
+ * @param fixType type of the variant, where the length is stored within the type-byte
+ * @param type type of the variant with an 8-bit length for strings or a 16-bit length for
+ *             arrays and maps. The types with the next bigger length follow directly.
+ * @param value length of the string, array or map
+ * @param output string, where the result should be appended
+ */
+void
+JsonBinaryWriter::writeMsgPackHead(const uint8_t fixType,
+                                   const uint8_t type,
+                                   const uint64_t value,
+                                   std::string &output)
+{
+    // strings can store up to 31 bytes in the type-byte, maps and arrays up to 15 entries
+    const uint64_t fixLimit = fixType == 0xa0 ? 32 : 16;
+    if(value < fixLimit)
+    {
+        output.push_back(static_cast<char>(fixType | value));
+        return;
+    }
+
+    // only strings have a variant with an 8-bit length
+    uint8_t currentType = type;
+    if(fixType == 0xa0)
+    {
+        if(value <= 0xff)
+        {
+            output.push_back(static_cast<char>(currentType));
+            writeBigEndian(value, 1, output);
+            return;
+        }
+        currentType++;
+    }
+
+    if(value <= 0xffff)
+    {
+        output.push_back(static_cast<char>(currentType));
+        writeBigEndian(value, 2, output);
+        return;
+    }
+
+    output.push_back(static_cast<char>(currentType + 1));
+    writeBigEndian(value, 4, output);
+}
+
+/**
+ * @brief append the lower bytes of a value in big-endian byte-order
+ *
+ * @param value value to write
+ * @param numberOfBytes number of bytes to write (1, 2, 4 or 8)
+ * @param output string, where the result should be appended
+ */
+void
+JsonBinaryWriter::writeBigEndian(const uint64_t value,
+                                 const uint32_t numberOfBytes,
+                                 std::string &output)
+{
+    char buffer[8];
+    for(uint32_t i = 0; i < numberOfBytes; i++) {
+        buffer[i] = static_cast<char>(value >> (8 * (numberOfBytes - 1 - i)));
+    }
+
+    output.append(buffer, numberOfBytes);
+}
+
+}  // namespace Kitsunemimi
@@ -0,0 +1,42 @@
+/**
+ *  @file    json_binary_writer.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_BINARY_WRITER_H
+#define JSON_BINARY_WRITER_H
+
+#include <stdint.h>
+#include <string>
+
+namespace Kitsunemimi
+{
+class DataItem;
+
+class JsonBinaryWriter
+{
+public:
+    static void writeCbor(DataItem* item,
+                          std::string &output);
+    static void writeMsgPack(DataItem* item,
+                             std::string &output);
+
+private:
+    static void writeCborHead(const uint8_t majorType,
+                              const uint64_t value,
+                              std::string &output);
+    static void writeMsgPackHead(const uint8_t fixType,
+                                 const uint8_t type,
+                                 const uint64_t value,
+                                 std::string &output);
+    static void writeBigEndian(const uint64_t value,
+                               const uint32_t numberOfBytes,
+                               std::string &output);
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_BINARY_WRITER_H
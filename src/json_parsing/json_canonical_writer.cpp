@@ -0,0 +1,332 @@
+/**
+ *  @file    json_canonical_writer.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <json_parsing/json_canonical_writer.h>
+#include <json_parsing/json_writer.h>
+#include <json_parsing/json_hasher.h>
+
+#include <string.h>
+#include <charconv>
+#include <cmath>
+
+#include <libKitsunemimiCommon/items/data_items.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief convert a tree into its canonical json-form, which is the same for all equal trees.
+ *        It is written without any whitespace, with the keys of the maps sorted by their bytes
+ *        (which is the order of the unicode code-points for utf-8), with numbers in the format
+ *        of the JSON Canonicalization Scheme (RFC 8785) and with escapes only for the quote,
+ *        the backslash and the control characters. Because the maps of the data-items store
+ *        their keys already sorted, no additional sorting is necessary.
+ *
+ * @param item root of the tree
+ * @param output string, where the result should be appended
+ */
+void
+JsonCanonicalWriter::write(DataItem* item,
+                           std::string &output)
+{
+    if(item == nullptr) {
+        return;
+    }
+
+    writeItem(item, output);
+}
+
+/**
+ * @brief calculate the 128-bit hash of the canonical form of a tree, without creating the
+ *        canonical string. The canonical output is given in small pieces directly to the hasher,
+ *        so the result is the same like the hash of the string of the write-function, but it
+ *        doesn't need any memory for the output.
+ *
+ * @param item root of the tree
+ * @param first reference for the first 64 bits of the hash
+ * @param second reference for the second 64 bits of the hash
+ */
+void
+JsonCanonicalWriter::hash(DataItem* item,
+                          uint64_t &first,
+                          uint64_t &second)
+{
+    JsonHasher hasher;
+    if(item != nullptr) {
+        writeItem(item, hasher);
+    }
+
+    hasher.finish(first, second);
+}
+
+/**
+ * @brief convert an item and all of its children
+ *
+ * @param item item to convert
+ * @param output string or hasher, where the result should be appended
+ */
+template<typename OUTPUT>
+void
+JsonCanonicalWriter::writeItem(DataItem* item,
+                               OUTPUT &output)
+{
+    if(item == nullptr)
+    {
+        output.append("null", 4);
+        return;
+    }
+
+    if(item->isMap())
+    {
+        output.push_back('{');
+        bool first = true;
+        for(const auto &[key, value] : item->toMap()->map)
+        {
+            if(first == false) {
+                output.push_back(',');
+            }
+            first = false;
+
+            writeString(key.c_str(), key.size(), output);
+            output.push_back(':');
+            writeItem(value, output);
+        }
+        output.push_back('}');
+        return;
+    }
+
+    if(item->isArray())
+    {
+        output.push_back('[');
+        bool first = true;
+        for(DataItem* value : item->toArray()->array)
+        {
+            if(first == false) {
+                output.push_back(',');
+            }
+            first = false;
+
+            writeItem(value, output);
+        }
+        output.push_back(']');
+        return;
+    }
+
+    DataValue* value = item->toValue();
+    switch(value->getValueType())
+    {
+        case DataItem::STRING_TYPE:
+        {
+            const char* content = value->content.stringValue;
+            writeString(content, strlen(content), output);
+            break;
+        }
+        case DataItem::INT_TYPE:
+            writeLong(value->content.longValue, output);
+            break;
+        case DataItem::FLOAT_TYPE:
+            writeDouble(value->content.doubleValue, output);
+            break;
+        case DataItem::BOOL_TYPE:
+            if(value->content.boolValue) {
+                output.append("true", 4);
+            } else {
+                output.append("false", 5);
+            }
+            break;
+        default:
+            output.append("null", 4);
+            break;
+    }
+}
+
+/**
+ * @brief append a string with quotes, where only the quote, the backslash and the control
+ *        characters are escaped and all other bytes are copied unchanged
+ *
+ * @param input pointer to the string
+ * @param length length of the string
+ * @param output string or hasher, where the result should be appended
+ */
+template<typename OUTPUT>
+void
+JsonCanonicalWriter::writeString(const char* input,
+                                 const uint64_t length,
+                                 OUTPUT &output)
+{
+    output.push_back('"');
+
+    uint64_t runStart = 0;
+    uint64_t position = JsonWriter::findEscapeChar(input, 0, length);
+    while(position < length)
+    {
+        char sequence[6];
+        const uint8_t c = static_cast<uint8_t>(input[position]);
+        const uint32_t sequenceLength = JsonWriter::getEscapeSequence(c, sequence);
+
+        output.append(&input[runStart], position - runStart);
+        output.append(sequence, sequenceLength);
+
+        runStart = position + 1;
+        position = JsonWriter::findEscapeChar(input, runStart, length);
+    }
+
+    output.append(&input[runStart], length - runStart);
+    output.push_back('"');
+}
+
+/**
+ * @brief append an integer
+ *
+ * @param value integer to write
+ * @param output string or hasher, where the result should be appended
+ */
+template<typename OUTPUT>
+void
+JsonCanonicalWriter::writeLong(const long value,
+                               OUTPUT &output)
+{
+    char buffer[24];
+    const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    output.append(buffer, static_cast<uint64_t>(result.ptr - buffer));
+}
+
+/**
+ * @brief append a floating-point-value like the number-serialization of RFC 8785 with the
+ *        shortest digits, which result in exactly the same value. Values without fraction
+ *        are written like integers, so 42.0 and 42 have the same canonical form, and values
+ *        below 1e-6 or from 1e21 on are written with exponent. Because json has no
+ *        representation for inf and nan, they are written as null.
+ *
+ * @param value floating-point-value to write
+ * @param output string or hasher, where the result should be appended
+ */
+template<typename OUTPUT>
+void
+JsonCanonicalWriter::writeDouble(const double value,
+                                 OUTPUT &output)
+{
+    if(std::isfinite(value) == false)
+    {
+        output.append("null", 4);
+        return;
+    }
+
+    // -0.0 is written as 0 too
+    if(value == 0.0)
+    {
+        output.push_back('0');
+        return;
+    }
+
+    // get the shortest digits and the exponent in the scientific format like "-1.2345e+02"
+    char buffer[32];
+    const std::to_chars_result result = std::to_chars(buffer,
+                                                      buffer + sizeof(buffer),
+                                                      value,
+                                                      std::chars_format::scientific);
+    const char* end = result.ptr;
+    const char* position = buffer;
+
+    char digits[20];
+    int32_t numberOfDigits = 0;
+    const bool negative = *position == '-';
+    if(negative) {
+        position++;
+    }
+
+    while(*position != 'e')
+    {
+        if(*position != '.')
+        {
+            digits[numberOfDigits] = *position;
+            numberOfDigits++;
+        }
+        position++;
+    }
+
+    // skip the 'e' and the '+', which isn't accepted by from_chars
+    position++;
+    if(*position == '+') {
+        position++;
+    }
+
+    int32_t exponent = 0;
+    std::from_chars(position, end, exponent);
+
+    // position of the decimal point relative to the first digit
+    const int32_t point = exponent + 1;
+
+    char number[48];
+    uint64_t length = 0;
+    if(negative)
+    {
+        number[length] = '-';
+        length++;
+    }
+
+    if(numberOfDigits <= point
+            && point <= 21)
+    {
+        // integer with trailing zeros
+        memcpy(&number[length], digits, static_cast<uint64_t>(numberOfDigits));
+        length += static_cast<uint64_t>(numberOfDigits);
+        memset(&number[length], '0', static_cast<uint64_t>(point - numberOfDigits));
+        length += static_cast<uint64_t>(point - numberOfDigits);
+    }
+    else if(0 < point
+            && point <= 21)
+    {
+        // decimal point within the digits
+        memcpy(&number[length], digits, static_cast<uint64_t>(point));
+        length += static_cast<uint64_t>(point);
+        number[length] = '.';
+        length++;
+        memcpy(&number[length], &digits[point], static_cast<uint64_t>(numberOfDigits - point));
+        length += static_cast<uint64_t>(numberOfDigits - point);
+    }
+    else if(-6 < point
+            && point <= 0)
+    {
+        // leading zeros after the decimal point
+        number[length] = '0';
+        number[length + 1] = '.';
+        length += 2;
+        memset(&number[length], '0', static_cast<uint64_t>(-point));
+        length += static_cast<uint64_t>(-point);
+        memcpy(&number[length], digits, static_cast<uint64_t>(numberOfDigits));
+        length += static_cast<uint64_t>(numberOfDigits);
+    }
+    else
+    {
+        // exponent-format with one digit before the decimal point
+        number[length] = digits[0];
+        length++;
+        if(numberOfDigits > 1)
+        {
+            number[length] = '.';
+            length++;
+            memcpy(&number[length], &digits[1], static_cast<uint64_t>(numberOfDigits - 1));
+            length += static_cast<uint64_t>(numberOfDigits - 1);
+        }
+
+        number[length] = 'e';
+        number[length + 1] = exponent < 0 ? '-' : '+';
+        length += 2;
+
+        const int32_t absoluteExponent = exponent < 0 ? -exponent : exponent;
+        const std::to_chars_result exponentResult = std::to_chars(&number[length],
+                                                                  number + sizeof(number),
+                                                                  absoluteExponent);
+        length = static_cast<uint64_t>(exponentResult.ptr - number);
+    }
+
+    output.append(number, length);
+}
+
+}  // namespace Kitsunemimi
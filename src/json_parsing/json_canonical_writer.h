@@ -0,0 +1,46 @@
+/**
+ *  @file    json_canonical_writer.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_CANONICAL_WRITER_H
+#define JSON_CANONICAL_WRITER_H
+
+#include <stdint.h>
+#include <string>
+
+namespace Kitsunemimi
+{
+class DataItem;
+
+class JsonCanonicalWriter
+{
+public:
+    static void write(DataItem* item,
+                      std::string &output);
+    static void hash(DataItem* item,
+                     uint64_t &first,
+                     uint64_t &second);
+
+private:
+    template<typename OUTPUT>
+    static void writeItem(DataItem* item,
+                          OUTPUT &output);
+    template<typename OUTPUT>
+    static void writeString(const char* input,
+                            const uint64_t length,
+                            OUTPUT &output);
+    template<typename OUTPUT>
+    static void writeLong(const long value,
+                          OUTPUT &output);
+    template<typename OUTPUT>
+    static void writeDouble(const double value,
+                            OUTPUT &output);
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_CANONICAL_WRITER_H
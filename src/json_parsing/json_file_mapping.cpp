@@ -0,0 +1,141 @@
+/**
+ *  @file    json_file_mapping.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <json_parsing/json_file_mapping.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief The class maps a file read-only into the memory, so it can be parsed directly without
+ *        reading it into a string before. The mapping is removed again by the destructor.
+ */
+JsonFileMapping::JsonFileMapping() {}
+
+/**
+ * @brief destructor
+ */
+JsonFileMapping::~JsonFileMapping()
+{
+    close();
+}
+
+/**
+ * @brief map a file into the memory
+ *
+ * @param filePath path to the file
+ * @param error reference for error-message output
+ * @param sequentialRead true, if the file is read only once from the beginning to the end,
+ *                       false for files, which are accessed at random positions
+ *
+ * @return false, if the file can not be opened or mapped, else true
+ */
+bool
+JsonFileMapping::open(const std::string &filePath,
+                      ErrorContainer &error,
+                      const bool sequentialRead)
+{
+    close();
+
+    // open file
+    const int fd = ::open(filePath.c_str(), O_RDONLY);
+    if(fd == -1)
+    {
+        error.addMeesage("failed to open json-file '" + filePath + "': " + strerror(errno));
+        LOG_ERROR(error);
+        return false;
+    }
+
+    // get size of the file
+    struct stat fileStats;
+    if(fstat(fd, &fileStats) == -1)
+    {
+        error.addMeesage("failed to read json-file '" + filePath + "': " + strerror(errno));
+        LOG_ERROR(error);
+        ::close(fd);
+        return false;
+    }
+
+    if(S_ISREG(fileStats.st_mode) == false)
+    {
+        error.addMeesage("failed to read json-file '" + filePath + "': not a regular file");
+        LOG_ERROR(error);
+        ::close(fd);
+        return false;
+    }
+
+    // an empty file can not be mapped, so it is handled like an empty string
+    const uint64_t fileSize = static_cast<uint64_t>(fileStats.st_size);
+    if(fileSize == 0)
+    {
+        ::close(fd);
+        return true;
+    }
+
+    // map file into the memory, which stays valid after closing the file-descriptor
+    void* data = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if(data == MAP_FAILED)
+    {
+        error.addMeesage("failed to map json-file '" + filePath + "': " + strerror(errno));
+        LOG_ERROR(error);
+        return false;
+    }
+
+    // a file, which is read only once from the beginning to the end, allows the kernel to read
+    // ahead and drop already parsed pages
+    if(sequentialRead) {
+        madvise(data, fileSize, MADV_SEQUENTIAL);
+    }
+
+    m_data = data;
+    m_size = fileSize;
+
+    return true;
+}
+
+/**
+ * @brief remove the mapping of the file
+ */
+void
+JsonFileMapping::close()
+{
+    if(m_data != nullptr) {
+        munmap(m_data, m_size);
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+/**
+ * @brief get pointer to the content of the mapped file
+ */
+const char*
+JsonFileMapping::getData() const
+{
+    return static_cast<const char*>(m_data);
+}
+
+/**
+ * @brief get size of the mapped file
+ */
+uint64_t
+JsonFileMapping::getSize() const
+{
+    return m_size;
+}
+
+}  // namespace Kitsunemimi
@@ -0,0 +1,40 @@
+/**
+ *  @file    json_file_mapping.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_FILE_MAPPING_H
+#define JSON_FILE_MAPPING_H
+
+#include <string>
+
+#include <libKitsunemimiCommon/logger.h>
+
+namespace Kitsunemimi
+{
+
+class JsonFileMapping
+{
+public:
+    JsonFileMapping();
+    ~JsonFileMapping();
+
+    bool open(const std::string &filePath,
+              ErrorContainer &error,
+              const bool sequentialRead = true);
+    void close();
+
+    const char* getData() const;
+    uint64_t getSize() const;
+
+private:
+    void* m_data = nullptr;
+    uint64_t m_size = 0;
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_FILE_MAPPING_H
@@ -0,0 +1,192 @@
+/**
+ *  @file    json_hasher.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <json_parsing/json_hasher.h>
+
+namespace Kitsunemimi
+{
+
+static const uint64_t c1 = 0x87c37b91114253d5;
+static const uint64_t c2 = 0x4cf5ad432745937f;
+
+static inline uint64_t
+rotateLeft(const uint64_t value,
+           const uint32_t bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t
+finalMix(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccd;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53;
+    value ^= value >> 33;
+
+    return value;
+}
+
+static inline uint64_t
+readLittleEndian(const uint8_t* data,
+                 const uint32_t numberOfBytes)
+{
+    uint64_t value = 0;
+    for(uint32_t i = 0; i < numberOfBytes; i++) {
+        value |= static_cast<uint64_t>(data[i]) << (8 * i);
+    }
+
+    return value;
+}
+
+/**
+ * @brief The class calculates the 128-bit MurmurHash3 (x64-variant with seed 0) of a byte-stream,
+ *        which is given in pieces of any size, so the input never has to be in the memory at
+ *        once. The result is the same like for the complete input in one piece. It is not a
+ *        cryptographic hash, but fast and with a good distribution for caches and
+ *        deduplication.
+ */
+JsonHasher::JsonHasher() {}
+
+/**
+ * @brief destructor
+ */
+JsonHasher::~JsonHasher() {}
+
+/**
+ * @brief add bytes, which don't fit into the buffer anymore. The buffer is filled and processed
+ *        at first and then all full blocks are processed directly from the input.
+ *
+ * @param data pointer to the bytes
+ * @param length number of bytes
+ */
+void
+JsonHasher::appendBlocks(const char* data,
+                         const uint64_t length)
+{
+    const uint8_t* input = reinterpret_cast<const uint8_t*>(data);
+
+    // fill the buffer up to the next block-border, which always fits, because the capacity of
+    // the buffer is a multiple of the block-size
+    const uint64_t missing = (16 - (m_bufferSize % 16)) % 16;
+    memcpy(&m_buffer[m_bufferSize], input, missing);
+    m_bufferSize += missing;
+    uint64_t position = missing;
+    processBuffer();
+
+    while(position + 16 <= length)
+    {
+        processBlock(&input[position]);
+        m_totalLength += 16;
+        position += 16;
+    }
+
+    m_bufferSize = length - position;
+    memcpy(m_buffer, &input[position], m_bufferSize);
+}
+
+/**
+ * @brief process all full blocks of the buffer and move the remaining bytes to its begin
+ */
+void
+JsonHasher::processBuffer()
+{
+    const uint64_t numberOfBlocks = m_bufferSize / 16;
+    for(uint64_t i = 0; i < numberOfBlocks; i++) {
+        processBlock(&m_buffer[i * 16]);
+    }
+
+    const uint64_t processed = numberOfBlocks * 16;
+    m_totalLength += processed;
+    m_bufferSize -= processed;
+    memmove(m_buffer, &m_buffer[processed], m_bufferSize);
+}
+
+/**
+ * @brief process the remaining bytes and get the result
+ *
+ * @param first reference for the first 64 bits of the hash
+ * @param second reference for the second 64 bits of the hash
+ */
+void
+JsonHasher::finish(uint64_t &first,
+                   uint64_t &second)
+{
+    processBuffer();
+
+    uint64_t h1 = m_h1;
+    uint64_t h2 = m_h2;
+    const uint64_t totalLength = m_totalLength + m_bufferSize;
+
+    if(m_bufferSize > 8)
+    {
+        uint64_t k2 = readLittleEndian(&m_buffer[8], static_cast<uint32_t>(m_bufferSize - 8));
+        k2 *= c2;
+        k2 = rotateLeft(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+    }
+
+    if(m_bufferSize > 0)
+    {
+        const uint32_t numberOfBytes = m_bufferSize > 8 ? 8 : static_cast<uint32_t>(m_bufferSize);
+        uint64_t k1 = readLittleEndian(m_buffer, numberOfBytes);
+        k1 *= c1;
+        k1 = rotateLeft(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+    }
+
+    h1 ^= totalLength;
+    h2 ^= totalLength;
+
+    h1 += h2;
+    h2 += h1;
+
+    h1 = finalMix(h1);
+    h2 = finalMix(h2);
+
+    h1 += h2;
+    h2 += h1;
+
+    first = h1;
+    second = h2;
+}
+
+/**
+ * @brief mix a block of 16 bytes into the state
+ *
+ * @param block pointer to the block
+ */
+void
+JsonHasher::processBlock(const uint8_t* block)
+{
+    uint64_t k1 = readLittleEndian(block, 8);
+    uint64_t k2 = readLittleEndian(&block[8], 8);
+
+    k1 *= c1;
+    k1 = rotateLeft(k1, 31);
+    k1 *= c2;
+    m_h1 ^= k1;
+
+    m_h1 = rotateLeft(m_h1, 27);
+    m_h1 += m_h2;
+    m_h1 = m_h1 * 5 + 0x52dce729;
+
+    k2 *= c2;
+    k2 = rotateLeft(k2, 33);
+    k2 *= c1;
+    m_h2 ^= k2;
+
+    m_h2 = rotateLeft(m_h2, 31);
+    m_h2 += m_h1;
+    m_h2 = m_h2 * 5 + 0x38495ab5;
+}
+
+}  // namespace Kitsunemimi
@@ -0,0 +1,83 @@
+/**
+ *  @file    json_hasher.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_HASHER_H
+#define JSON_HASHER_H
+
+#include <stdint.h>
+#include <string.h>
+
+namespace Kitsunemimi
+{
+
+class JsonHasher
+{
+public:
+    JsonHasher();
+    ~JsonHasher();
+
+    /**
+     * @brief add bytes to the hash, which are only copied into the buffer, as long as it has
+     *        enough space
+     *
+     * @param data pointer to the bytes
+     * @param length number of bytes
+     */
+    inline void
+    append(const char* data,
+           const uint64_t length)
+    {
+        if(m_bufferSize + length > m_bufferCapacity)
+        {
+            appendBlocks(data, length);
+            return;
+        }
+
+        memcpy(&m_buffer[m_bufferSize], data, length);
+        m_bufferSize += length;
+    }
+
+    /**
+     * @brief add a single byte to the hash
+     *
+     * @param c byte to add
+     */
+    inline void
+    push_back(const char c)
+    {
+        if(m_bufferSize == m_bufferCapacity) {
+            processBuffer();
+        }
+
+        m_buffer[m_bufferSize] = static_cast<uint8_t>(c);
+        m_bufferSize++;
+    }
+
+    void finish(uint64_t &first,
+                uint64_t &second);
+
+private:
+    uint64_t m_h1 = 0;
+    uint64_t m_h2 = 0;
+    uint64_t m_totalLength = 0;
+
+    // the input is collected in a buffer, so the many small pieces of the writer don't have
+    // to be processed one by one. The capacity is a multiple of the block-size of 16 bytes.
+    static const uint64_t m_bufferCapacity = 1024;
+    uint8_t m_buffer[m_bufferCapacity];
+    uint64_t m_bufferSize = 0;
+
+    void appendBlocks(const char* data,
+                      const uint64_t length);
+    void processBuffer();
+    void processBlock(const uint8_t* block);
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_HASHER_H
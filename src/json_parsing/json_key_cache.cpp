@@ -0,0 +1,121 @@
+/**
+ *  @file    json_key_cache.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <json_parsing/json_key_cache.h>
+
+#include <string.h>
+
+#include <libKitsunemimiJson/json_key_pool.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief Local cache of a parser in front of a shared key-pool. Keys, which were already
+ *        requested by the parser, are found without any lock of the pool. The statistics are
+ *        collected locally and added to the pool, when the cache is flushed.
+ */
+JsonKeyCache::JsonKeyCache()
+{
+    memset(m_entries, 0, sizeof(m_entries));
+}
+
+/**
+ * @brief destructor
+ */
+JsonKeyCache::~JsonKeyCache()
+{
+    flush();
+}
+
+/**
+ * @brief connect the cache to a key-pool
+ *
+ * @param keyPool pool to use, or nullptr to disable the interning
+ */
+void
+JsonKeyCache::init(JsonKeyPool* keyPool)
+{
+    flush();
+
+    m_keyPool = keyPool;
+    memset(m_entries, 0, sizeof(m_entries));
+}
+
+/**
+ * @brief check if the cache is connected to a key-pool
+ *
+ * @return true, if a key-pool is set, else false
+ */
+bool
+JsonKeyCache::isActive() const
+{
+    return m_keyPool != nullptr;
+}
+
+/**
+ * @brief get the interned string for a key
+ *
+ * @param key key to intern
+ *
+ * @return pointer to the interned string, or nullptr, if there is no key-pool or the key is new
+ *         and the key-pool is already full
+ */
+const std::string*
+JsonKeyCache::intern(std::string_view key)
+{
+    if(m_keyPool == nullptr) {
+        return nullptr;
+    }
+
+    // cheap hash out of the length and the first and last character, which differ for most
+    // keys of the same record. A collision only results in an additional lookup in the pool.
+    uint32_t slot = static_cast<uint32_t>(key.size()) * 31;
+    if(key.size() > 0)
+    {
+        slot ^= static_cast<uint8_t>(key.front());
+        slot ^= static_cast<uint32_t>(static_cast<uint8_t>(key.back())) << 3;
+        slot ^= static_cast<uint32_t>(static_cast<uint8_t>(key[key.size() / 2])) << 1;
+    }
+    slot %= m_numberOfEntries;
+
+    const std::string* entry = m_entries[slot];
+    if(entry != nullptr
+            && entry->size() == key.size()
+            && memcmp(entry->data(), key.data(), key.size()) == 0)
+    {
+        m_numberOfHits++;
+        m_savedBytes += key.size();
+        return entry;
+    }
+
+    entry = m_keyPool->intern(key);
+    if(entry != nullptr) {
+        m_entries[slot] = entry;
+    }
+
+    return entry;
+}
+
+/**
+ * @brief add the collected statistics to the key-pool
+ */
+void
+JsonKeyCache::flush()
+{
+    if(m_keyPool != nullptr
+            && m_numberOfHits > 0)
+    {
+        m_keyPool->addStatistics(m_numberOfHits, m_savedBytes);
+    }
+
+    m_numberOfHits = 0;
+    m_savedBytes = 0;
+}
+
+}  // namespace Kitsunemimi
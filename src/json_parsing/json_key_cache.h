@@ -0,0 +1,42 @@
+/**
+ *  @file    json_key_cache.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_KEY_CACHE_H
+#define JSON_KEY_CACHE_H
+
+#include <string>
+#include <string_view>
+
+namespace Kitsunemimi
+{
+class JsonKeyPool;
+
+class JsonKeyCache
+{
+public:
+    JsonKeyCache();
+    ~JsonKeyCache();
+
+    void init(JsonKeyPool* keyPool);
+    bool isActive() const;
+    const std::string* intern(std::string_view key);
+    void flush();
+
+private:
+    // small direct-mapped cache, which is enough for the few different keys of typical records
+    static const uint32_t m_numberOfEntries = 64;
+
+    JsonKeyPool* m_keyPool = nullptr;
+    const std::string* m_entries[m_numberOfEntries];
+    uint64_t m_numberOfHits = 0;
+    uint64_t m_savedBytes = 0;
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_KEY_CACHE_H
@@ -0,0 +1,307 @@
+/**
+ *  @file    json_node_pool.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <json_parsing/json_node_pool.h>
+
+#include <string.h>
+
+#include <libKitsunemimiCommon/items/data_items.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief Pool of unused items of old trees. The items are taken apart instead of being
+ *        deleted, so the next trees can be built out of them. Maps and arrays keep the memory
+ *        of their containers, map-entries are moved as nodes into the pool and string-values
+ *        keep their buffer. So a new tree with a similar shape like an old one needs nearly
+ *        no new allocations.
+ */
+JsonNodePool::JsonNodePool() {}
+
+/**
+ * @brief destructor, which deletes all items within the pool
+ */
+JsonNodePool::~JsonNodePool()
+{
+    clear();
+}
+
+/**
+ * @brief get an empty map from the pool or create a new one
+ *
+ * @return pointer to the map
+ */
+DataMap*
+JsonNodePool::createMap()
+{
+    if(m_maps.size() == 0) {
+        return new DataMap();
+    }
+
+    DataMap* map = m_maps.back();
+    m_maps.pop_back();
+
+    return map;
+}
+
+/**
+ * @brief get an empty array from the pool or create a new one
+ *
+ * @return pointer to the array
+ */
+DataArray*
+JsonNodePool::createArray()
+{
+    if(m_arrays.size() == 0) {
+        return new DataArray();
+    }
+
+    DataArray* array = m_arrays.back();
+    m_arrays.pop_back();
+
+    return array;
+}
+
+/**
+ * @brief get a string-value from the pool or create a new one. The buffer of a value from the
+ *        pool is reused, if the new string fits into it.
+ *
+ * @param value string to store
+ *
+ * @return pointer to the value
+ */
+DataValue*
+JsonNodePool::createValue(const std::string &value)
+{
+    if(m_stringValues.size() == 0) {
+        return new DataValue(value);
+    }
+
+    const auto [item, bufferSize] = m_stringValues.back();
+    m_stringValues.pop_back();
+
+    if(value.size() < bufferSize)
+    {
+        memcpy(item->content.stringValue, value.c_str(), value.size() + 1);
+        return item;
+    }
+
+    item->setValue(value);
+
+    return item;
+}
+
+/**
+ * @brief get a value from the pool or create a new one
+ *
+ * @param value integer to store
+ *
+ * @return pointer to the value
+ */
+DataValue*
+JsonNodePool::createValue(const long value)
+{
+    if(m_values.size() == 0) {
+        return new DataValue(value);
+    }
+
+    DataValue* item = m_values.back();
+    m_values.pop_back();
+    item->setValue(value);
+
+    return item;
+}
+
+/**
+ * @brief get a value from the pool or create a new one
+ *
+ * @param value floating-point-value to store
+ *
+ * @return pointer to the value
+ */
+DataValue*
+JsonNodePool::createValue(const double value)
+{
+    if(m_values.size() == 0) {
+        return new DataValue(value);
+    }
+
+    DataValue* item = m_values.back();
+    m_values.pop_back();
+    item->setValue(value);
+
+    return item;
+}
+
+/**
+ * @brief get a value from the pool or create a new one
+ *
+ * @param value bool-value to store
+ *
+ * @return pointer to the value
+ */
+DataValue*
+JsonNodePool::createValue(const bool value)
+{
+    if(m_values.size() == 0) {
+        return new DataValue(value);
+    }
+
+    DataValue* item = m_values.back();
+    m_values.pop_back();
+    item->setValue(value);
+
+    return item;
+}
+
+/**
+ * @brief add a key-value-pair to a map with a node from the pool, if there is one
+ *
+ * @param map map, where the pair should be added
+ * @param key key of the pair
+ * @param value value of the pair
+ *
+ * @return false, if the key already exist in the map, else true
+ */
+bool
+JsonNodePool::insert(DataMap* map,
+                     const std::string &key,
+                     DataItem* value)
+{
+    const auto it = map->map.lower_bound(key);
+    if(it != map->map.end()
+            && it->first == key)
+    {
+        return false;
+    }
+
+    if(m_mapNodes.size() == 0)
+    {
+        map->map.emplace_hint(it, key, value);
+        return true;
+    }
+
+    std::map<std::string, DataItem*>::node_type node = std::move(m_mapNodes.back());
+    m_mapNodes.pop_back();
+    node.key() = key;
+    node.mapped() = value;
+    map->map.insert(it, std::move(node));
+
+    return true;
+}
+
+/**
+ * @brief take a tree apart and move all of its items into the pool
+ *
+ * @param item root of the tree, which must not be used anymore after this
+ */
+void
+JsonNodePool::recycle(DataItem* item)
+{
+    if(item == nullptr) {
+        return;
+    }
+
+    m_recycleStack.push_back(item);
+    while(m_recycleStack.size() > 0)
+    {
+        DataItem* current = m_recycleStack.back();
+        m_recycleStack.pop_back();
+
+        if(current->isMap())
+        {
+            std::map<std::string, DataItem*> &map = current->toMap()->map;
+            while(map.size() > 0)
+            {
+                std::map<std::string, DataItem*>::node_type node = map.extract(map.begin());
+                if(node.mapped() != nullptr) {
+                    m_recycleStack.push_back(node.mapped());
+                }
+                m_mapNodes.push_back(std::move(node));
+            }
+            m_maps.push_back(current->toMap());
+            continue;
+        }
+
+        if(current->isArray())
+        {
+            std::vector<DataItem*> &array = current->toArray()->array;
+            for(DataItem* child : array)
+            {
+                if(child != nullptr) {
+                    m_recycleStack.push_back(child);
+                }
+            }
+            array.clear();
+            m_arrays.push_back(current->toArray());
+            continue;
+        }
+
+        // the buffer of a string has at least the size of its current content, so this
+        // part can be used for a new string
+        DataValue* value = current->toValue();
+        if(value->isStringValue())
+        {
+            const uint64_t bufferSize = strlen(value->content.stringValue) + 1;
+            m_stringValues.emplace_back(value, bufferSize);
+        }
+        else
+        {
+            m_values.push_back(value);
+        }
+    }
+}
+
+/**
+ * @brief delete all items within the pool
+ */
+void
+JsonNodePool::clear()
+{
+    for(DataMap* map : m_maps) {
+        delete map;
+    }
+    m_maps.clear();
+
+    for(DataArray* array : m_arrays) {
+        delete array;
+    }
+    m_arrays.clear();
+
+    for(DataValue* value : m_values) {
+        delete value;
+    }
+    m_values.clear();
+
+    for(const auto &[value, bufferSize] : m_stringValues) {
+        delete value;
+    }
+    m_stringValues.clear();
+
+    // the values of the nodes are already moved back into the pool, so only the nodes itself
+    // are deleted here
+    m_mapNodes.clear();
+}
+
+/**
+ * @brief get number of items and map-entries, which are stored within the pool
+ *
+ * @return number of items
+ */
+uint64_t
+JsonNodePool::getNumberOfItems() const
+{
+    return m_maps.size()
+           + m_arrays.size()
+           + m_values.size()
+           + m_stringValues.size()
+           + m_mapNodes.size();
+}
+
+}  // namespace Kitsunemimi
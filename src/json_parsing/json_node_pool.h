@@ -0,0 +1,61 @@
+/**
+ *  @file    json_node_pool.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_NODE_POOL_H
+#define JSON_NODE_POOL_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+
+namespace Kitsunemimi
+{
+class DataItem;
+class DataMap;
+class DataArray;
+class DataValue;
+
+class JsonNodePool
+{
+public:
+    JsonNodePool();
+    ~JsonNodePool();
+
+    DataMap* createMap();
+    DataArray* createArray();
+    DataValue* createValue(const std::string &value);
+    DataValue* createValue(const long value);
+    DataValue* createValue(const double value);
+    DataValue* createValue(const bool value);
+    bool insert(DataMap* map,
+                const std::string &key,
+                DataItem* value);
+
+    void recycle(DataItem* item);
+    void clear();
+    uint64_t getNumberOfItems() const;
+
+private:
+    std::vector<DataMap*> m_maps;
+    std::vector<DataArray*> m_arrays;
+    std::vector<DataValue*> m_values;
+
+    // string-values together with the size of their buffer, which can be reused for new strings
+    std::vector<std::pair<DataValue*, uint64_t>> m_stringValues;
+
+    // nodes of the maps, which are extracted from old maps, so the key-strings and the nodes
+    // itself can be reused without allocating new ones
+    std::vector<std::map<std::string, DataItem*>::node_type> m_mapNodes;
+
+    std::vector<DataItem*> m_recycleStack;
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_NODE_POOL_H
@@ -0,0 +1,26 @@
+/**
+ *  @file    json_number_parser.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_NUMBER_PARSER_H
+#define JSON_NUMBER_PARSER_H
+
+#include <stdint.h>
+
+namespace Kitsunemimi
+{
+
+bool parseJsonInteger(const char* input,
+                      const uint64_t length,
+                      long &value);
+bool parseJsonDouble(const char* input,
+                     const uint64_t length,
+                     double &value);
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_NUMBER_PARSER_H
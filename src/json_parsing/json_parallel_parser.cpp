@@ -0,0 +1,300 @@
+/**
+ *  @file    json_parallel_parser.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <json_parsing/json_parallel_parser.h>
+#include <json_parsing/json_parser_interface.h>
+#include <json_parsing/json_simd_parser.h>
+
+#include <thread>
+
+#include <libKitsunemimiCommon/items/data_items.h>
+#include <libKitsunemimiJson/json_tree_handler.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief The class parses a json-string, which consists of one big array, with multiple threads.
+ *        The boundaries of the elements are taken from the structural index of the input,
+ *        afterwards each thread parses a continuous range of elements and at the end all
+ *        elements are added in the original order to one array.
+ */
+JsonParallelParser::JsonParallelParser()
+{
+    m_failed = false;
+}
+
+/**
+ * @brief destructor
+ */
+JsonParallelParser::~JsonParallelParser() {}
+
+/**
+ * @brief parse a top-level array with multiple threads
+ *
+ * @param input pointer to the string which should be parsed. It is never copied as a whole,
+ *              so it must be valid until the end of the parsing. Only the bison-parser copies
+ *              the elements in small parts into the buffer of its scanner.
+ * @param inputSize length of the string
+ * @param numberOfThreads number of threads (0 = number of available cpu-cores)
+ * @param parserType parser-engine, which is used for the elements
+ *
+ * @return nullptr, if the input is no array, too small for a parallel parsing or invalid,
+ *         else the resulting array
+ */
+DataItem*
+JsonParallelParser::parse(const char* input,
+                          const uint64_t inputSize,
+                          const uint32_t numberOfThreads,
+                          const JsonItem::parserTypes parserType)
+{
+    uint32_t threads = numberOfThreads;
+    if(threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+
+    if(threads <= 1
+            || inputSize < m_minInputSize
+            || findElements(input, inputSize) == false)
+    {
+        return nullptr;
+    }
+
+    const uint64_t numberOfElements = m_elements.size();
+    if(threads > numberOfElements) {
+        threads = static_cast<uint32_t>(numberOfElements);
+    }
+
+    m_items.assign(numberOfElements, nullptr);
+    m_failed = false;
+
+    // split the elements in ranges with nearly the same number of bytes
+    std::vector<std::thread> workers;
+    const uint64_t arraySize = m_elements.back().start + m_elements.back().length
+                               - m_elements.front().start;
+    uint64_t firstElement = 0;
+    for(uint32_t t = 0; t < threads; t++)
+    {
+        const uint64_t limit = m_elements.front().start + (arraySize * (t + 1)) / threads;
+        uint64_t lastElement = firstElement;
+        while(lastElement < numberOfElements
+              && (m_elements[lastElement].start < limit || lastElement == firstElement))
+        {
+            lastElement++;
+        }
+        if(t == threads - 1) {
+            lastElement = numberOfElements;
+        }
+
+        workers.emplace_back(&JsonParallelParser::parseElements,
+                             this,
+                             input,
+                             firstElement,
+                             lastElement,
+                             parserType);
+        firstElement = lastElement;
+    }
+
+    for(uint64_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+
+    // handle invalid element
+    if(m_failed)
+    {
+        for(uint64_t i = 0; i < m_items.size(); i++) {
+            delete m_items[i];
+        }
+        m_items.clear();
+        return nullptr;
+    }
+
+    // assemble all elements in the original order
+    DataArray* result = new DataArray();
+    result->array.reserve(numberOfElements);
+    for(uint64_t i = 0; i < numberOfElements; i++) {
+        result->append(m_items[i]);
+    }
+    m_items.clear();
+
+    return result;
+}
+
+/**
+ * @brief get the boundaries of all elements of the top-level array by the comma-positions
+ *        within the first level of the structural index
+ *
+ * @param input pointer to the input-string
+ * @param inputSize length of the input-string
+ *
+ * @return false, if the input is not an array with at least two elements or if the structure
+ *         of the first level is invalid, else true
+ */
+bool
+JsonParallelParser::findElements(const char* input,
+                                 const uint64_t inputSize)
+{
+    m_elements.clear();
+
+    if(m_index.build(input, inputSize) == false) {
+        return false;
+    }
+
+    const uint32_t* positions = m_index.getPositions();
+    const uint64_t numberOfPositions = m_index.size();
+    if(numberOfPositions < 2
+            || input[positions[0]] != '[')
+    {
+        return false;
+    }
+
+    uint64_t depth = 0;
+    uint64_t elementStart = positions[0] + 1;
+    uint64_t lastBoundary = 0;
+
+    for(uint64_t i = 0; i < numberOfPositions; i++)
+    {
+        const uint64_t position = positions[i];
+        switch(input[position])
+        {
+            case '"':
+                // skip the closing quote, because the index contains both quotes of a string
+                i++;
+                break;
+            case '[':
+            case '{':
+                depth++;
+                break;
+            case ']':
+            case '}':
+                depth--;
+                if(depth == 0)
+                {
+                    // the array must be closed by the last position of the index and the last
+                    // element must not be empty
+                    if(input[position] != ']'
+                            || i != numberOfPositions - 1
+                            || i == lastBoundary + 1)
+                    {
+                        m_elements.clear();
+                        return false;
+                    }
+
+                    Element element;
+                    element.start = elementStart;
+                    element.length = position - elementStart;
+                    m_elements.push_back(element);
+
+                    return m_elements.size() > 1;
+                }
+                break;
+            case ',':
+                if(depth == 1)
+                {
+                    // empty elements are not allowed
+                    if(i == lastBoundary + 1)
+                    {
+                        m_elements.clear();
+                        return false;
+                    }
+
+                    Element element;
+                    element.start = elementStart;
+                    element.length = position - elementStart;
+                    m_elements.push_back(element);
+
+                    elementStart = position + 1;
+                    lastBoundary = i;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    // array was not closed
+    m_elements.clear();
+
+    return false;
+}
+
+/**
+ * @brief parse a range of elements with a new instance of the requested parser
+ *
+ * @param input pointer to the input-string
+ * @param firstElement id of the first element of the range
+ * @param lastElement id behind the last element of the range
+ * @param parserType parser-engine, which is used for the elements
+ */
+void
+JsonParallelParser::parseElements(const char* input,
+                                  const uint64_t firstElement,
+                                  const uint64_t lastElement,
+                                  const JsonItem::parserTypes parserType)
+{
+    JsonItem::parserTypes usedParser = parserType;
+    if(usedParser == JsonItem::DEFAULT_PARSER)
+    {
+#ifdef JSON_SIMD_PARSER_DEFAULT
+        usedParser = JsonItem::SIMD_PARSER;
+#else
+        usedParser = JsonItem::BISON_PARSER;
+#endif
+    }
+
+    if(usedParser == JsonItem::SIMD_PARSER)
+    {
+        JsonSimdParser parser;
+        parseElementsWith(parser, input, firstElement, lastElement);
+    }
+    else
+    {
+        JsonParserInterface parser;
+        parseElementsWith(parser, input, firstElement, lastElement);
+    }
+}
+
+/**
+ * @brief parse a range of elements, where the parser-instance is reused for all elements
+ *
+ * @param parser parser-instance of the thread
+ * @param input pointer to the input-string
+ * @param firstElement id of the first element of the range
+ * @param lastElement id behind the last element of the range
+ */
+template <typename PARSER>
+void
+JsonParallelParser::parseElementsWith(PARSER &parser,
+                                      const char* input,
+                                      const uint64_t firstElement,
+                                      const uint64_t lastElement)
+{
+    JsonTreeHandler handler;
+
+    for(uint64_t i = firstElement; i < lastElement; i++)
+    {
+        // stop, if another thread has already found an invalid element
+        if(m_failed) {
+            return;
+        }
+
+        ErrorContainer error;
+        const Element &element = m_elements[i];
+        if(parser.parse(&input[element.start], element.length, handler, error) == false)
+        {
+            handler.reset();
+            m_failed = true;
+            return;
+        }
+
+        // null as element results in a nullptr like in the serial parser
+        m_items[i] = handler.stealResult();
+    }
+}
+
+}  // namespace Kitsunemimi
@@ -0,0 +1,64 @@
+/**
+ *  @file    json_parallel_parser.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_PARALLEL_PARSER_H
+#define JSON_PARALLEL_PARSER_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+
+#include <json_parsing/json_structural_index.h>
+#include <libKitsunemimiJson/json_item.h>
+
+namespace Kitsunemimi
+{
+class DataItem;
+
+class JsonParallelParser
+{
+public:
+    JsonParallelParser();
+    ~JsonParallelParser();
+
+    DataItem* parse(const char* input,
+                    const uint64_t inputSize,
+                    const uint32_t numberOfThreads,
+                    const JsonItem::parserTypes parserType);
+
+private:
+    struct Element
+    {
+        uint64_t start = 0;
+        uint64_t length = 0;
+    };
+
+    // inputs below this size are not worth to start additional threads
+    const uint64_t m_minInputSize = 64 * 1024;
+
+    JsonStructuralIndex m_index;
+    std::vector<Element> m_elements;
+    std::vector<DataItem*> m_items;
+    std::atomic<bool> m_failed;
+
+    bool findElements(const char* input,
+                      const uint64_t inputSize);
+    void parseElements(const char* input,
+                       const uint64_t firstElement,
+                       const uint64_t lastElement,
+                       const JsonItem::parserTypes parserType);
+    template <typename PARSER>
+    void parseElementsWith(PARSER &parser,
+                           const char* input,
+                           const uint64_t firstElement,
+                           const uint64_t lastElement);
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_PARALLEL_PARSER_H
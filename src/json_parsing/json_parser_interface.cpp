@@ -7,30 +7,27 @@
  */
 
 #include <json_parsing/json_parser_interface.h>
+#include <json_parsing/json_string_decoder.h>
 #include <json_parser.h>
 
-#include <libKitsunemimiCommon/methods/string_methods.h>
-#include <libKitsunemimiCommon/items/data_items.h>
+#include <string.h>
 
-using Kitsunemimi::DataItem;
-using Kitsunemimi::DataArray;
-using Kitsunemimi::DataValue;
-using Kitsunemimi::DataMap;
+#include <libKitsunemimiJson/json_handler.h>
 
 # define YY_DECL \
-    Kitsunemimi::JsonParser::symbol_type jsonlex (Kitsunemimi::JsonParserInterface& driver)
+    Kitsunemimi::JsonParser::symbol_type jsonlex (Kitsunemimi::JsonParserInterface& driver, \
+                                                  void* yyscanner)
 YY_DECL;
 
 namespace Kitsunemimi
 {
 
-Kitsunemimi::JsonParserInterface* JsonParserInterface::m_instance = nullptr;
-
-using Kitsunemimi::splitStringByDelimiter;
-
 /**
  * @brief The class is the interface for the bison-generated parser.
- *        It starts the parsing-process and store the returned values.
+ *        It starts the parsing-process and forwards the events of the parser to a handler. Each
+ *        instance has its own reentrant scanner, so multiple instances can parse in parallel
+ *        without any lock. The scanner and the parser are kept between the parse-calls, so an
+ *        instance, which is used multiple times, doesn't create them again for each input.
  *
  * @param traceParsing If set to true, the scanner prints all triggered rules.
  *                     It is only for better debugging.
@@ -40,119 +37,265 @@ JsonParserInterface::JsonParserInterface(const bool traceParsing)
     m_traceParsing = traceParsing;
 }
 
-/**
- * @brief static methode to get instance of the interface
- *
- * @return pointer to the static instance
- */
-JsonParserInterface*
-JsonParserInterface::getInstance()
-{
-    if(m_instance == nullptr) {
-        m_instance = new JsonParserInterface();
-    }
-
-    return m_instance;
-}
-
 /**
  * @brief destructor
  */
 JsonParserInterface::~JsonParserInterface()
 {
-    if(m_output != nullptr) {
-        delete m_output;
-    }
+    delete m_parser;
+    this->scan_end();
 }
 
 /**
  * @brief parse string
  *
- * @param inputString string which should be parsed
+ * @param input pointer to the string which should be parsed. It is only read and not copied,
+ *              so it must be valid until the end of the parsing.
+ * @param inputSize length of the string
+ * @param handler handler, which receives all events of the parser
  * @param reference for error-message
+ * @param strictMode true to reject strings with invalid escape-sequences, control characters
+ *                   or invalid utf-8
+ * @param keyPool optional pool to intern the keys, which are forwarded to the handler
  *
- * @return resulting object
+ * @return false, if the input is invalid or the handler has aborted, else true
  */
-DataItem*
-JsonParserInterface::parse(const std::string &inputString,
-                           ErrorContainer &error)
+bool
+JsonParserInterface::parse(const char* input,
+                           const uint64_t inputSize,
+                           JsonHandler &handler,
+                           ErrorContainer &error,
+                           const bool strictMode,
+                           JsonKeyPool* keyPool)
 {
-    DataItem* result = nullptr;
-
-    std::lock_guard<std::mutex> guard(m_lock);
-
     // init global values
-    m_inputString = inputString;
+    m_input = input;
+    m_inputSize = inputSize;
+    m_handler = &handler;
+    m_strictMode = strictMode;
+    m_keyCache.init(keyPool);
     m_errorMessage = "";
-    int parserResult = 0;
-    Kitsunemimi::JsonParser parser(*this);
 
-    // 1. dry-run to check syntax
-    dryRun = true;
-    this->scan_begin(inputString);
-    parserResult = parser.parse();
-    this->scan_end();
+    // parse the string and forward the events in the same run
+    this->scan_begin();
+    if(m_parser == nullptr) {
+        m_parser = new Kitsunemimi::JsonParser(*this, m_scanner);
+    }
+    const int parserResult = m_parser->parse();
+
+    m_handler = nullptr;
+
+    // add the statistics of this run to the key-pool and release it
+    m_keyCache.init(nullptr);
 
-    // handle negative result
+    // handle negative result, where errors of the scanner doesn't abort the parser
     if(parserResult != 0
             || m_errorMessage.size() > 0)
     {
         error.addMeesage(m_errorMessage);
         LOG_ERROR(error);
-        return nullptr;
+        return false;
     }
 
-    // 2. real run on the valid string
-    dryRun = false;
-    this->scan_begin(inputString);
-    parser.parse();
-    this->scan_end();
+    return true;
+}
 
-    result = m_output;
-    m_output = nullptr;
+/**
+ * @brief Is called from the scanner to get the next part of the input-string. Only this part is
+ *        copied into the buffer of the scanner, so the buffer has the same size independent of
+ *        the size of the input. Flex only grows its buffer for a single token, which is bigger
+ *        than the buffer, like a very long string or a long run of whitespaces.
+ *
+ * @param buffer buffer of the scanner, where the next part should be written into
+ * @param maxSize maximum number of bytes, which can be written into the buffer
+ *
+ * @return number of written bytes, which is 0 at the end of the input
+ */
+uint64_t
+JsonParserInterface::readInput(char* buffer,
+                               const uint64_t maxSize)
+{
+    uint64_t size = m_inputSize - m_readPosition;
+    if(size > maxSize) {
+        size = maxSize;
+    }
 
-    return result;
+    memcpy(buffer, &m_input[m_readPosition], size);
+    m_readPosition += size;
+
+    return size;
 }
 
 /**
- * @brief remove quotes at the beginning and end of a string
+ * @brief Is called from the scanner to decode the escape-sequences of a string
  *
- * @param input input-string
+ * @param input pointer to the content of the string without quotes
+ * @param length length of the content
+ * @param result reference for the decoded string
  *
- * @return cleared string
+ * @return false, if the string is invalid in the strict mode, else true
  */
-const std::string
-JsonParserInterface::removeQuotes(const std::string &input)
+bool
+JsonParserInterface::decodeString(const char* input,
+                                  const uint64_t length,
+                                  std::string &result)
 {
-    // precheck
-    if(input.length() == 0) {
-        return input;
+    uint64_t errorPosition = 0;
+    std::string errorMessage = "";
+    if(decodeJsonString(input, length, result, m_strictMode, errorPosition, errorMessage) == false)
+    {
+        error(location, errorMessage);
+        return false;
     }
 
-    // clear
-    if(input[0] == '\"'
-            && input[input.length()-1] == '\"')
-    {
-        std::string result = "";
-        for(uint32_t i = 1; i < input.length()-1; i++) {
-            result += input[i];
-        }
+    return true;
+}
+
+/**
+ * @brief Is called from the parser at the beginning of a map
+ *
+ * @return false, if the handler has aborted the parsing, else true
+ */
+bool
+JsonParserInterface::startObject()
+{
+    return checkHandlerResult(m_handler->startObject());
+}
 
-        return result;
+/**
+ * @brief Is called from the parser for the key of a key-value-pair. If a key-pool is set, the
+ *        handler gets the interned key instead.
+ *
+ * @param key key of the pair
+ *
+ * @return false, if the handler has aborted the parsing, else true
+ */
+bool
+JsonParserInterface::key(const std::string &key)
+{
+    const std::string* interned = m_keyCache.intern(key);
+    if(interned != nullptr) {
+        return checkHandlerResult(m_handler->key(*interned));
     }
 
-    return input;
+    return checkHandlerResult(m_handler->key(key));
 }
 
 /**
- * @brief Is called for the parser after successfully parsing the input-string
+ * @brief Is called from the parser at the end of a map
  *
- * @param output parser-output as data-item
+ * @return false, if the handler has aborted the parsing, else true
  */
-void
-JsonParserInterface::setOutput(DataItem* output)
+bool
+JsonParserInterface::endObject()
+{
+    return checkHandlerResult(m_handler->endObject());
+}
+
+/**
+ * @brief Is called from the parser at the beginning of an array
+ *
+ * @return false, if the handler has aborted the parsing, else true
+ */
+bool
+JsonParserInterface::startArray()
+{
+    return checkHandlerResult(m_handler->startArray());
+}
+
+/**
+ * @brief Is called from the parser at the end of an array
+ *
+ * @return false, if the handler has aborted the parsing, else true
+ */
+bool
+JsonParserInterface::endArray()
+{
+    return checkHandlerResult(m_handler->endArray());
+}
+
+/**
+ * @brief Is called from the parser for a string-value
+ *
+ * @param value value
+ *
+ * @return false, if the handler has aborted the parsing, else true
+ */
+bool
+JsonParserInterface::stringValue(const std::string &value)
+{
+    return checkHandlerResult(m_handler->stringValue(value));
+}
+
+/**
+ * @brief Is called from the parser for an integer-value
+ *
+ * @param value value
+ *
+ * @return false, if the handler has aborted the parsing, else true
+ */
+bool
+JsonParserInterface::integerValue(const long value)
+{
+    return checkHandlerResult(m_handler->integerValue(value));
+}
+
+/**
+ * @brief Is called from the parser for a floating-point-value
+ *
+ * @param value value
+ *
+ * @return false, if the handler has aborted the parsing, else true
+ */
+bool
+JsonParserInterface::doubleValue(const double value)
+{
+    return checkHandlerResult(m_handler->doubleValue(value));
+}
+
+/**
+ * @brief Is called from the parser for a bool-value
+ *
+ * @param value value
+ *
+ * @return false, if the handler has aborted the parsing, else true
+ */
+bool
+JsonParserInterface::boolValue(const bool value)
+{
+    return checkHandlerResult(m_handler->boolValue(value));
+}
+
+/**
+ * @brief Is called from the parser for null
+ *
+ * @return false, if the handler has aborted the parsing, else true
+ */
+bool
+JsonParserInterface::nullValue()
 {
-     m_output = output;
+    return checkHandlerResult(m_handler->nullValue());
+}
+
+/**
+ * @brief create an error-message, if the handler has aborted the parsing
+ *
+ * @param result result of the handler
+ *
+ * @return result of the handler
+ */
+bool
+JsonParserInterface::checkHandlerResult(const bool result)
+{
+    if(result == false
+            && m_errorMessage.size() == 0)
+    {
+        m_errorMessage = "ERROR while parsing json-formated string \n"
+                         "parser-message: parsing was aborted by the handler \n"
+                         "line-number: " + std::to_string(location.begin.line);
+    }
+
+    return result;
 }
 
 /**
@@ -176,19 +319,41 @@ JsonParserInterface::error(const Kitsunemimi::location& location,
     const uint32_t errorLength = location.end.column - location.begin.column;
     const uint32_t linenumber = location.begin.line;
 
-    std::vector<std::string> splittedContent;
-    splitStringByDelimiter(splittedContent, m_inputString, '\n');
+    // search the line of the error directly in the input
+    uint64_t lineStart = 0;
+    uint32_t currentLine = 1;
+    while(currentLine < linenumber
+          && lineStart < m_inputSize)
+    {
+        const void* lineBreak = memchr(&m_input[lineStart], '\n', m_inputSize - lineStart);
+        if(lineBreak == nullptr)
+        {
+            lineStart = m_inputSize;
+            break;
+        }
+
+        lineStart = static_cast<const char*>(lineBreak) - m_input + 1;
+        currentLine++;
+    }
+
+    uint64_t lineEnd = lineStart;
+    while(lineEnd < m_inputSize
+          && m_input[lineEnd] != '\n')
+    {
+        lineEnd++;
+    }
+    const uint64_t lineLength = lineEnd - lineStart;
 
     // build error-message
     m_errorMessage =  "ERROR while parsing json-formated string \n";
     m_errorMessage += "parser-message: " + message + " \n";
     m_errorMessage += "line-number: " + std::to_string(linenumber) + " \n";
 
-    if(splittedContent[linenumber - 1].size() > errorStart - 1 + errorLength)
+    if(lineLength > errorStart - 1 + errorLength)
     {
         m_errorMessage.append("position in line: " +  std::to_string(location.begin.column) + "\n");
         m_errorMessage.append("broken part in string: \""
-                              + splittedContent[linenumber - 1].substr(errorStart - 1, errorLength)
+                              + std::string(&m_input[lineStart + errorStart - 1], errorLength)
                               + "\"");
     }
     else
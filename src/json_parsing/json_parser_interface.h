@@ -10,46 +10,68 @@
 #define JSON_PARSER_INTERFACE_H
 
 #include <iostream>
-#include <mutex>
 
+#include <json_parser.h>
+#include <json_parsing/json_key_cache.h>
 #include <libKitsunemimiCommon/logger.h>
 
 namespace Kitsunemimi
 {
-class DataItem;
-class location;
+class JsonHandler;
+class JsonKeyPool;
 
 class JsonParserInterface
 {
 
 public:
-    static JsonParserInterface* getInstance();
+    JsonParserInterface(const bool traceParsing = false);
     ~JsonParserInterface();
 
     // connection the the scanner and parser
-    void scan_begin(const std::string &inputString);
+    void scan_begin();
     void scan_end();
-    DataItem* parse(const std::string &inputString, ErrorContainer &error);
-    const std::string removeQuotes(const std::string &input);
-
-    // output-handling
-    void setOutput(DataItem* output);
+    uint64_t readInput(char* buffer, const uint64_t maxSize);
+    bool parse(const char* input,
+               const uint64_t inputSize,
+               JsonHandler &handler,
+               ErrorContainer &error,
+               const bool strictMode = false,
+               JsonKeyPool* keyPool = nullptr);
+    bool decodeString(const char* input,
+                      const uint64_t length,
+                      std::string &result);
+
+    // forward events to the handler
+    bool startObject();
+    bool key(const std::string &key);
+    bool endObject();
+    bool startArray();
+    bool endArray();
+    bool stringValue(const std::string &value);
+    bool integerValue(const long value);
+    bool doubleValue(const double value);
+    bool boolValue(const bool value);
+    bool nullValue();
 
     // Error handling.
     void error(const Kitsunemimi::location &location,
                const std::string& message);
 
-    bool dryRun = false;
+    // location of the current token, which is updated by the scanner
+    Kitsunemimi::location location;
 
 private:
-    JsonParserInterface(const bool traceParsing = false);
-
-    static JsonParserInterface* m_instance;
+    bool checkHandlerResult(const bool result);
 
-    DataItem* m_output = nullptr;
+    JsonHandler* m_handler = nullptr;
     std::string m_errorMessage = "";
-    std::string m_inputString = "";
-    std::mutex m_lock;
+    const char* m_input = nullptr;
+    uint64_t m_inputSize = 0;
+    uint64_t m_readPosition = 0;
+    void* m_scanner = nullptr;
+    Kitsunemimi::JsonParser* m_parser = nullptr;
+    bool m_strictMode = false;
+    JsonKeyCache m_keyCache;
 
     bool m_traceParsing = false;
 };
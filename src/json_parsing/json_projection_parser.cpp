@@ -0,0 +1,465 @@
+/**
+ *  @file    json_projection_parser.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <json_parsing/json_projection_parser.h>
+#include <json_parsing/json_scalar_types.h>
+#include <json_parsing/json_string_decoder.h>
+
+#include <string.h>
+
+#include <libKitsunemimiCommon/items/data_items.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief The class parses only the parts of the input, which match with a set of paths. It walks
+ *        over the structural index of the input and jumps over all maps and arrays, which can
+ *        not match, by bracket- and quote-matching without creating any items. Only the matching
+ *        values are parsed completely into the resulting tree.
+ */
+JsonProjectionParser::JsonProjectionParser() {}
+
+/**
+ * @brief destructor
+ */
+JsonProjectionParser::~JsonProjectionParser() {}
+
+/**
+ * @brief parse the matching parts of a json-string
+ *
+ * @param input pointer to the string which should be parsed
+ * @param inputSize length of the string
+ * @param matcher compiled paths, which should be in the result
+ * @param result reference for the resulting tree, which contains only the matching paths. If
+ *               nothing matches, it is an empty map or array, based on the type of the input.
+ * @param error reference for error-message
+ *
+ * @return false, if the input is invalid, else true
+ */
+bool
+JsonProjectionParser::parse(const char* input,
+                            const uint64_t inputSize,
+                            const JsonPathMatcher &matcher,
+                            DataItem* &result,
+                            ErrorContainer &error)
+{
+    m_matcher = &matcher;
+    m_input = input;
+    m_inputSize = inputSize;
+    result = nullptr;
+
+    bool success = m_index.build(m_input, m_inputSize);
+    if(success)
+    {
+        m_positions = m_index.getPositions();
+        m_numberOfPositions = m_index.size();
+
+        // start with the root-node of the matcher
+        if(m_levels.size() == 0) {
+            m_levels.resize(1);
+        }
+        m_levels[0].clear();
+        m_levels[0].push_back(0);
+
+        // there must be nothing behind the first value
+        uint64_t index = 0;
+        success = parseValue(index, 0, result)
+                  && index == m_numberOfPositions;
+    }
+
+    if(success == false)
+    {
+        delete result;
+        result = nullptr;
+
+        // create the exact error-message with a complete check of the input
+        JsonHandler handler;
+        if(m_valueParser.parse(m_input, m_inputSize, handler, error))
+        {
+            error.addMeesage("ERROR while parsing json-formated string \n"
+                             "parser-message: syntax error");
+            LOG_ERROR(error);
+        }
+
+        return false;
+    }
+
+    // nothing matched
+    if(result == nullptr)
+    {
+        if(getChar(0) == '[') {
+            result = new DataArray();
+        } else {
+            result = new DataMap();
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief parse the value at the current position
+ *
+ * @param index reference to the current position in the structural index
+ * @param level depth of the value in the input
+ * @param result reference for the resulting item, which is nullptr, if nothing has matched
+ *
+ * @return false, if the input is invalid, else true
+ */
+bool
+JsonProjectionParser::parseValue(uint64_t &index,
+                                 const uint32_t level,
+                                 DataItem* &result)
+{
+    result = nullptr;
+
+    // complete value was requested
+    if(m_matcher->isEnd(m_levels[level])) {
+        return buildValue(index, result);
+    }
+
+    switch(getChar(index))
+    {
+        case '{':
+            return parseMap(index, level, result);
+        case '[':
+            return parseArray(index, level, result);
+        default:
+            // values can not contain any other matching path
+            return skipValue(index);
+    }
+}
+
+/**
+ * @brief parse the map at the current position
+ *
+ * @param index reference to the current position in the structural index
+ * @param level depth of the map in the input
+ * @param result reference for the resulting map, which is nullptr, if nothing has matched
+ *
+ * @return false, if the input is invalid, else true
+ */
+bool
+JsonProjectionParser::parseMap(uint64_t &index,
+                               const uint32_t level,
+                               DataItem* &result)
+{
+    index++;
+    if(getChar(index) == '}')
+    {
+        index++;
+        return true;
+    }
+
+    if(m_levels.size() <= level + 1) {
+        m_levels.resize(level + 2);
+    }
+
+    DataMap* map = nullptr;
+    while(true)
+    {
+        // get key
+        std::string_view key;
+        std::string decodedKey;
+        const char keyChar = getChar(index);
+        if(keyChar == '"')
+        {
+            const uint64_t start = m_positions[index] + 1;
+            key = std::string_view(&m_input[start], m_positions[index + 1] - start);
+            index += 2;
+
+            // keys with escape-sequences have to be decoded for the compare with the paths
+            if(memchr(key.data(), '\\', key.size()) != nullptr)
+            {
+                uint64_t errorPosition = 0;
+                std::string errorMessage;
+                decodeJsonString(key.data(), key.size(), decodedKey, false,
+                                 errorPosition, errorMessage);
+                key = decodedKey;
+            }
+        }
+        else if(isPlainJsonChar(keyChar))
+        {
+            const uint64_t start = m_positions[index];
+            key = std::string_view(&m_input[start], getScalarEnd(index) - start);
+            index++;
+        }
+        else
+        {
+            delete map;
+            return false;
+        }
+
+        if(getChar(index) != ':')
+        {
+            delete map;
+            return false;
+        }
+        index++;
+
+        // get value, if it can match with one of the paths, else skip it
+        m_matcher->getChildren(m_levels[level], key, m_levels[level + 1]);
+        DataItem* child = nullptr;
+        bool success = false;
+        if(m_levels[level + 1].size() == 0) {
+            success = skipValue(index);
+        } else {
+            success = parseValue(index, level + 1, child);
+        }
+
+        if(success == false)
+        {
+            delete map;
+            return false;
+        }
+
+        if(child != nullptr)
+        {
+            if(map == nullptr) {
+                map = new DataMap();
+            }
+
+            // keep the first value in case of a duplicate key
+            if(map->insert(std::string(key), child) == false) {
+                delete child;
+            }
+        }
+
+        // check for end of the map or the next key-value-pair
+        const char nextChar = getChar(index);
+        index++;
+        if(nextChar == '}') {
+            break;
+        }
+        if(nextChar != ',')
+        {
+            delete map;
+            return false;
+        }
+    }
+
+    result = map;
+
+    return true;
+}
+
+/**
+ * @brief parse the array at the current position
+ *
+ * @param index reference to the current position in the structural index
+ * @param level depth of the array in the input
+ * @param result reference for the resulting array, which contains only the matching elements
+ *               and is nullptr, if nothing has matched
+ *
+ * @return false, if the input is invalid, else true
+ */
+bool
+JsonProjectionParser::parseArray(uint64_t &index,
+                                 const uint32_t level,
+                                 DataItem* &result)
+{
+    index++;
+    if(getChar(index) == ']')
+    {
+        index++;
+        return true;
+    }
+
+    if(m_levels.size() <= level + 1) {
+        m_levels.resize(level + 2);
+    }
+
+    DataArray* array = nullptr;
+    for(uint64_t counter = 0; true; counter++)
+    {
+        // get value, if it can match with one of the paths, else skip it
+        const std::string key = std::to_string(counter);
+        m_matcher->getChildren(m_levels[level], key, m_levels[level + 1]);
+        DataItem* child = nullptr;
+        bool success = false;
+        if(m_levels[level + 1].size() == 0) {
+            success = skipValue(index);
+        } else {
+            success = parseValue(index, level + 1, child);
+        }
+
+        if(success == false)
+        {
+            delete array;
+            return false;
+        }
+
+        if(child != nullptr)
+        {
+            if(array == nullptr) {
+                array = new DataArray();
+            }
+            array->append(child);
+        }
+
+        // check for end of the array or the next value
+        const char nextChar = getChar(index);
+        index++;
+        if(nextChar == ']') {
+            break;
+        }
+        if(nextChar != ',')
+        {
+            delete array;
+            return false;
+        }
+    }
+
+    result = array;
+
+    return true;
+}
+
+/**
+ * @brief parse the complete value at the current position into a tree
+ *
+ * @param index reference to the current position in the structural index
+ * @param result reference for the resulting item, which is nullptr for a null-value
+ *
+ * @return false, if the input is invalid, else true
+ */
+bool
+JsonProjectionParser::buildValue(uint64_t &index,
+                                 DataItem* &result)
+{
+    const uint64_t start = m_positions[index];
+
+    // get end of the value
+    uint64_t end = 0;
+    const char c = getChar(index);
+    if(c == '{' || c == '[')
+    {
+        if(skipValue(index) == false) {
+            return false;
+        }
+        end = m_positions[index - 1] + 1;
+    }
+    else if(c == '"')
+    {
+        end = m_positions[index + 1] + 1;
+        index += 2;
+    }
+    else if(isPlainJsonChar(c))
+    {
+        end = getScalarEnd(index);
+        index++;
+    }
+    else
+    {
+        return false;
+    }
+
+    ErrorContainer error;
+    if(m_valueParser.parse(&m_input[start], end - start, m_treeHandler, error) == false)
+    {
+        m_treeHandler.reset();
+        return false;
+    }
+
+    result = m_treeHandler.stealResult();
+
+    return true;
+}
+
+/**
+ * @brief jump over the value at the current position, where maps and arrays are skipped by
+ *        bracket- and quote-matching without checking their content
+ *
+ * @param index reference to the current position in the structural index
+ *
+ * @return false, if the input is invalid, else true
+ */
+bool
+JsonProjectionParser::skipValue(uint64_t &index)
+{
+    switch(getChar(index))
+    {
+        case '"':
+            index += 2;
+            return true;
+        case '{':
+        case '[':
+        {
+            uint64_t depth = 0;
+            do
+            {
+                switch(getChar(index))
+                {
+                    case '\0':
+                        return false;
+                    case '"':
+                        // skip the closing quote, because the index contains both quotes
+                        index++;
+                        break;
+                    case '{':
+                    case '[':
+                        depth++;
+                        break;
+                    case '}':
+                    case ']':
+                        depth--;
+                        break;
+                    default:
+                        break;
+                }
+                index++;
+            }
+            while(depth > 0);
+
+            return true;
+        }
+        case '}':
+        case ']':
+        case ':':
+        case ',':
+        case '\0':
+            return false;
+        default:
+            index++;
+            return true;
+    }
+}
+
+/**
+ * @brief get character at a position of the structural index
+ *
+ * @param index position in the structural index
+ *
+ * @return character at the position or 0, if the end of the index was reached
+ */
+char
+JsonProjectionParser::getChar(const uint64_t index) const
+{
+    if(index >= m_numberOfPositions) {
+        return '\0';
+    }
+
+    return m_input[m_positions[index]];
+}
+
+/**
+ * @brief get the end of a value without quotes
+ *
+ * @param index position of the value in the structural index
+ *
+ * @return position behind the last character of the value in the input
+ */
+uint64_t
+JsonProjectionParser::getScalarEnd(const uint64_t index) const
+{
+    const uint64_t start = m_positions[index];
+    return start + getJsonScalarLength(&m_input[start], m_inputSize - start);
+}
+
+}  // namespace Kitsunemimi
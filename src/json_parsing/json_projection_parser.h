@@ -0,0 +1,69 @@
+/**
+ *  @file    json_projection_parser.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_PROJECTION_PARSER_H
+#define JSON_PROJECTION_PARSER_H
+
+#include <string>
+#include <vector>
+
+#include <json_parsing/json_structural_index.h>
+#include <json_parsing/json_simd_parser.h>
+#include <libKitsunemimiJson/json_path_matcher.h>
+#include <libKitsunemimiJson/json_tree_handler.h>
+#include <libKitsunemimiCommon/logger.h>
+
+namespace Kitsunemimi
+{
+class DataItem;
+
+class JsonProjectionParser
+{
+public:
+    JsonProjectionParser();
+    ~JsonProjectionParser();
+
+    bool parse(const char* input,
+               const uint64_t inputSize,
+               const JsonPathMatcher &matcher,
+               DataItem* &result,
+               ErrorContainer &error);
+
+private:
+    const JsonPathMatcher* m_matcher = nullptr;
+    const char* m_input = nullptr;
+    uint64_t m_inputSize = 0;
+    const uint32_t* m_positions = nullptr;
+    uint64_t m_numberOfPositions = 0;
+
+    JsonStructuralIndex m_index;
+    JsonSimdParser m_valueParser;
+    JsonTreeHandler m_treeHandler;
+
+    // sets of matching path-nodes, one for each level of the input
+    std::vector<std::vector<uint32_t>> m_levels;
+
+    bool parseValue(uint64_t &index,
+                    const uint32_t level,
+                    DataItem* &result);
+    bool parseMap(uint64_t &index,
+                  const uint32_t level,
+                  DataItem* &result);
+    bool parseArray(uint64_t &index,
+                    const uint32_t level,
+                    DataItem* &result);
+    bool buildValue(uint64_t &index,
+                    DataItem* &result);
+    bool skipValue(uint64_t &index);
+    char getChar(const uint64_t index) const;
+    uint64_t getScalarEnd(const uint64_t index) const;
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_PROJECTION_PARSER_H
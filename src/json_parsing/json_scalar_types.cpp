@@ -0,0 +1,159 @@
+/**
+ *  @file    json_scalar_types.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <json_parsing/json_scalar_types.h>
+
+#include <string.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief check if a character is allowed in a value without quotes, like identifiers and numbers
+ *
+ * @param c character to check
+ *
+ * @return true, if allowed, else false
+ */
+bool
+isPlainJsonChar(const char c)
+{
+    return (c >= 'a' && c <= 'z')
+           || (c >= 'A' && c <= 'Z')
+           || (c >= '0' && c <= '9')
+           || c == '_'
+           || c == '|'
+           || c == '-'
+           || c == '.';
+}
+
+/**
+ * @brief get type of an unquoted value with the same precedence like the rules of the lexer
+ *
+ * @param scalar pointer to the start of the value
+ * @param length length of the value
+ *
+ * @return type of the value
+ */
+jsonScalarTypes
+getJsonScalarType(const char* scalar,
+                  const uint64_t length)
+{
+    // keywords
+    if(length == 4 && strncmp(scalar, "true", 4) == 0) {
+        return TRUE_SCALAR;
+    }
+    if(length == 5 && strncmp(scalar, "false", 5) == 0) {
+        return FALSE_SCALAR;
+    }
+    if(length == 4 && strncmp(scalar, "null", 4) == 0) {
+        return NULL_SCALAR;
+    }
+
+    // numbers
+    uint64_t pos = 0;
+    if(length > 0 && scalar[pos] == '-') {
+        pos++;
+    }
+
+    const uint64_t intStart = pos;
+    while(pos < length && scalar[pos] >= '0' && scalar[pos] <= '9') {
+        pos++;
+    }
+    if(pos == intStart) {
+        return STRING_SCALAR;
+    }
+    if(pos == length) {
+        return LONG_SCALAR;
+    }
+
+    // fraction
+    if(scalar[pos] == '.')
+    {
+        pos++;
+        const uint64_t fractionStart = pos;
+        while(pos < length && scalar[pos] >= '0' && scalar[pos] <= '9') {
+            pos++;
+        }
+        if(pos == fractionStart) {
+            return STRING_SCALAR;
+        }
+    }
+
+    // exponent
+    if(pos < length
+            && (scalar[pos] == 'e' || scalar[pos] == 'E'))
+    {
+        pos++;
+        if(pos < length
+                && (scalar[pos] == '+' || scalar[pos] == '-'))
+        {
+            pos++;
+        }
+        const uint64_t exponentStart = pos;
+        while(pos < length && scalar[pos] >= '0' && scalar[pos] <= '9') {
+            pos++;
+        }
+        if(pos == exponentStart) {
+            return STRING_SCALAR;
+        }
+    }
+
+    if(pos != length) {
+        return STRING_SCALAR;
+    }
+
+    return DOUBLE_SCALAR;
+}
+
+/**
+ * @brief get the length of an unquoted value with the same longest match like the lexer. This
+ *        is the sequence of allowed characters, or a longer number, when its exponent has a
+ *        plus-sign, which is not allowed in other values.
+ *
+ * @param input pointer to the start of the value
+ * @param maxLength number of characters until the end of the input
+ *
+ * @return length of the value
+ */
+uint64_t
+getJsonScalarLength(const char* input,
+                    const uint64_t maxLength)
+{
+    uint64_t length = 0;
+    while(length < maxLength
+          && isPlainJsonChar(input[length]))
+    {
+        length++;
+    }
+
+    if(length == maxLength
+            || input[length] != '+'
+            || length == 0
+            || (input[length - 1] != 'e' && input[length - 1] != 'E'))
+    {
+        return length;
+    }
+
+    // check if the value with plus-sign and the digits behind is a number
+    uint64_t numberLength = length + 1;
+    while(numberLength < maxLength
+          && input[numberLength] >= '0'
+          && input[numberLength] <= '9')
+    {
+        numberLength++;
+    }
+
+    if(getJsonScalarType(input, numberLength) == DOUBLE_SCALAR) {
+        return numberLength;
+    }
+
+    return length;
+}
+
+}  // namespace Kitsunemimi
@@ -0,0 +1,35 @@
+/**
+ *  @file    json_scalar_types.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_SCALAR_TYPES_H
+#define JSON_SCALAR_TYPES_H
+
+#include <stdint.h>
+
+namespace Kitsunemimi
+{
+
+enum jsonScalarTypes
+{
+    STRING_SCALAR = 0,
+    LONG_SCALAR = 1,
+    DOUBLE_SCALAR = 2,
+    TRUE_SCALAR = 3,
+    FALSE_SCALAR = 4,
+    NULL_SCALAR = 5,
+};
+
+bool isPlainJsonChar(const char c);
+jsonScalarTypes getJsonScalarType(const char* scalar,
+                                  const uint64_t length);
+uint64_t getJsonScalarLength(const char* input,
+                             const uint64_t maxLength);
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_SCALAR_TYPES_H
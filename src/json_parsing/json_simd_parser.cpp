@@ -0,0 +1,603 @@
+/**
+ *  @file    json_simd_parser.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <json_parsing/json_simd_parser.h>
+#include <json_parsing/json_scalar_types.h>
+#include <json_parsing/json_number_parser.h>
+#include <json_parsing/json_string_decoder.h>
+
+#include <string.h>
+
+#include <libKitsunemimiJson/json_handler.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief lookup-table for the characters of identifiers, numbers and other unquoted values
+ */
+struct ScalarTable
+{
+    // true for all characters, which don't end an unquoted value
+    bool isScalar[256];
+
+    ScalarTable()
+    {
+        for(uint32_t i = 0; i < 256; i++)
+        {
+            const char c = static_cast<char>(i);
+            isScalar[i] = strchr("{}[]:,\" \t\n", c) == nullptr || c == '\0';
+        }
+    }
+};
+
+static const ScalarTable scalarTable;
+
+/**
+ * @brief The class is an alternative to the bison-generated parser. At first it creates an index
+ *        of all structural characters of the input with simd-instructions and afterwards it
+ *        forwards the same events like the bison-parser to a handler by only jumping over these
+ *        positions.
+ */
+JsonSimdParser::JsonSimdParser() {}
+
+/**
+ * @brief destructor
+ */
+JsonSimdParser::~JsonSimdParser() {}
+
+/**
+ * @brief parse string
+ *
+ * @param input pointer to the string which should be parsed. It is read in place and not
+ *              copied, so it must be valid until the end of the parsing.
+ * @param inputSize length of the string
+ * @param handler handler, which receives all events of the parser
+ * @param reference for error-message
+ * @param strictMode true to reject strings with invalid escape-sequences, control characters
+ *                   or invalid utf-8
+ * @param keyPool optional pool to intern the keys, which are forwarded to the handler
+ *
+ * @return false, if the input is invalid or the handler has aborted, else true
+ */
+bool
+JsonSimdParser::parse(const char* input,
+                      const uint64_t inputSize,
+                      JsonHandler &handler,
+                      ErrorContainer &error,
+                      const bool strictMode,
+                      JsonKeyPool* keyPool)
+{
+    // init global values
+    m_input = input;
+    m_inputSize = inputSize;
+    m_handler = &handler;
+    m_current = 0;
+    m_strictMode = strictMode;
+    m_keyCache.init(keyPool);
+    m_errorMessage = "";
+
+    // create index of all structural characters
+    if(m_index.build(m_input, m_inputSize) == false)
+    {
+        if(m_inputSize >= 0xFFFFFFFFULL) {
+            m_errorMessage = "ERROR while parsing json-formated string \n"
+                             "input is too big for the simd-parser";
+        } else {
+            setError(m_index.getUnclosedQuote(), m_inputSize, "string was not closed");
+        }
+
+        error.addMeesage(m_errorMessage);
+        LOG_ERROR(error);
+        return false;
+    }
+    m_positions = m_index.getPositions();
+    m_numberOfPositions = m_index.size();
+
+    // forward the content to the handler
+    bool success = parseValue();
+
+    // there must be nothing behind the first value
+    if(success
+            && m_current != m_numberOfPositions)
+    {
+        syntaxError();
+        success = false;
+    }
+
+    m_handler = nullptr;
+
+    // add the statistics of this run to the key-pool and release it
+    m_keyCache.init(nullptr);
+
+    // handle negative result
+    if(success == false)
+    {
+        error.addMeesage(m_errorMessage);
+        LOG_ERROR(error);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief get the structural index of the last parsed input, which stays valid until the next
+ *        call of the parse-function
+ *
+ * @return reference to the structural index
+ */
+const JsonStructuralIndex&
+JsonSimdParser::getIndex() const
+{
+    return m_index;
+}
+
+/**
+ * @brief parse a value at the current position, which can be a map, array or single value.
+ *        Maps and arrays are not parsed with a recursion, but with a stack of all open ones, so
+ *        like in the bison-parser the depth of the input is only limited by the memory and not
+ *        by the size of the call-stack.
+ *
+ * @return false, if input is invalid or the handler has aborted, else true
+ */
+bool
+JsonSimdParser::parseValue()
+{
+    m_stack.clear();
+
+    do
+    {
+        // go down, as long as the values open new maps or arrays
+        bool opened = true;
+        while(opened)
+        {
+            if(openValue(opened) == false) {
+                return false;
+            }
+        }
+
+        // go up, as long as the maps or arrays are closed behind the value
+        bool closed = true;
+        while(closed
+                && m_stack.size() > 0)
+        {
+            if(closeContainer(closed) == false) {
+                return false;
+            }
+        }
+    }
+    while(m_stack.size() > 0);
+
+    return true;
+}
+
+/**
+ * @brief parse the value at the current position. A map or array with content is only opened
+ *        and pushed on the stack, where for a map the first key is already parsed.
+ *
+ * @param opened reference for the result, which is true, if a map or array was opened
+ *
+ * @return false, if input is invalid or the handler has aborted, else true
+ */
+bool
+JsonSimdParser::openValue(bool &opened)
+{
+    opened = false;
+
+    switch(currentChar())
+    {
+        case '{':
+        case '[':
+        {
+            StackEntry entry;
+            entry.start = m_positions[m_current];
+            entry.isMap = currentChar() == '{';
+            m_current++;
+
+            const bool result = entry.isMap ? m_handler->startObject() : m_handler->startArray();
+            if(checkHandlerResult(result, entry.start) == false) {
+                return false;
+            }
+
+            // handle empty map or array
+            if(currentChar() == (entry.isMap ? '}' : ']'))
+            {
+                m_current++;
+                return finishContainer(entry);
+            }
+
+            m_stack.push_back(entry);
+            opened = true;
+
+            if(entry.isMap) {
+                return parsePairStart();
+            }
+            return true;
+        }
+        case '"':
+        {
+            const uint64_t start = m_positions[m_current];
+            if(decodeString() == false) {
+                return false;
+            }
+            return checkHandlerResult(m_handler->stringValue(m_stringBuffer), start);
+        }
+        case '}':
+        case ']':
+        case ':':
+        case ',':
+        case '\0':
+            syntaxError();
+            return false;
+        default:
+            return parseScalar();
+    }
+}
+
+/**
+ * @brief check the character behind a value within the last open map or array, which can close
+ *        it or separate the value from the next one
+ *
+ * @param closed reference for the result, which is true, if the map or array was closed
+ *
+ * @return false, if input is invalid or the handler has aborted, else true
+ */
+bool
+JsonSimdParser::closeContainer(bool &closed)
+{
+    const StackEntry entry = m_stack.back();
+    const char nextChar = currentChar();
+    closed = false;
+
+    // check for end of the map or array
+    if(nextChar == (entry.isMap ? '}' : ']'))
+    {
+        m_current++;
+        m_stack.pop_back();
+        closed = true;
+        return finishContainer(entry);
+    }
+
+    // check for the next value or key-value-pair
+    if(nextChar != ',')
+    {
+        syntaxError();
+        return false;
+    }
+    m_current++;
+
+    if(entry.isMap) {
+        return parsePairStart();
+    }
+    return true;
+}
+
+/**
+ * @brief forward the end of a map or array to the handler
+ *
+ * @param entry closed map or array
+ *
+ * @return false, if the handler has aborted, else true
+ */
+bool
+JsonSimdParser::finishContainer(const StackEntry &entry)
+{
+    const bool result = entry.isMap ? m_handler->endObject() : m_handler->endArray();
+    return checkHandlerResult(result, entry.start);
+}
+
+/**
+ * @brief parse the key of a key-value-pair and the following colon
+ *
+ * @return false, if input is invalid or the handler has aborted, else true
+ */
+bool
+JsonSimdParser::parsePairStart()
+{
+    if(parseKey() == false) {
+        return false;
+    }
+
+    if(currentChar() != ':')
+    {
+        syntaxError();
+        return false;
+    }
+    m_current++;
+
+    return true;
+}
+
+/**
+ * @brief parse key of a key-value-pair, which can be a string or an identifier without quotes
+ *
+ * @return false, if input is invalid or the handler has aborted, else true
+ */
+bool
+JsonSimdParser::parseKey()
+{
+    const char c = currentChar();
+
+    // quoted key
+    if(c == '"')
+    {
+        const uint64_t start = m_positions[m_current];
+        if(decodeString() == false) {
+            return false;
+        }
+        return forwardKey(start);
+    }
+
+    if(c == '{'
+            || c == '}'
+            || c == '['
+            || c == ']'
+            || c == ':'
+            || c == ','
+            || c == '\0')
+    {
+        syntaxError();
+        return false;
+    }
+
+    // key without quotes, which is not allowed to be a number or keyword
+    uint64_t start = 0;
+    uint64_t length = 0;
+    if(getScalar(start, length) == false) {
+        return false;
+    }
+
+    if(getJsonScalarType(&m_input[start], length) != STRING_SCALAR)
+    {
+        syntaxError();
+        return false;
+    }
+
+    m_current++;
+    m_stringBuffer.assign(&m_input[start], length);
+
+    return forwardKey(start);
+}
+
+/**
+ * @brief forward the key within the string-buffer to the handler. If a key-pool is set, the
+ *        handler gets the interned key instead.
+ *
+ * @param position position of the key within the input for the error-message
+ *
+ * @return false, if the handler has aborted, else true
+ */
+bool
+JsonSimdParser::forwardKey(const uint64_t position)
+{
+    const std::string* interned = m_keyCache.intern(m_stringBuffer);
+    if(interned != nullptr) {
+        return checkHandlerResult(m_handler->key(*interned), position);
+    }
+
+    return checkHandlerResult(m_handler->key(m_stringBuffer), position);
+}
+
+/**
+ * @brief parse a value without quotes at the current position
+ *
+ * @return false, if input is invalid or the handler has aborted, else true
+ */
+bool
+JsonSimdParser::parseScalar()
+{
+    uint64_t start = 0;
+    uint64_t length = 0;
+    if(getScalar(start, length) == false) {
+        return false;
+    }
+
+    m_current++;
+
+    bool result = true;
+    const char* scalar = &m_input[start];
+    switch(getJsonScalarType(scalar, length))
+    {
+        case TRUE_SCALAR:
+            result = m_handler->boolValue(true);
+            break;
+        case FALSE_SCALAR:
+            result = m_handler->boolValue(false);
+            break;
+        case NULL_SCALAR:
+            result = m_handler->nullValue();
+            break;
+        case LONG_SCALAR:
+        {
+            long value = 0;
+            if(parseJsonInteger(scalar, length, value) == false)
+            {
+                setError(start, length, "integer is out of range");
+                return false;
+            }
+            result = m_handler->integerValue(value);
+            break;
+        }
+        case DOUBLE_SCALAR:
+        {
+            double value = 0.0;
+            if(parseJsonDouble(scalar, length, value) == false)
+            {
+                setError(start, length, "float is out of range");
+                return false;
+            }
+            result = m_handler->doubleValue(value);
+            break;
+        }
+        default:
+            result = m_handler->stringValue(std::string(scalar, length));
+            break;
+    }
+
+    return checkHandlerResult(result, start);
+}
+
+/**
+ * @brief decode the string at the current position into the string-buffer
+ *
+ * @return false, if the string is invalid in the strict mode, else true
+ */
+bool
+JsonSimdParser::decodeString()
+{
+    const uint64_t start = m_positions[m_current] + 1;
+    const uint64_t end = m_positions[m_current + 1];
+    m_current += 2;
+
+    uint64_t errorPosition = 0;
+    std::string errorMessage = "";
+    if(decodeJsonString(&m_input[start],
+                        end - start,
+                        m_stringBuffer,
+                        m_strictMode,
+                        errorPosition,
+                        errorMessage) == false)
+    {
+        setError(start + errorPosition, 1, errorMessage);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief create an error-message, if the handler has aborted the parsing
+ *
+ * @param result result of the handler
+ * @param position position of the current value in the input-string
+ *
+ * @return result of the handler
+ */
+bool
+JsonSimdParser::checkHandlerResult(const bool result,
+                                   const uint64_t position)
+{
+    if(result == false) {
+        setError(position, 1, "parsing was aborted by the handler");
+    }
+
+    return result;
+}
+
+/**
+ * @brief get character at the current position of the index
+ *
+ * @return character at the current position or 0, if the end of the index was reached
+ */
+char
+JsonSimdParser::currentChar() const
+{
+    if(m_current >= m_numberOfPositions) {
+        return '\0';
+    }
+
+    return m_input[m_positions[m_current]];
+}
+
+/**
+ * @brief get the boundaries of the unquoted value at the current position and check if it
+ *        contains only valid characters
+ *
+ * @param start reference for the start-position of the value
+ * @param length reference for the length of the value
+ *
+ * @return false, if the value contains an invalid character, else true
+ */
+bool
+JsonSimdParser::getScalar(uint64_t &start,
+                          uint64_t &length)
+{
+    start = m_positions[m_current];
+    length = getJsonScalarLength(&m_input[start], m_inputSize - start);
+
+    // the value must be followed by a whitespace or structural character
+    const uint64_t end = start + length;
+    if(end < m_inputSize
+            && scalarTable.isScalar[static_cast<uint8_t>(m_input[end])])
+    {
+        setError(end, 1, "invalid character");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief create syntax-error for the token at the current position
+ */
+void
+JsonSimdParser::syntaxError()
+{
+    if(m_current >= m_numberOfPositions)
+    {
+        setError(m_inputSize, 1, "syntax error");
+        return;
+    }
+
+    setError(m_positions[m_current], 1, "syntax error");
+}
+
+/**
+ * @brief create an error-message in the same format like the bison-parser
+ *
+ * @param position position of the error in the input-string
+ * @param length length of the broken part in the input-string
+ * @param message error-specific message
+ */
+void
+JsonSimdParser::setError(const uint64_t position,
+                         const uint64_t length,
+                         const std::string &message)
+{
+    if(m_errorMessage.size() > 0) {
+        return;
+    }
+
+    // get line-number and the line of the error
+    uint64_t lineNumber = 1;
+    uint64_t lineStart = 0;
+    for(uint64_t i = 0; i < position && i < m_inputSize; i++)
+    {
+        if(m_input[i] == '\n')
+        {
+            lineNumber++;
+            lineStart = i + 1;
+        }
+    }
+
+    uint64_t lineEnd = lineStart;
+    while(lineEnd < m_inputSize && m_input[lineEnd] != '\n') {
+        lineEnd++;
+    }
+
+    // build error-message
+    m_errorMessage =  "ERROR while parsing json-formated string \n";
+    m_errorMessage += "parser-message: " + message + " \n";
+    m_errorMessage += "line-number: " + std::to_string(lineNumber) + " \n";
+
+    if(position + length <= lineEnd)
+    {
+        m_errorMessage.append("position in line: "
+                              + std::to_string(position - lineStart + 1) + "\n");
+        m_errorMessage.append("broken part in string: \""
+                              + std::string(&m_input[position], length)
+                              + "\"");
+    }
+    else
+    {
+        m_errorMessage.append("position in line: UNKNOWN POSITION (maybe a string was not closed)");
+    }
+}
+
+}  // namespace Kitsunemimi
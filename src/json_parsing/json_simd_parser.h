@@ -0,0 +1,84 @@
+/**
+ *  @file    json_simd_parser.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_SIMD_PARSER_H
+#define JSON_SIMD_PARSER_H
+
+#include <string>
+#include <vector>
+
+#include <json_parsing/json_structural_index.h>
+#include <json_parsing/json_key_cache.h>
+#include <libKitsunemimiCommon/logger.h>
+
+namespace Kitsunemimi
+{
+class JsonHandler;
+class JsonKeyPool;
+
+class JsonSimdParser
+{
+public:
+    JsonSimdParser();
+    ~JsonSimdParser();
+
+    bool parse(const char* input,
+               const uint64_t inputSize,
+               JsonHandler &handler,
+               ErrorContainer &error,
+               const bool strictMode = false,
+               JsonKeyPool* keyPool = nullptr);
+
+    const JsonStructuralIndex& getIndex() const;
+
+private:
+    struct StackEntry
+    {
+        // position of the opening bracket in the input
+        uint64_t start = 0;
+        bool isMap = false;
+    };
+
+    JsonStructuralIndex m_index;
+    JsonHandler* m_handler = nullptr;
+    const char* m_input = nullptr;
+    uint64_t m_inputSize = 0;
+    const uint32_t* m_positions = nullptr;
+    uint64_t m_numberOfPositions = 0;
+    uint64_t m_current = 0;
+    bool m_strictMode = false;
+    JsonKeyCache m_keyCache;
+    std::vector<StackEntry> m_stack;
+    std::string m_stringBuffer = "";
+    std::string m_errorMessage = "";
+
+    bool parseValue();
+    bool openValue(bool &opened);
+    bool closeContainer(bool &closed);
+    bool finishContainer(const StackEntry &entry);
+    bool parsePairStart();
+    bool parseKey();
+    bool parseScalar();
+    bool decodeString();
+    bool forwardKey(const uint64_t position);
+    bool checkHandlerResult(const bool result,
+                            const uint64_t position);
+
+    char currentChar() const;
+    bool getScalar(uint64_t &start,
+                   uint64_t &length);
+
+    void syntaxError();
+    void setError(const uint64_t position,
+                  const uint64_t length,
+                  const std::string &message);
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_SIMD_PARSER_H
@@ -0,0 +1,471 @@
+/**
+ *  @file    json_string_decoder.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <json_parsing/json_string_decoder.h>
+#include <json_parsing/json_structural_index.h>
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define JSON_X86_SIMD
+#endif
+
+#if defined(__SSE2__)
+#define JSON_SSE2_DECODER
+#endif
+
+namespace Kitsunemimi
+{
+
+#ifdef JSON_X86_SIMD
+
+/**
+ * @brief check the full 32-byte blocks of the content with avx2 for the next special character
+ *
+ * @param input pointer to the content of the string
+ * @param position in: position, where the search starts, out: position of the special
+ *                 character or of the first byte, which was not checked
+ * @param length length of the content
+ * @param strictMode true, if the strict mode is active
+ *
+ * @return true, if a special character was found, else false
+ */
+__attribute__((target("avx2"))) static bool
+findSpecialCharAvx2(const char* input,
+                    uint64_t &position,
+                    const uint64_t length,
+                    const bool strictMode)
+{
+    const __m256i backslashes = _mm256_set1_epi8('\\');
+    const __m256i limits = _mm256_set1_epi8(strictMode ? 0x20 : -128);
+    while(position + 32 <= length)
+    {
+        const __m256i block = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(&input[position]));
+        const __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(block, backslashes),
+                                                _mm256_cmpgt_epi8(limits, block));
+        const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+        if(mask != 0)
+        {
+            position += static_cast<uint64_t>(__builtin_ctz(mask));
+            return true;
+        }
+
+        position += 32;
+    }
+
+    return false;
+}
+
+#endif
+
+/**
+ * @brief find the next character, which can not be copied unchecked into the result. In the
+ *        normal mode this is only the backslash. In the strict mode additionally all control
+ *        characters and all bytes of multi-byte utf-8 characters have to be checked. In the
+ *        normal mode the limit of the signed compare is the lowest value, so it never matches.
+ *        It uses the same cpu-check like the structural index of the simd-parser, so with avx2
+ *        the full 32-byte blocks are checked at first and only the rest with sse2.
+ *
+ * @param input pointer to the content of the string
+ * @param position position, where the search starts
+ * @param length length of the content
+ * @param strictMode true, if the strict mode is active
+ * @param useAvx2 true, if the cpu supports avx2
+ *
+ * @return position of the next special character or the length, if there is none
+ */
+static inline uint64_t
+findSpecialChar(const char* input,
+                uint64_t position,
+                const uint64_t length,
+                const bool strictMode,
+                const bool useAvx2)
+{
+#ifdef JSON_X86_SIMD
+    if(useAvx2
+            && findSpecialCharAvx2(input, position, length, strictMode))
+    {
+        return position;
+    }
+#else
+    (void)useAvx2;
+#endif
+
+#ifdef JSON_SSE2_DECODER
+    // check 16 bytes at once, where the signed compare with 0x20 matches all control
+    // characters and all bytes above 0x7f at the same time
+    const __m128i backslashes = _mm_set1_epi8('\\');
+    const __m128i limits = _mm_set1_epi8(strictMode ? 0x20 : -128);
+    while(position + 16 <= length)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[position]));
+        const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(block, backslashes),
+                                             _mm_cmplt_epi8(block, limits));
+        const int mask = _mm_movemask_epi8(special);
+        if(mask != 0) {
+            return position + static_cast<uint64_t>(__builtin_ctz(static_cast<uint32_t>(mask)));
+        }
+
+        position += 16;
+    }
+
+    // check the rest with the last 16 bytes of the input, where the already checked bytes
+    // are removed from the mask
+    if(position < length
+            && length >= 16)
+    {
+        const uint64_t blockStart = length - 16;
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[blockStart]));
+        const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(block, backslashes),
+                                             _mm_cmplt_epi8(block, limits));
+        const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special))
+                              >> (position - blockStart);
+        if(mask != 0) {
+            return position + static_cast<uint64_t>(__builtin_ctz(mask));
+        }
+
+        return length;
+    }
+#endif
+
+    while(position < length)
+    {
+        const uint8_t c = static_cast<uint8_t>(input[position]);
+        if(c == '\\'
+                || (strictMode && (c < 0x20 || c > 0x7f)))
+        {
+            return position;
+        }
+
+        position++;
+    }
+
+    return length;
+}
+
+/**
+ * @brief get the length of a valid utf-8 character, which starts with a byte above 0x7f
+ *
+ * @param input pointer to the first byte of the character
+ * @param length number of available bytes
+ *
+ * @return 0, if the character is invalid, overlong, a surrogate or above U+10FFFF,
+ *         else the number of bytes of the character
+ */
+static inline uint64_t
+getUtf8Length(const uint8_t* input,
+              const uint64_t length)
+{
+    const uint8_t first = input[0];
+    uint64_t size = 0;
+    uint8_t min = 0x80;
+    uint8_t max = 0xbf;
+
+    if(first >= 0xc2 && first <= 0xdf) {
+        size = 2;
+    } else if(first == 0xe0) {
+        size = 3;
+        min = 0xa0;
+    } else if(first == 0xed) {
+        size = 3;
+        max = 0x9f;
+    } else if(first >= 0xe1 && first <= 0xef) {
+        size = 3;
+    } else if(first == 0xf0) {
+        size = 4;
+        min = 0x90;
+    } else if(first == 0xf4) {
+        size = 4;
+        max = 0x8f;
+    } else if(first >= 0xf1 && first <= 0xf3) {
+        size = 4;
+    } else {
+        return 0;
+    }
+
+    if(size > length) {
+        return 0;
+    }
+
+    // the second byte has the restricted range to exclude overlong forms and surrogates
+    if(input[1] < min || input[1] > max) {
+        return 0;
+    }
+
+    for(uint64_t i = 2; i < size; i++)
+    {
+        if(input[i] < 0x80 || input[i] > 0xbf) {
+            return 0;
+        }
+    }
+
+    return size;
+}
+
+/**
+ * @brief read the four hex-digits of an unicode-escape-sequence
+ *
+ * @param input pointer to the first hex-digit
+ * @param codePoint reference for the result
+ *
+ * @return false, if one of the characters is no hex-digit, else true
+ */
+static inline bool
+readHex4(const char* input,
+         uint32_t &codePoint)
+{
+    codePoint = 0;
+    for(uint32_t i = 0; i < 4; i++)
+    {
+        const char c = input[i];
+        uint32_t digit = 0;
+        if(c >= '0' && c <= '9') {
+            digit = static_cast<uint32_t>(c - '0');
+        } else if(c >= 'a' && c <= 'f') {
+            digit = static_cast<uint32_t>(c - 'a' + 10);
+        } else if(c >= 'A' && c <= 'F') {
+            digit = static_cast<uint32_t>(c - 'A' + 10);
+        } else {
+            return false;
+        }
+
+        codePoint = (codePoint << 4) | digit;
+    }
+
+    return true;
+}
+
+/**
+ * @brief write an unicode code-point as utf-8 into the output-buffer
+ *
+ * @param codePoint code-point to write
+ * @param output output-buffer
+ * @param outputPosition in: position, where the character should be written,
+ *                       out: position behind the character
+ */
+static inline void
+writeUtf8(const uint32_t codePoint,
+          char* output,
+          uint64_t &outputPosition)
+{
+    if(codePoint < 0x80)
+    {
+        output[outputPosition++] = static_cast<char>(codePoint);
+    }
+    else if(codePoint < 0x800)
+    {
+        output[outputPosition++] = static_cast<char>(0xc0 | (codePoint >> 6));
+        output[outputPosition++] = static_cast<char>(0x80 | (codePoint & 0x3f));
+    }
+    else if(codePoint < 0x10000)
+    {
+        output[outputPosition++] = static_cast<char>(0xe0 | (codePoint >> 12));
+        output[outputPosition++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+        output[outputPosition++] = static_cast<char>(0x80 | (codePoint & 0x3f));
+    }
+    else
+    {
+        output[outputPosition++] = static_cast<char>(0xf0 | (codePoint >> 18));
+        output[outputPosition++] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f));
+        output[outputPosition++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+        output[outputPosition++] = static_cast<char>(0x80 | (codePoint & 0x3f));
+    }
+}
+
+/**
+ * @brief decode the escape-sequence at the current position
+ *
+ * @param input pointer to the content of the string
+ * @param position in: position of the backslash, out: position behind the sequence
+ * @param length length of the content
+ * @param output output-buffer for the decoded character
+ * @param outputPosition in: position, where the character should be written,
+ *                       out: position behind the character
+ *
+ * @return false, if the escape-sequence is invalid, else true
+ */
+static inline bool
+decodeEscape(const char* input,
+             uint64_t &position,
+             const uint64_t length,
+             char* output,
+             uint64_t &outputPosition)
+{
+    if(position + 1 >= length) {
+        return false;
+    }
+
+    switch(input[position + 1])
+    {
+        case '"':
+            output[outputPosition] = '"';
+            break;
+        case '\\':
+            output[outputPosition] = '\\';
+            break;
+        case '/':
+            output[outputPosition] = '/';
+            break;
+        case 'b':
+            output[outputPosition] = '\b';
+            break;
+        case 'f':
+            output[outputPosition] = '\f';
+            break;
+        case 'n':
+            output[outputPosition] = '\n';
+            break;
+        case 'r':
+            output[outputPosition] = '\r';
+            break;
+        case 't':
+            output[outputPosition] = '\t';
+            break;
+        case 'u':
+        {
+            uint32_t codePoint = 0;
+            if(position + 6 > length
+                    || readHex4(&input[position + 2], codePoint) == false)
+            {
+                return false;
+            }
+
+            // a low surrogate is only valid behind a high surrogate
+            if(codePoint >= 0xdc00 && codePoint <= 0xdfff) {
+                return false;
+            }
+
+            // a high surrogate must be followed by a low surrogate
+            if(codePoint >= 0xd800 && codePoint <= 0xdbff)
+            {
+                uint32_t lowSurrogate = 0;
+                if(position + 12 > length
+                        || input[position + 6] != '\\'
+                        || input[position + 7] != 'u'
+                        || readHex4(&input[position + 8], lowSurrogate) == false
+                        || lowSurrogate < 0xdc00
+                        || lowSurrogate > 0xdfff)
+                {
+                    return false;
+                }
+
+                codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (lowSurrogate - 0xdc00);
+                position += 6;
+            }
+
+            writeUtf8(codePoint, output, outputPosition);
+            position += 6;
+            return true;
+        }
+        default:
+            return false;
+    }
+
+    outputPosition++;
+    position += 2;
+
+    return true;
+}
+
+/**
+ * @brief decode the content of a json-string. All runs without escape-sequences are copied at
+ *        once into the result and all escape-sequences, including surrogate-pairs, are decoded
+ *        to utf-8. The decoded string is never longer than the input, so the result is resized
+ *        only once in front of the decoding and once at the end. In the normal mode invalid
+ *        escape-sequences and invalid utf-8 are copied unchanged. In the strict mode they are
+ *        rejected together with control characters.
+ *
+ * @param input pointer to the content of the string without the quotes
+ * @param length length of the content
+ * @param result reference for the decoded string
+ * @param strictMode true to reject invalid input
+ * @param errorPosition reference for the position of the invalid part within the content
+ * @param errorMessage reference for the description of the invalid part
+ *
+ * @return false, if the strict mode is active and the content is invalid, else true
+ */
+bool
+decodeJsonString(const char* input,
+                 const uint64_t length,
+                 std::string &result,
+                 const bool strictMode,
+                 uint64_t &errorPosition,
+                 std::string &errorMessage)
+{
+    result.resize(length);
+    char* output = &result[0];
+    uint64_t outputPosition = 0;
+
+    // short strings are never checked with avx2, so they don't need the cpu-check
+    const bool useAvx2 = length >= 32
+                         && JsonStructuralIndex::getCpuType() == JsonStructuralIndex::AVX2_CPU;
+
+    uint64_t position = 0;
+    while(position < length)
+    {
+        const uint64_t specialPosition = findSpecialChar(input,
+                                                         position,
+                                                         length,
+                                                         strictMode,
+                                                         useAvx2);
+        memcpy(&output[outputPosition], &input[position], specialPosition - position);
+        outputPosition += specialPosition - position;
+        position = specialPosition;
+        if(position >= length) {
+            break;
+        }
+
+        const uint8_t c = static_cast<uint8_t>(input[position]);
+        if(c == '\\')
+        {
+            if(decodeEscape(input, position, length, output, outputPosition)) {
+                continue;
+            }
+
+            if(strictMode)
+            {
+                errorPosition = position;
+                errorMessage = "invalid escape-sequence in string";
+                return false;
+            }
+
+            // keep the invalid sequence unchanged
+            output[outputPosition++] = '\\';
+            position++;
+        }
+        else if(c < 0x20)
+        {
+            errorPosition = position;
+            errorMessage = "control character in string";
+            return false;
+        }
+        else
+        {
+            const uint64_t size = getUtf8Length(reinterpret_cast<const uint8_t*>(&input[position]),
+                                                length - position);
+            if(size == 0)
+            {
+                errorPosition = position;
+                errorMessage = "invalid utf-8 character in string";
+                return false;
+            }
+
+            memcpy(&output[outputPosition], &input[position], size);
+            outputPosition += size;
+            position += size;
+        }
+    }
+
+    result.resize(outputPosition);
+
+    return true;
+}
+
+}  // namespace Kitsunemimi
@@ -0,0 +1,27 @@
+/**
+ *  @file    json_string_decoder.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_STRING_DECODER_H
+#define JSON_STRING_DECODER_H
+
+#include <stdint.h>
+#include <string>
+
+namespace Kitsunemimi
+{
+
+bool decodeJsonString(const char* input,
+                      const uint64_t length,
+                      std::string &result,
+                      const bool strictMode,
+                      uint64_t &errorPosition,
+                      std::string &errorMessage);
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_STRING_DECODER_H
@@ -0,0 +1,533 @@
+/**
+ *  @file    json_structural_index.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <json_parsing/json_structural_index.h>
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define JSON_X86_SIMD
+#endif
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief bit-masks of one 64-byte block of the input, where each bit stands for one character
+ */
+struct BlockMasks
+{
+    uint64_t quote = 0;
+    uint64_t backslash = 0;
+    uint64_t op = 0;
+    uint64_t whitespace = 0;
+};
+
+/**
+ * @brief state, which has to be carried from one block to the next
+ */
+struct BlockState
+{
+    uint64_t prevEscaped = 0;
+    uint64_t prevInString = 0;
+    uint64_t prevScalar = 0;
+    uint64_t lastQuote = 0;
+};
+
+enum charClasses
+{
+    OTHER_CHAR = 0,
+    QUOTE_CHAR = 1,
+    BACKSLASH_CHAR = 2,
+    OP_CHAR = 3,
+    WHITESPACE_CHAR = 4,
+};
+
+/**
+ * @brief create lookup-table for the scalar classification of the characters
+ */
+struct CharTable
+{
+    uint8_t classes[256];
+
+    CharTable()
+    {
+        memset(classes, OTHER_CHAR, 256);
+        classes[static_cast<uint8_t>('"')] = QUOTE_CHAR;
+        classes[static_cast<uint8_t>('\\')] = BACKSLASH_CHAR;
+        classes[static_cast<uint8_t>('{')] = OP_CHAR;
+        classes[static_cast<uint8_t>('}')] = OP_CHAR;
+        classes[static_cast<uint8_t>('[')] = OP_CHAR;
+        classes[static_cast<uint8_t>(']')] = OP_CHAR;
+        classes[static_cast<uint8_t>(':')] = OP_CHAR;
+        classes[static_cast<uint8_t>(',')] = OP_CHAR;
+        classes[static_cast<uint8_t>(' ')] = WHITESPACE_CHAR;
+        classes[static_cast<uint8_t>('\t')] = WHITESPACE_CHAR;
+        classes[static_cast<uint8_t>('\n')] = WHITESPACE_CHAR;
+    }
+};
+
+static const CharTable charTable;
+
+/**
+ * @brief classify the characters of a block without any simd-instructions
+ *
+ * @param block pointer to the 64 bytes of the block
+ * @param masks reference for the resulting bit-masks
+ */
+static inline void
+classifyScalar(const uint8_t* block,
+               BlockMasks &masks)
+{
+    uint64_t maskArray[5] = {0, 0, 0, 0, 0};
+    for(uint32_t i = 0; i < 64; i++) {
+        maskArray[charTable.classes[block[i]]] |= 1ULL << i;
+    }
+
+    masks.quote = maskArray[QUOTE_CHAR];
+    masks.backslash = maskArray[BACKSLASH_CHAR];
+    masks.op = maskArray[OP_CHAR];
+    masks.whitespace = maskArray[WHITESPACE_CHAR];
+}
+
+#ifdef JSON_X86_SIMD
+
+/**
+ * @brief get bit-mask of all positions of a specific character within 64 bytes with avx2
+ */
+__attribute__((target("avx2"))) static inline uint64_t
+eqMaskAvx2(const __m256i &lo,
+           const __m256i &hi,
+           const char c)
+{
+    const __m256i value = _mm256_set1_epi8(c);
+    const uint64_t loMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, value)));
+    const uint64_t hiMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, value)));
+    return loMask | (hiMask << 32);
+}
+
+/**
+ * @brief classify the characters of a block with avx2
+ *
+ * @param block pointer to the 64 bytes of the block
+ * @param masks reference for the resulting bit-masks
+ */
+__attribute__((target("avx2"))) static inline void
+classifyAvx2(const uint8_t* block,
+             BlockMasks &masks)
+{
+    const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+
+    masks.quote = eqMaskAvx2(lo, hi, '"');
+    masks.backslash = eqMaskAvx2(lo, hi, '\\');
+    masks.op = eqMaskAvx2(lo, hi, '{')
+               | eqMaskAvx2(lo, hi, '}')
+               | eqMaskAvx2(lo, hi, '[')
+               | eqMaskAvx2(lo, hi, ']')
+               | eqMaskAvx2(lo, hi, ':')
+               | eqMaskAvx2(lo, hi, ',');
+    masks.whitespace = eqMaskAvx2(lo, hi, ' ')
+                       | eqMaskAvx2(lo, hi, '\t')
+                       | eqMaskAvx2(lo, hi, '\n');
+}
+
+/**
+ * @brief classify the characters of a block with sse4.2, where the string-compare-instruction
+ *        checks each 16 bytes against the whole set of structural and whitespace characters
+ *
+ * @param block pointer to the 64 bytes of the block
+ * @param masks reference for the resulting bit-masks
+ */
+__attribute__((target("sse4.2"))) static inline void
+classifySse42(const uint8_t* block,
+              BlockMasks &masks)
+{
+    const __m128i opSet = _mm_setr_epi8('{', '}', '[', ']', ':', ',', 0, 0,
+                                        0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i whitespaceSet = _mm_setr_epi8(' ', '\t', '\n', 0, 0, 0, 0, 0,
+                                                0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const int mode = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK;
+
+    masks = BlockMasks();
+    for(uint32_t i = 0; i < 4; i++)
+    {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 16));
+        const uint32_t shift = i * 16;
+
+        const uint64_t op = _mm_cvtsi128_si32(_mm_cmpestrm(opSet, 6, data, 16, mode)) & 0xFFFF;
+        const uint64_t ws = _mm_cvtsi128_si32(_mm_cmpestrm(whitespaceSet, 3, data, 16, mode))
+                            & 0xFFFF;
+        const uint64_t q = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, quote)));
+        const uint64_t bs = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(data,
+                                                                                   backslash)));
+
+        masks.op |= op << shift;
+        masks.whitespace |= ws << shift;
+        masks.quote |= q << shift;
+        masks.backslash |= bs << shift;
+    }
+}
+
+#endif
+
+/**
+ * @brief find all characters, which are escaped by an odd number of backslashes in front of them
+ *
+ * @param backslash bit-mask of all backslashes of the block
+ * @param prevEscaped in: 1, if the first character is escaped by the last block,
+ *                    out: 1, if the first character of the next block is escaped
+ *
+ * @return bit-mask of all escaped characters
+ */
+static inline uint64_t
+findEscaped(uint64_t backslash,
+            uint64_t &prevEscaped)
+{
+    const uint64_t evenBits = 0x5555555555555555ULL;
+
+    // a backslash, which is escaped by the last block, doesn't escape anything
+    backslash &= ~prevEscaped;
+    const uint64_t followsEscape = (backslash << 1) | prevEscaped;
+
+    // get the sequences, which start on an even bit, by letting the odd sequences overflow
+    const uint64_t oddSequenceStarts = backslash & ~evenBits & ~followsEscape;
+    const uint64_t sequencesOnEvenBits = oddSequenceStarts + backslash;
+    prevEscaped = sequencesOnEvenBits < oddSequenceStarts;
+    const uint64_t invertMask = sequencesOnEvenBits << 1;
+
+    return (evenBits ^ invertMask) & followsEscape;
+}
+
+/**
+ * @brief calculate for each bit the xor of itself and all bits below, which converts the
+ *        positions of the quotes into a mask of all characters between them
+ */
+static inline uint64_t
+prefixXor(uint64_t bits)
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+/**
+ * @brief convert the masks of a block into the positions of the structural characters
+ *
+ * @param masks classified characters of the block
+ * @param state state of the last block, which is updated for the next block
+ * @param offset position of the block within the input
+ * @param positions output-buffer for the positions
+ * @param size in: number of already written positions, out: new number of positions
+ */
+static inline void
+indexBlock(const BlockMasks &masks,
+           BlockState &state,
+           const uint64_t offset,
+           uint32_t* positions,
+           uint64_t &size)
+{
+    const uint64_t escaped = findEscaped(masks.backslash, state.prevEscaped);
+    const uint64_t quotes = masks.quote & ~escaped;
+    if(quotes != 0) {
+        state.lastQuote = offset + 63 - static_cast<uint64_t>(__builtin_clzll(quotes));
+    }
+
+    // mask of all characters within strings, inclusive the opening quotes
+    const uint64_t inString = prefixXor(quotes) ^ state.prevInString;
+    state.prevInString = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+
+    // all other characters outside of the strings are parts of identifiers, numbers, etc.,
+    // where only the first character of each sequence is relevant
+    const uint64_t op = masks.op & ~inString;
+    const uint64_t scalar = ~(masks.op | masks.whitespace | quotes | inString);
+    const uint64_t scalarStarts = scalar & ~((scalar << 1) | state.prevScalar);
+    state.prevScalar = scalar >> 63;
+
+    uint64_t structurals = op | quotes | scalarStarts;
+    while(structurals != 0)
+    {
+        positions[size] = static_cast<uint32_t>(offset + __builtin_ctzll(structurals));
+        size++;
+        structurals &= structurals - 1;
+    }
+}
+
+/**
+ * @brief copy the incomplete last block into a buffer, which is filled up with whitespaces
+ */
+static inline void
+fillLastBlock(const uint8_t* input,
+              const uint64_t inputSize,
+              const uint64_t offset,
+              uint8_t* lastBlock)
+{
+    memset(lastBlock, ' ', 64);
+    memcpy(lastBlock, input + offset, inputSize - offset);
+}
+
+/**
+ * @brief index all blocks of a part of the input without simd-instructions
+ *
+ * @param input pointer to the input
+ * @param offset start of the part, which must be a multiple of 64
+ * @param end end of the part, which can only be within a block at the end of the input
+ * @param state state of the blocks before the part
+ * @param positions output-buffer for the positions
+ * @param size in: number of already written positions, out: new number of positions
+ */
+static void
+indexScalar(const uint8_t* input,
+            uint64_t offset,
+            const uint64_t end,
+            BlockState &state,
+            uint32_t* positions,
+            uint64_t &size)
+{
+    BlockMasks masks;
+    for(; offset + 64 <= end; offset += 64)
+    {
+        classifyScalar(input + offset, masks);
+        indexBlock(masks, state, offset, positions, size);
+    }
+
+    if(offset < end)
+    {
+        uint8_t lastBlock[64];
+        fillLastBlock(input, end, offset, lastBlock);
+        classifyScalar(lastBlock, masks);
+        indexBlock(masks, state, offset, positions, size);
+    }
+}
+
+#ifdef JSON_X86_SIMD
+
+/**
+ * @brief index all blocks of a part of the input with avx2
+ */
+__attribute__((target("avx2"))) static void
+indexAvx2(const uint8_t* input,
+          uint64_t offset,
+          const uint64_t end,
+          BlockState &state,
+          uint32_t* positions,
+          uint64_t &size)
+{
+    BlockMasks masks;
+    for(; offset + 64 <= end; offset += 64)
+    {
+        classifyAvx2(input + offset, masks);
+        indexBlock(masks, state, offset, positions, size);
+    }
+
+    if(offset < end)
+    {
+        uint8_t lastBlock[64];
+        fillLastBlock(input, end, offset, lastBlock);
+        classifyAvx2(lastBlock, masks);
+        indexBlock(masks, state, offset, positions, size);
+    }
+}
+
+/**
+ * @brief index all blocks of a part of the input with sse4.2
+ */
+__attribute__((target("sse4.2"))) static void
+indexSse42(const uint8_t* input,
+           uint64_t offset,
+           const uint64_t end,
+           BlockState &state,
+           uint32_t* positions,
+           uint64_t &size)
+{
+    BlockMasks masks;
+    for(; offset + 64 <= end; offset += 64)
+    {
+        classifySse42(input + offset, masks);
+        indexBlock(masks, state, offset, positions, size);
+    }
+
+    if(offset < end)
+    {
+        uint8_t lastBlock[64];
+        fillLastBlock(input, end, offset, lastBlock);
+        classifySse42(lastBlock, masks);
+        indexBlock(masks, state, offset, positions, size);
+    }
+}
+
+#endif
+
+/**
+ * @brief constructor
+ */
+JsonStructuralIndex::JsonStructuralIndex() {}
+
+/**
+ * @brief destructor
+ */
+JsonStructuralIndex::~JsonStructuralIndex()
+{
+    delete[] m_positions;
+}
+
+/**
+ * @brief create the index of all structural characters of the input. These are the characters
+ *        {}[]:, outside of strings, all not escaped quotes and the first character of each
+ *        identifier, number, etc. The input is processed in blocks of 64 bytes.
+ *
+ * @param input pointer to the input-string
+ * @param inputSize length of the input-string
+ *
+ * @return false, if a string was not closed or the input is too big, else true
+ */
+bool
+JsonStructuralIndex::build(const char* input,
+                           const uint64_t inputSize)
+{
+    m_size = 0;
+    m_unclosedQuote = 0;
+
+    // positions are stored as 32-bit values
+    if(inputSize >= 0xFFFFFFFFULL) {
+        return false;
+    }
+
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(input);
+    const cpuTypes cpuType = getCpuType();
+    BlockState state;
+
+    // the input is processed in chunks, because each character can be a structural character
+    // at worst. So the buffer only has to be big enough for the next chunk and grows with the
+    // number of found positions instead of the size of the input.
+    uint64_t offset = 0;
+    while(offset < inputSize)
+    {
+        uint64_t end = offset + m_chunkSize;
+        if(end > inputSize) {
+            end = inputSize;
+        }
+
+        reserve(m_size + (end - offset) + 64);
+
+        switch(cpuType)
+        {
+#ifdef JSON_X86_SIMD
+            case AVX2_CPU:
+                indexAvx2(data, offset, end, state, m_positions, m_size);
+                break;
+            case SSE42_CPU:
+                indexSse42(data, offset, end, state, m_positions, m_size);
+                break;
+#endif
+            default:
+                indexScalar(data, offset, end, state, m_positions, m_size);
+                break;
+        }
+
+        offset = end;
+    }
+
+    // check if the last string was closed
+    if(state.prevInString != 0)
+    {
+        m_unclosedQuote = state.lastQuote;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief get positions of all structural characters
+ */
+const uint32_t*
+JsonStructuralIndex::getPositions() const
+{
+    return m_positions;
+}
+
+/**
+ * @brief get number of indexed structural characters
+ */
+uint64_t
+JsonStructuralIndex::size() const
+{
+    return m_size;
+}
+
+/**
+ * @brief get position of the quote of the not closed string, if the build has failed
+ */
+uint64_t
+JsonStructuralIndex::getUnclosedQuote() const
+{
+    return m_unclosedQuote;
+}
+
+/**
+ * @brief check once, which simd-instructions are supported by the cpu
+ *
+ * @return best supported instruction-set for the index
+ */
+JsonStructuralIndex::cpuTypes
+JsonStructuralIndex::getCpuType()
+{
+#ifdef JSON_X86_SIMD
+    static const cpuTypes cpuType = []() {
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2")) {
+            return AVX2_CPU;
+        }
+        if(__builtin_cpu_supports("sse4.2")) {
+            return SSE42_CPU;
+        }
+        return SCALAR_CPU;
+    }();
+    return cpuType;
+#else
+    return SCALAR_CPU;
+#endif
+}
+
+/**
+ * @brief make sure, that the buffer for the positions is big enough. Already written positions
+ *        are kept.
+ *
+ * @param minCapacity minimum number of positions, which must be storable
+ */
+void
+JsonStructuralIndex::reserve(const uint64_t minCapacity)
+{
+    if(m_capacity >= minCapacity) {
+        return;
+    }
+
+    uint64_t newCapacity = m_capacity * 2;
+    if(newCapacity < minCapacity) {
+        newCapacity = minCapacity;
+    }
+
+    uint32_t* newPositions = new uint32_t[newCapacity];
+    if(m_size > 0) {
+        memcpy(newPositions, m_positions, m_size * sizeof(uint32_t));
+    }
+
+    delete[] m_positions;
+    m_positions = newPositions;
+    m_capacity = newCapacity;
+}
+
+}  // namespace Kitsunemimi
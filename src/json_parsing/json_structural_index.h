@@ -0,0 +1,54 @@
+/**
+ *  @file    json_structural_index.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_STRUCTURAL_INDEX_H
+#define JSON_STRUCTURAL_INDEX_H
+
+#include <stdint.h>
+#include <string>
+
+namespace Kitsunemimi
+{
+
+class JsonStructuralIndex
+{
+public:
+    enum cpuTypes
+    {
+        SCALAR_CPU = 0,
+        SSE42_CPU = 1,
+        AVX2_CPU = 2,
+    };
+
+    JsonStructuralIndex();
+    ~JsonStructuralIndex();
+
+    bool build(const char* input,
+               const uint64_t inputSize);
+
+    const uint32_t* getPositions() const;
+    uint64_t size() const;
+    uint64_t getUnclosedQuote() const;
+
+    static cpuTypes getCpuType();
+
+private:
+    void reserve(const uint64_t minCapacity);
+
+    // number of input-bytes, which are indexed at once, must be a multiple of 64
+    const uint64_t m_chunkSize = 64 * 1024;
+
+    uint32_t* m_positions = nullptr;
+    uint64_t m_size = 0;
+    uint64_t m_capacity = 0;
+    uint64_t m_unclosedQuote = 0;
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_STRUCTURAL_INDEX_H
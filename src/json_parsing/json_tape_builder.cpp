@@ -0,0 +1,394 @@
+/**
+ *  @file    json_tape_builder.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <json_parsing/json_tape_builder.h>
+
+#include <algorithm>
+#include <string.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief Handler, which writes the events of a parser as words on a tape. Maps and arrays
+ *        are written as start-word, content and end-word, where the start-word contains the
+ *        position of the end-word, so a whole subtree can be skipped at once. Numbers use a
+ *        second word for their raw value and strings are stored in a separate buffer as
+ *        32-bit length, content and a terminating zero. The positions of the elements of all
+ *        arrays are stored in an additional index, so an element can be accessed directly.
+ *        Big maps get an open-addressing hash-table over the positions of their keys, so a
+ *        key can be found without comparing it with all other keys of the map.
+ *
+ * @param tape reference to the tape, where the words should be appended
+ * @param strings reference to the buffer, where the strings should be appended
+ * @param arrayIndex reference to the index, where the positions of the array-elements should
+ *                   be appended
+ * @param mapIndex reference to the index, where the hash-tables of big maps should be appended
+ */
+JsonTapeBuilder::JsonTapeBuilder(std::vector<uint64_t> &tape,
+                                 std::string &strings,
+                                 std::vector<uint32_t> &arrayIndex,
+                                 std::vector<uint32_t> &mapIndex)
+{
+    init(tape, strings, arrayIndex, mapIndex);
+}
+
+/**
+ * @brief destructor
+ */
+JsonTapeBuilder::~JsonTapeBuilder() {}
+
+/**
+ * @brief set the buffers for the next tape and drop the state of the previous one. The internal
+ *        stacks keep their memory, so a builder, which is used for multiple inputs, doesn't
+ *        have to allocate them again.
+ *
+ * @param tape reference to the tape, where the words should be appended
+ * @param strings reference to the buffer, where the strings should be appended
+ * @param arrayIndex reference to the index, where the positions of the array-elements should
+ *                   be appended
+ * @param mapIndex reference to the index, where the hash-tables of big maps should be appended
+ */
+void
+JsonTapeBuilder::init(std::vector<uint64_t> &tape,
+                      std::string &strings,
+                      std::vector<uint32_t> &arrayIndex,
+                      std::vector<uint32_t> &mapIndex)
+{
+    m_tape = &tape;
+    m_strings = &strings;
+    m_arrayIndex = &arrayIndex;
+    m_mapIndex = &mapIndex;
+
+    m_stack.clear();
+    m_keyPositions.clear();
+    m_elementPositions.clear();
+    m_keyBuffer.clear();
+}
+
+/**
+ * @brief write the start-word of a map, which is updated, when the map is closed
+ */
+bool
+JsonTapeBuilder::startObject()
+{
+    addElement();
+
+    StackEntry entry;
+    entry.start = m_tape->size();
+    entry.first = m_keyPositions.size();
+    m_stack.push_back(entry);
+
+    m_tape->push_back(createTapeWord(TAPE_MAP_START, 0));
+
+    return true;
+}
+
+/**
+ * @brief write the key of the next value of the current map
+ */
+bool
+JsonTapeBuilder::key(const std::string &key)
+{
+    m_keyPositions.push_back(static_cast<uint32_t>(m_tape->size()));
+    m_tape->push_back(createTapeWord(TAPE_STRING, addString(key)));
+    m_stack.back().count++;
+
+    return true;
+}
+
+/**
+ * @brief close the current map. Duplicate keys stay on the tape, but are not counted and not
+ *        added to the hash-table, so the size of the map and the result of a search is the same
+ *        like in the tree, where only the first one is added.
+ */
+bool
+JsonTapeBuilder::endObject()
+{
+    if(m_stack.size() == 0) {
+        return false;
+    }
+
+    const StackEntry &entry = m_stack.back();
+    const uint64_t firstKey = entry.first;
+    uint64_t numberOfKeys = entry.count;
+    uint64_t endPayload = 0;
+
+    if(numberOfKeys >= tapeHashThreshold) {
+        endPayload = addHashTable(firstKey, numberOfKeys) + 1;
+    } else if(numberOfKeys > 1) {
+        numberOfKeys = countUniqueKeys(firstKey);
+    }
+
+    m_keyPositions.resize(firstKey);
+
+    return endContainer(TAPE_MAP_END, numberOfKeys, endPayload);
+}
+
+/**
+ * @brief write the start-word of an array, which is updated, when the array is closed
+ */
+bool
+JsonTapeBuilder::startArray()
+{
+    addElement();
+
+    StackEntry entry;
+    entry.start = m_tape->size();
+    entry.first = m_elementPositions.size();
+    m_stack.push_back(entry);
+
+    m_tape->push_back(createTapeWord(TAPE_ARRAY_START, 0));
+
+    return true;
+}
+
+/**
+ * @brief close the current array and move the number and positions of its elements into the
+ *        array-index
+ */
+bool
+JsonTapeBuilder::endArray()
+{
+    if(m_stack.size() == 0) {
+        return false;
+    }
+
+    const StackEntry &entry = m_stack.back();
+    const uint64_t count = entry.count;
+    const uint64_t indexOffset = m_arrayIndex->size();
+
+    m_arrayIndex->push_back(static_cast<uint32_t>(count));
+    m_arrayIndex->insert(m_arrayIndex->end(),
+                        m_elementPositions.begin() + entry.first,
+                        m_elementPositions.end());
+    m_elementPositions.resize(entry.first);
+
+    return endContainer(TAPE_ARRAY_END, count, indexOffset);
+}
+
+/**
+ * @brief write a string-value
+ */
+bool
+JsonTapeBuilder::stringValue(const std::string &value)
+{
+    addElement();
+    m_tape->push_back(createTapeWord(TAPE_STRING, addString(value)));
+
+    return true;
+}
+
+/**
+ * @brief write an integer-value as tag-word and raw value
+ */
+bool
+JsonTapeBuilder::integerValue(const long value)
+{
+    addElement();
+    m_tape->push_back(createTapeWord(TAPE_LONG, 0));
+    m_tape->push_back(static_cast<uint64_t>(value));
+
+    return true;
+}
+
+/**
+ * @brief write a floating-point-value as tag-word and raw value
+ */
+bool
+JsonTapeBuilder::doubleValue(const double value)
+{
+    addElement();
+    m_tape->push_back(createTapeWord(TAPE_DOUBLE, 0));
+
+    uint64_t raw = 0;
+    memcpy(&raw, &value, sizeof(double));
+    m_tape->push_back(raw);
+
+    return true;
+}
+
+/**
+ * @brief write a bool-value
+ */
+bool
+JsonTapeBuilder::boolValue(const bool value)
+{
+    addElement();
+    m_tape->push_back(createTapeWord(value ? TAPE_TRUE : TAPE_FALSE, 0));
+
+    return true;
+}
+
+/**
+ * @brief write a null-value
+ */
+bool
+JsonTapeBuilder::nullValue()
+{
+    addElement();
+    m_tape->push_back(createTapeWord(TAPE_NULL, 0));
+
+    return true;
+}
+
+/**
+ * @brief get a string from the string-buffer
+ *
+ * @param strings string-buffer of the tape
+ * @param offset position of the string within the buffer
+ *
+ * @return view on the string within the buffer
+ */
+std::string_view
+JsonTapeBuilder::getString(const char* strings,
+                           const uint64_t offset)
+{
+    uint32_t length = 0;
+    memcpy(&length, &strings[offset], sizeof(uint32_t));
+
+    return std::string_view(&strings[offset + sizeof(uint32_t)], length);
+}
+
+/**
+ * @brief count a new value and remember its position, if the current container is an array.
+ *        Within maps the keys are counted instead.
+ */
+void
+JsonTapeBuilder::addElement()
+{
+    if(m_stack.size() > 0
+            && getTapeTag((*m_tape)[m_stack.back().start]) == TAPE_ARRAY_START)
+    {
+        m_stack.back().count++;
+        m_elementPositions.push_back(static_cast<uint32_t>(m_tape->size()));
+    }
+}
+
+/**
+ * @brief append a string to the string-buffer
+ *
+ * @param value string to append
+ *
+ * @return position of the string within the buffer
+ */
+uint64_t
+JsonTapeBuilder::addString(const std::string &value)
+{
+    const uint64_t offset = m_strings->size();
+    const uint32_t length = static_cast<uint32_t>(value.size());
+
+    m_strings->append(reinterpret_cast<const char*>(&length), sizeof(uint32_t));
+    m_strings->append(value.c_str(), value.size() + 1);
+
+    return offset;
+}
+
+/**
+ * @brief count the different keys of a small map
+ *
+ * @param firstKey position of the first key of the map within the key-stack
+ *
+ * @return number of keys without duplicates
+ */
+uint64_t
+JsonTapeBuilder::countUniqueKeys(const uint64_t firstKey)
+{
+    m_keyBuffer.clear();
+    for(uint64_t i = firstKey; i < m_keyPositions.size(); i++)
+    {
+        const uint64_t offset = getTapePayload((*m_tape)[m_keyPositions[i]]);
+        m_keyBuffer.push_back(getString(m_strings->data(), offset));
+    }
+
+    std::sort(m_keyBuffer.begin(), m_keyBuffer.end());
+
+    return std::unique(m_keyBuffer.begin(), m_keyBuffer.end()) - m_keyBuffer.begin();
+}
+
+/**
+ * @brief create the hash-table of a big map with linear probing. The table has at least twice
+ *        as many slots as keys, so the probe-sequences stay short.
+ *
+ * @param firstKey position of the first key of the map within the key-stack
+ * @param numberOfKeys reference to the number of keys, which is reduced by the number of
+ *                     duplicate keys
+ *
+ * @return position of the hash-table within the map-index
+ */
+uint64_t
+JsonTapeBuilder::addHashTable(const uint64_t firstKey,
+                              uint64_t &numberOfKeys)
+{
+    uint64_t numberOfSlots = 1;
+    while(numberOfSlots < numberOfKeys * 2) {
+        numberOfSlots *= 2;
+    }
+
+    const uint64_t tableOffset = m_mapIndex->size();
+    m_mapIndex->push_back(static_cast<uint32_t>(numberOfSlots));
+    m_mapIndex->resize(tableOffset + 1 + numberOfSlots, 0);
+    uint32_t* slots = &(*m_mapIndex)[tableOffset + 1];
+
+    numberOfKeys = 0;
+    for(uint64_t i = firstKey; i < m_keyPositions.size(); i++)
+    {
+        const uint32_t position = m_keyPositions[i];
+        const std::string_view key = getString(m_strings->data(),
+                                               getTapePayload((*m_tape)[position]));
+
+        uint64_t slot = hashTapeKey(key) & (numberOfSlots - 1);
+        bool isDuplicate = false;
+        while(slots[slot] != 0)
+        {
+            const uint64_t offset = getTapePayload((*m_tape)[slots[slot]]);
+            if(getString(m_strings->data(), offset) == key)
+            {
+                isDuplicate = true;
+                break;
+            }
+            slot = (slot + 1) & (numberOfSlots - 1);
+        }
+
+        if(isDuplicate == false)
+        {
+            slots[slot] = position;
+            numberOfKeys++;
+        }
+    }
+
+    return tableOffset;
+}
+
+/**
+ * @brief write the end-word of the current container and update its start-word
+ *
+ * @param tag tag of the end-word
+ * @param count number of elements of the container
+ * @param endPayload payload of the end-word
+ *
+ * @return true
+ */
+bool
+JsonTapeBuilder::endContainer(const jsonTapeTags tag,
+                              const uint64_t count,
+                              const uint64_t endPayload)
+{
+    const uint64_t start = m_stack.back().start;
+    const uint64_t end = m_tape->size();
+    m_stack.pop_back();
+
+    m_tape->push_back(createTapeWord(tag, endPayload));
+
+    const uint64_t payload = (std::min(count, tapeMaxCount) << tapeCountShift) | end;
+    (*m_tape)[start] = createTapeWord(getTapeTag((*m_tape)[start]), payload);
+
+    return true;
+}
+
+}  // namespace Kitsunemimi
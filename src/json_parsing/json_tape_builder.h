@@ -0,0 +1,141 @@
+/**
+ *  @file    json_tape_builder.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_TAPE_BUILDER_H
+#define JSON_TAPE_BUILDER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <libKitsunemimiJson/json_handler.h>
+
+namespace Kitsunemimi
+{
+
+// the tag of a word of the tape is stored in the highest byte and the payload in the other bytes
+enum jsonTapeTags
+{
+    TAPE_MAP_START = '{',
+    TAPE_MAP_END = '}',
+    TAPE_ARRAY_START = '[',
+    TAPE_ARRAY_END = ']',
+    TAPE_STRING = '"',
+    TAPE_LONG = 'l',
+    TAPE_DOUBLE = 'd',
+    TAPE_TRUE = 't',
+    TAPE_FALSE = 'f',
+    TAPE_NULL = 'n',
+};
+
+// the start-word of a map or array contains the position of the end-word in the lower 32 bits
+// and the number of elements in the next 24 bits, which saturates at the maximum value. The
+// end-word of an array contains the position of its entry within the array-index, which
+// consists of the number of elements followed by the positions of the elements on the tape.
+// The end-word of a map contains the position of its hash-table within the map-index plus one
+// or 0, if the map is too small for a hash-table. A hash-table consists of its size followed
+// by the slots, which contain the positions of the keys on the tape or 0 for empty slots.
+static const uint64_t tapeCountShift = 32;
+static const uint64_t tapeMaxCount = 0xFFFFFF;
+static const uint64_t tapeHashThreshold = 16;
+
+inline uint64_t
+createTapeWord(const jsonTapeTags tag,
+               const uint64_t payload)
+{
+    return (static_cast<uint64_t>(tag) << 56) | payload;
+}
+
+inline jsonTapeTags
+getTapeTag(const uint64_t word)
+{
+    return static_cast<jsonTapeTags>(word >> 56);
+}
+
+inline uint64_t
+getTapePayload(const uint64_t word)
+{
+    return word & 0x00FFFFFFFFFFFFFF;
+}
+
+// FNV-1a, which doesn't depend on the standard-library, so the hash-tables stay valid, when a
+// tape is stored and loaded by another build
+inline uint64_t
+hashTapeKey(std::string_view key)
+{
+    uint64_t hash = 0xcbf29ce484222325;
+    for(const char c : key)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001b3;
+    }
+
+    return hash;
+}
+
+class JsonTapeBuilder
+        : public JsonHandler
+{
+public:
+    JsonTapeBuilder(std::vector<uint64_t> &tape,
+                    std::string &strings,
+                    std::vector<uint32_t> &arrayIndex,
+                    std::vector<uint32_t> &mapIndex);
+    ~JsonTapeBuilder();
+
+    void init(std::vector<uint64_t> &tape,
+              std::string &strings,
+              std::vector<uint32_t> &arrayIndex,
+              std::vector<uint32_t> &mapIndex);
+
+    bool startObject();
+    bool key(const std::string &key);
+    bool endObject();
+    bool startArray();
+    bool endArray();
+    bool stringValue(const std::string &value);
+    bool integerValue(const long value);
+    bool doubleValue(const double value);
+    bool boolValue(const bool value);
+    bool nullValue();
+
+    static std::string_view getString(const char* strings,
+                                      const uint64_t offset);
+
+private:
+    struct StackEntry
+    {
+        uint64_t start = 0;
+        uint64_t count = 0;
+        // position of the first key or element within the key- or element-stack
+        uint64_t first = 0;
+    };
+
+    std::vector<uint64_t>* m_tape = nullptr;
+    std::string* m_strings = nullptr;
+    std::vector<uint32_t>* m_arrayIndex = nullptr;
+    std::vector<uint32_t>* m_mapIndex = nullptr;
+
+    std::vector<StackEntry> m_stack;
+    std::vector<uint32_t> m_keyPositions;
+    std::vector<uint32_t> m_elementPositions;
+    std::vector<std::string_view> m_keyBuffer;
+
+    void addElement();
+    uint64_t addString(const std::string &value);
+    uint64_t countUniqueKeys(const uint64_t firstKey);
+    uint64_t addHashTable(const uint64_t firstKey,
+                          uint64_t &numberOfKeys);
+    bool endContainer(const jsonTapeTags tag,
+                      const uint64_t count,
+                      const uint64_t endPayload);
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_TAPE_BUILDER_H
@@ -0,0 +1,574 @@
+/**
+ *  @file    json_writer.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <json_parsing/json_writer.h>
+
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+#include <charconv>
+#include <cmath>
+#include <ostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define JSON_X86_SIMD
+#endif
+
+#if defined(__SSE2__)
+#define JSON_SSE2_WRITER
+#endif
+
+#include <json_parsing/json_structural_index.h>
+
+#include <libKitsunemimiCommon/items/data_items.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief lookup-table for the characters, which have to be escaped within a json-string
+ */
+struct EscapeTable
+{
+    // 0 = no escape, 'u' = escape as \u00XX, else the character behind the backslash
+    char escape[256];
+
+    EscapeTable()
+    {
+        for(uint32_t i = 0; i < 256; i++) {
+            escape[i] = i < 0x20 ? 'u' : 0;
+        }
+
+        escape[static_cast<uint8_t>('"')] = '"';
+        escape[static_cast<uint8_t>('\\')] = '\\';
+        escape[static_cast<uint8_t>('\b')] = 'b';
+        escape[static_cast<uint8_t>('\f')] = 'f';
+        escape[static_cast<uint8_t>('\n')] = 'n';
+        escape[static_cast<uint8_t>('\r')] = 'r';
+        escape[static_cast<uint8_t>('\t')] = 't';
+    }
+};
+
+static const EscapeTable escapeTable;
+
+#ifdef JSON_X86_SIMD
+
+/**
+ * @brief check the full 32-byte blocks of a string with avx2 for the next character to escape
+ *
+ * @param input pointer to the string
+ * @param position in: position, where the search starts, out: position of the character to
+ *                 escape or of the first byte, which was not checked
+ * @param length length of the string
+ *
+ * @return true, if a character to escape was found, else false
+ */
+__attribute__((target("avx2"))) static bool
+findEscapeCharAvx2(const char* input,
+                   uint64_t &position,
+                   const uint64_t length)
+{
+    const __m256i quotes = _mm256_set1_epi8('"');
+    const __m256i backslashes = _mm256_set1_epi8('\\');
+    const __m256i controlLimits = _mm256_set1_epi8(0x1f);
+    while(position + 32 <= length)
+    {
+        const __m256i block = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(&input[position]));
+        const __m256i special = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(block, quotes),
+                                    _mm256_cmpeq_epi8(block, backslashes)),
+                    _mm256_cmpeq_epi8(_mm256_min_epu8(block, controlLimits), block));
+        const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+        if(mask != 0)
+        {
+            position += static_cast<uint64_t>(__builtin_ctz(mask));
+            return true;
+        }
+
+        position += 32;
+    }
+
+    return false;
+}
+
+#endif
+
+/**
+ * @brief find the next character, which has to be escaped. These are the quote, the backslash
+ *        and all control characters, where bytes above 0x7f are copied unchanged. Strings with
+ *        at least 32 remaining bytes are checked with avx2, if the cpu-check of the structural
+ *        index has found it, and the rest with sse2.
+ *
+ * @param input pointer to the string
+ * @param position position, where the search starts
+ * @param length length of the string
+ *
+ * @return position of the next character to escape or the length, if there is none
+ */
+uint64_t
+JsonWriter::findEscapeChar(const char* input,
+                           uint64_t position,
+                           const uint64_t length)
+{
+#ifdef JSON_X86_SIMD
+    if(length - position >= 32
+            && JsonStructuralIndex::getCpuType() == JsonStructuralIndex::AVX2_CPU
+            && findEscapeCharAvx2(input, position, length))
+    {
+        return position;
+    }
+#endif
+
+#ifdef JSON_SSE2_WRITER
+    // check 16 bytes at once, where the unsigned minimum with 0x1f is only equal to the byte
+    // itself for the control characters
+    const __m128i quotes = _mm_set1_epi8('"');
+    const __m128i backslashes = _mm_set1_epi8('\\');
+    const __m128i controlLimits = _mm_set1_epi8(0x1f);
+    while(position + 16 <= length)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[position]));
+        const __m128i special = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(block, quotes),
+                                 _mm_cmpeq_epi8(block, backslashes)),
+                    _mm_cmpeq_epi8(_mm_min_epu8(block, controlLimits), block));
+        const int mask = _mm_movemask_epi8(special);
+        if(mask != 0) {
+            return position + static_cast<uint64_t>(__builtin_ctz(static_cast<uint32_t>(mask)));
+        }
+
+        position += 16;
+    }
+#endif
+
+    while(position < length)
+    {
+        if(escapeTable.escape[static_cast<uint8_t>(input[position])] != 0) {
+            return position;
+        }
+
+        position++;
+    }
+
+    return length;
+}
+
+/**
+ * @brief The class converts a tree of data-items into a json-formated string. It creates the
+ *        same format like the toString-functions of the data-items, but escapes all strings,
+ *        so the output can be parsed again. Output for file-descriptors and streams is written
+ *        in chunks of a fixed size, instead of converting the whole tree at first.
+ */
+JsonWriter::JsonWriter() {}
+
+/**
+ * @brief destructor
+ */
+JsonWriter::~JsonWriter() {}
+
+/**
+ * @brief convert a tree into a json-formated string
+ *
+ * @param item root of the tree
+ * @param indent true to add indents and line-breaks
+ * @param output string, where the result should be appended
+ */
+void
+JsonWriter::write(DataItem* item,
+                  const bool indent,
+                  std::string &output)
+{
+    if(item == nullptr) {
+        return;
+    }
+
+    // a single string is returned without quotes like by the data-items
+    if(item->isValue()
+            && item->toValue()->isStringValue())
+    {
+        output.append(item->toValue()->content.stringValue);
+        return;
+    }
+
+    writeItem(item, indent, 0, output);
+}
+
+/**
+ * @brief convert a tree into a json-formated string and write it into a file-descriptor. The
+ *        output is collected in a buffer of a fixed size, which is written each time it is full,
+ *        so the memory-usage doesn't depend on the size of the tree.
+ *
+ * @param item root of the tree
+ * @param indent true to add indents and line-breaks
+ * @param fd file-descriptor, where the output should be written
+ * @param error reference for error-message output
+ *
+ * @return false, if writing into the file-descriptor failed, else true
+ */
+bool
+JsonWriter::write(DataItem* item,
+                  const bool indent,
+                  const int fd,
+                  ErrorContainer &error)
+{
+    m_flushCallback = [&](const std::string &buffer)
+    {
+        uint64_t position = 0;
+        while(position < buffer.size())
+        {
+            const ssize_t result = ::write(fd, &buffer[position], buffer.size() - position);
+            if(result == -1)
+            {
+                // retry, if the write was interrupted by a signal
+                if(errno == EINTR) {
+                    continue;
+                }
+
+                error.addMeesage("failed to write json-output: " + std::string(strerror(errno)));
+                LOG_ERROR(error);
+                return false;
+            }
+
+            position += static_cast<uint64_t>(result);
+        }
+
+        return true;
+    };
+
+    return writeBuffered(item, indent);
+}
+
+/**
+ * @brief convert a tree into a json-formated string and write it into a stream. Like for the
+ *        file-descriptor, the output is written in chunks of a fixed size.
+ *
+ * @param item root of the tree
+ * @param indent true to add indents and line-breaks
+ * @param output stream, where the output should be written
+ * @param error reference for error-message output
+ *
+ * @return false, if writing into the stream failed, else true
+ */
+bool
+JsonWriter::write(DataItem* item,
+                  const bool indent,
+                  std::ostream &output,
+                  ErrorContainer &error)
+{
+    m_flushCallback = [&](const std::string &buffer)
+    {
+        output.write(buffer.c_str(), static_cast<std::streamsize>(buffer.size()));
+        if(output.good() == false)
+        {
+            error.addMeesage("failed to write json-output into the stream");
+            LOG_ERROR(error);
+            return false;
+        }
+
+        return true;
+    };
+
+    return writeBuffered(item, indent);
+}
+
+/**
+ * @brief append a string with quotes and escaped special characters. Runs of characters, which
+ *        don't have to be escaped, are found with simd-instructions and copied at once.
+ *
+ * @param input pointer to the string
+ * @param length length of the string
+ * @param output string, where the result should be appended
+ */
+void
+JsonWriter::writeString(const char* input,
+                        const uint64_t length,
+                        std::string &output)
+{
+    output.push_back('"');
+
+    uint64_t runStart = 0;
+    uint64_t position = findEscapeChar(input, 0, length);
+    while(position < length)
+    {
+        char sequence[6];
+        const uint32_t sequenceLength = getEscapeSequence(static_cast<uint8_t>(input[position]),
+                                                          sequence);
+
+        output.append(&input[runStart], position - runStart);
+        output.append(sequence, sequenceLength);
+
+        runStart = position + 1;
+        position = findEscapeChar(input, runStart, length);
+    }
+
+    output.append(&input[runStart], length - runStart);
+    output.push_back('"');
+}
+
+/**
+ * @brief get the escape-sequence for a character, which has to be escaped. Control characters
+ *        without a short form like \n are written as \u00XX with lower-case hex-digits.
+ *
+ * @param c character to escape, which was found by findEscapeChar
+ * @param sequence buffer with at least 6 bytes for the result
+ *
+ * @return length of the escape-sequence
+ */
+uint32_t
+JsonWriter::getEscapeSequence(const uint8_t c,
+                              char* sequence)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+
+    const char escape = escapeTable.escape[c];
+    sequence[0] = '\\';
+    if(escape == 'u')
+    {
+        sequence[1] = 'u';
+        sequence[2] = '0';
+        sequence[3] = '0';
+        sequence[4] = hexDigits[c >> 4];
+        sequence[5] = hexDigits[c & 0xf];
+        return 6;
+    }
+
+    sequence[1] = escape;
+    return 2;
+}
+
+/**
+ * @brief append an integer without a temporary string
+ *
+ * @param value integer to write
+ * @param output string, where the result should be appended
+ */
+void
+JsonWriter::writeLong(const long value,
+                      std::string &output)
+{
+    char buffer[24];
+    const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    output.append(buffer, static_cast<uint64_t>(result.ptr - buffer));
+}
+
+/**
+ * @brief append a floating-point-value with the shortest number of digits, which results in
+ *        exactly the same value, when it is parsed again. Values without fraction get a ".0",
+ *        so they are parsed as floating-point-value again and not as integer. If the library
+ *        was build with "CONFIG += fixed_float_format", the old format of std::to_string with
+ *        always 6 digits after the point is used instead.
+ *
+ * @param value floating-point-value to write
+ * @param output string, where the result should be appended
+ */
+void
+JsonWriter::writeDouble(const double value,
+                        std::string &output)
+{
+#ifdef JSON_FIXED_FLOAT_FORMAT
+    char buffer[64];
+    const int length = snprintf(buffer, sizeof(buffer), "%f", value);
+    if(length < 0
+            || length >= static_cast<int>(sizeof(buffer)))
+    {
+        // very big values have more digits than the buffer
+        output.append(std::to_string(value));
+        return;
+    }
+
+    output.append(buffer, static_cast<uint64_t>(length));
+#else
+    // the longest result is like "-2.2250738585072014e-308" with 24 characters
+    char buffer[32];
+    const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    const uint64_t length = static_cast<uint64_t>(result.ptr - buffer);
+    output.append(buffer, length);
+
+    // inf and nan are written like before, because json has no representation for them
+    if(memchr(buffer, '.', length) == nullptr
+            && memchr(buffer, 'e', length) == nullptr
+            && std::isfinite(value))
+    {
+        output.append(".0");
+    }
+#endif
+}
+
+/**
+ * @brief convert a tree into the buffer and give all full chunks to the flush-callback
+ *
+ * @param item root of the tree
+ * @param indent true to add indents and line-breaks
+ *
+ * @return false, if the flush-callback failed, else true
+ */
+bool
+JsonWriter::writeBuffered(DataItem* item,
+                          const bool indent)
+{
+    m_failed = false;
+
+    std::string buffer = "";
+    buffer.reserve(m_chunkSize + m_chunkSize / 4);
+    write(item, indent, buffer);
+
+    if(m_failed == false
+            && buffer.size() > 0
+            && m_flushCallback(buffer) == false)
+    {
+        m_failed = true;
+    }
+
+    m_flushCallback = nullptr;
+
+    return m_failed == false;
+}
+
+/**
+ * @brief give the buffer to the flush-callback and clear it, if it is full. Without a callback
+ *        the whole output stays in the buffer.
+ *
+ * @param output buffer with the output
+ *
+ * @return false, if the writing has to be aborted, because the flush-callback failed
+ */
+bool
+JsonWriter::flush(std::string &output)
+{
+    if(m_flushCallback == nullptr
+            || output.size() < m_chunkSize)
+    {
+        return m_failed == false;
+    }
+
+    if(m_failed == false
+            && m_flushCallback(output) == false)
+    {
+        m_failed = true;
+    }
+    output.clear();
+
+    return m_failed == false;
+}
+
+/**
+ * @brief convert an item and all of its children
+ *
+ * @param item item to convert
+ * @param indent true to add indents and line-breaks
+ * @param level depth of the item within the tree
+ * @param output string, where the result should be appended
+ */
+void
+JsonWriter::writeItem(DataItem* item,
+                      const bool indent,
+                      const uint32_t level,
+                      std::string &output)
+{
+    if(item == nullptr)
+    {
+        output.append("null");
+        return;
+    }
+
+    if(item->isMap())
+    {
+        output.push_back('{');
+        bool first = true;
+        for(const auto &[key, value] : item->toMap()->map)
+        {
+            if(first == false) {
+                output.push_back(',');
+            }
+            first = false;
+
+            writeIndent(indent, level + 1, output);
+            writeString(key.c_str(), key.size(), output);
+            output.push_back(':');
+            if(indent) {
+                output.push_back(' ');
+            }
+            writeItem(value, indent, level + 1, output);
+            if(flush(output) == false) {
+                return;
+            }
+        }
+        writeIndent(indent, level, output);
+        output.push_back('}');
+        return;
+    }
+
+    if(item->isArray())
+    {
+        output.push_back('[');
+        bool first = true;
+        for(DataItem* value : item->toArray()->array)
+        {
+            if(first == false) {
+                output.push_back(',');
+            }
+            first = false;
+
+            writeIndent(indent, level + 1, output);
+            writeItem(value, indent, level + 1, output);
+            if(flush(output) == false) {
+                return;
+            }
+        }
+        writeIndent(indent, level, output);
+        output.push_back(']');
+        return;
+    }
+
+    DataValue* value = item->toValue();
+    switch(value->getValueType())
+    {
+        case DataItem::STRING_TYPE:
+        {
+            const char* content = value->content.stringValue;
+            writeString(content, strlen(content), output);
+            break;
+        }
+        case DataItem::INT_TYPE:
+            writeLong(value->content.longValue, output);
+            break;
+        case DataItem::FLOAT_TYPE:
+            writeDouble(value->content.doubleValue, output);
+            break;
+        case DataItem::BOOL_TYPE:
+            output.append(value->content.boolValue ? "true" : "false");
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief add a line-break and the indent for a specific level
+ *
+ * @param indent true to add indents and line-breaks
+ * @param level depth within the tree
+ * @param output string, where the result should be appended
+ */
+void
+JsonWriter::writeIndent(const bool indent,
+                        const uint32_t level,
+                        std::string &output)
+{
+    if(indent == false) {
+        return;
+    }
+
+    output.push_back('\n');
+    output.append(level * 4, ' ');
+}
+
+}  // namespace Kitsunemimi
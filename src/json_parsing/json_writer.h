@@ -0,0 +1,74 @@
+/**
+ *  @file    json_writer.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <stdint.h>
+#include <string>
+#include <iosfwd>
+#include <functional>
+
+#include <libKitsunemimiCommon/logger.h>
+
+namespace Kitsunemimi
+{
+class DataItem;
+
+class JsonWriter
+{
+public:
+    JsonWriter();
+    ~JsonWriter();
+
+    void write(DataItem* item,
+               const bool indent,
+               std::string &output);
+    bool write(DataItem* item,
+               const bool indent,
+               const int fd,
+               ErrorContainer &error);
+    bool write(DataItem* item,
+               const bool indent,
+               std::ostream &output,
+               ErrorContainer &error);
+
+    static uint64_t findEscapeChar(const char* input,
+                                   uint64_t position,
+                                   const uint64_t length);
+    static uint32_t getEscapeSequence(const uint8_t c,
+                                      char* sequence);
+    static void writeString(const char* input,
+                            const uint64_t length,
+                            std::string &output);
+    static void writeLong(const long value,
+                          std::string &output);
+    static void writeDouble(const double value,
+                            std::string &output);
+    static void writeIndent(const bool indent,
+                            const uint32_t level,
+                            std::string &output);
+
+private:
+    // size of the chunks, which are given to the flush-callback
+    const uint64_t m_chunkSize = 256 * 1024;
+    std::function<bool(const std::string &buffer)> m_flushCallback = nullptr;
+    bool m_failed = false;
+
+    bool writeBuffered(DataItem* item,
+                       const bool indent);
+    bool flush(std::string &output);
+    void writeItem(DataItem* item,
+                   const bool indent,
+                   const uint32_t level,
+                   std::string &output);
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_WRITER_H
@@ -0,0 +1,183 @@
+/**
+ *  @file    json_path_matcher.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <libKitsunemimiJson/json_path_matcher.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief The class compiles a set of paths in the JSON-Pointer-format (RFC 6901) into a tree of
+ *        path-segments, which can be used multiple times for a projection-parsing. As extension
+ *        the segment '*' is a wildcard, which matches all keys of a map and all indexes of an
+ *        array.
+ */
+JsonPathMatcher::JsonPathMatcher()
+{
+    m_nodes.emplace_back();
+}
+
+/**
+ * @brief destructor
+ */
+JsonPathMatcher::~JsonPathMatcher() {}
+
+/**
+ * @brief add a new path to the matcher
+ *
+ * @param path path in the JSON-Pointer-format like "/items/0/price", where a segment '*'
+ *             matches all keys or indexes. An empty path matches the whole document.
+ * @param error reference for error-message
+ *
+ * @return false, if the path is invalid, else true
+ */
+bool
+JsonPathMatcher::addPath(const std::string &path,
+                         ErrorContainer &error)
+{
+    if(path.size() > 0
+            && path.at(0) != '/')
+    {
+        error.addMeesage("json-pointer \"" + path + "\" doesn't start with a '/'");
+        LOG_ERROR(error);
+        return false;
+    }
+
+    uint32_t current = 0;
+    uint64_t pos = 0;
+    while(pos < path.size())
+    {
+        // get next segment
+        const uint64_t start = pos + 1;
+        uint64_t end = path.find('/', start);
+        if(end == std::string::npos) {
+            end = path.size();
+        }
+        pos = end;
+
+        // decode escaped characters
+        std::string segment = "";
+        for(uint64_t i = start; i < end; i++)
+        {
+            if(path.at(i) != '~')
+            {
+                segment.push_back(path.at(i));
+                continue;
+            }
+
+            if(i + 1 < end && path.at(i + 1) == '0') {
+                segment.push_back('~');
+            } else if(i + 1 < end && path.at(i + 1) == '1') {
+                segment.push_back('/');
+            } else {
+                error.addMeesage("json-pointer \"" + path + "\" has an invalid escape-sequence");
+                LOG_ERROR(error);
+                return false;
+            }
+            i++;
+        }
+
+        // get or create child-node
+        uint32_t next = UINT32_MAX;
+        if(segment == "*")
+        {
+            next = m_nodes[current].anyChild;
+            if(next == UINT32_MAX)
+            {
+                next = static_cast<uint32_t>(m_nodes.size());
+                m_nodes[current].anyChild = next;
+                m_nodes.emplace_back();
+            }
+        }
+        else
+        {
+            std::map<std::string, uint32_t, std::less<>>::const_iterator it;
+            it = m_nodes[current].children.find(segment);
+            if(it == m_nodes[current].children.end())
+            {
+                next = static_cast<uint32_t>(m_nodes.size());
+                m_nodes[current].children.insert(std::make_pair(segment, next));
+                m_nodes.emplace_back();
+            }
+            else
+            {
+                next = it->second;
+            }
+        }
+
+        current = next;
+    }
+
+    m_nodes[current].isEnd = true;
+    m_numberOfPaths++;
+
+    return true;
+}
+
+/**
+ * @brief get number of paths of the matcher
+ *
+ * @return number of paths
+ */
+uint64_t
+JsonPathMatcher::getNumberOfPaths() const
+{
+    return m_numberOfPaths;
+}
+
+/**
+ * @brief get all nodes, which are reached from a set of nodes with a specific key or index
+ *
+ * @param nodes current set of nodes
+ * @param key key or index as string
+ * @param result reference for the resulting set of nodes
+ */
+void
+JsonPathMatcher::getChildren(const std::vector<uint32_t> &nodes,
+                             const std::string_view &key,
+                             std::vector<uint32_t> &result) const
+{
+    result.clear();
+
+    for(const uint32_t id : nodes)
+    {
+        const PathNode &node = m_nodes[id];
+
+        std::map<std::string, uint32_t, std::less<>>::const_iterator it;
+        it = node.children.find(key);
+        if(it != node.children.end()) {
+            result.push_back(it->second);
+        }
+
+        if(node.anyChild != UINT32_MAX) {
+            result.push_back(node.anyChild);
+        }
+    }
+}
+
+/**
+ * @brief check if one node of a set of nodes is the end of a path
+ *
+ * @param nodes set of nodes
+ *
+ * @return true, if one of the nodes is the end of a path, else false
+ */
+bool
+JsonPathMatcher::isEnd(const std::vector<uint32_t> &nodes) const
+{
+    for(const uint32_t id : nodes)
+    {
+        if(m_nodes[id].isEnd) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+}  // namespace Kitsunemimi
@@ -0,0 +1,267 @@
+/**
+ *  @file    json_reusable_parser.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <libKitsunemimiJson/json_reusable_parser.h>
+
+#include <json_parsing/json_parser_interface.h>
+#include <json_parsing/json_simd_parser.h>
+#include <json_parsing/json_tape_builder.h>
+#include <json_parsing/json_node_pool.h>
+
+#include <libKitsunemimiJson/json_handler.h>
+#include <libKitsunemimiJson/json_tape_document.h>
+
+#include <libKitsunemimiCommon/items/data_items.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief Parser-object, which is kept by the caller for many inputs. In contrast to the
+ *        parse-functions of the json-item and the documents, it keeps the scanner, the buffers
+ *        and stacks of the parser-engine and a pool of the items of old trees between the
+ *        calls. So after a few inputs of a similar shape, the parsing needs nearly no new
+ *        allocations. An instance must not be used by multiple threads at the same time.
+ *
+ * @param parserType parser, which should be used
+ * @param strictMode true to reject strings with invalid escape-sequences, control characters
+ *                   or invalid utf-8
+ */
+JsonReusableParser::JsonReusableParser(const JsonItem::parserTypes parserType,
+                                       const bool strictMode)
+{
+    m_parserType = parserType;
+    m_strictMode = strictMode;
+
+    if(m_parserType == JsonItem::DEFAULT_PARSER)
+    {
+#ifdef JSON_SIMD_PARSER_DEFAULT
+        m_parserType = JsonItem::SIMD_PARSER;
+#else
+        m_parserType = JsonItem::BISON_PARSER;
+#endif
+    }
+
+    m_pool = new JsonNodePool();
+    m_treeHandler.m_pool = m_pool;
+}
+
+/**
+ * @brief destructor
+ */
+JsonReusableParser::~JsonReusableParser()
+{
+    // the handler gives its incomplete tree back into the pool, so it is cleared before
+    m_treeHandler.reset();
+    m_treeHandler.m_pool = nullptr;
+
+    delete m_bisonParser;
+    delete m_simdParser;
+    delete m_tapeBuilder;
+    delete m_pool;
+}
+
+/**
+ * @brief convert a json-formated string into a json-object-tree. The items of the new tree are
+ *        taken from the pool and the old content of the item is moved into the pool afterwards.
+ *        Because the old content is only replaced after a successful parsing, the items of a
+ *        tree are reused by the next but one input. Parts of the old content must not be used
+ *        anymore after this call.
+ *
+ * @param input json-formated string, which should be parsed. It is never copied as a whole: the
+ *              simd-parser reads it in place and the bison-parser copies it in small parts into
+ *              the buffer of its scanner.
+ * @param result reference to the item, which gets the new tree
+ * @param error reference for error-message output
+ *
+ * @return true, if successful, else false. In case of an error the item keeps its old content.
+ */
+bool
+JsonReusableParser::parse(std::string_view input,
+                          JsonItem &result,
+                          ErrorContainer &error)
+{
+    return parse(input.data(), input.size(), result, error);
+}
+
+/**
+ * @brief convert a json-formated string into a json-object-tree
+ *
+ * @param input pointer to the json-formated string, which should be parsed. It doesn't have to
+ *              be null-terminated and is never copied as a whole: the simd-parser reads it in
+ *              place and the bison-parser copies it in small parts into the buffer of its scanner.
+ * @param inputSize length of the json-formated string
+ * @param result reference to the item, which gets the new tree
+ * @param error reference for error-message output
+ *
+ * @return true, if successful, else false. In case of an error the item keeps its old content.
+ */
+bool
+JsonReusableParser::parse(const char* input,
+                          const uint64_t inputSize,
+                          JsonItem &result,
+                          ErrorContainer &error)
+{
+    // an empty string results in an empty map like in the json-item
+    if(inputSize == 0) {
+        return parse("{}", 2, result, error);
+    }
+
+    if(runParser(input, inputSize, m_treeHandler, error) == false)
+    {
+        m_treeHandler.reset();
+        return false;
+    }
+
+    // process a failure, where null as only value is also no valid result
+    DataItem* content = m_treeHandler.stealResult();
+    if(content == nullptr) {
+        return false;
+    }
+
+    recycle(result);
+
+    result.m_content = content;
+    result.m_deletable = true;
+
+    return true;
+}
+
+/**
+ * @brief convert a json-formated string into a tape-document. The document keeps the memory of
+ *        its tape and the parser keeps the stacks of the tape-builder.
+ *
+ * @param input json-formated string, which should be parsed. It is copied into the document.
+ * @param result reference to the document, which gets the new content
+ * @param error reference for error-message output
+ *
+ * @return true, if successful, else false
+ */
+bool
+JsonReusableParser::parse(std::string_view input,
+                          JsonTapeDocument &result,
+                          ErrorContainer &error)
+{
+    // an empty string results in an empty map like in the json-item
+    if(input.size() == 0) {
+        return parse(std::string_view("{}"), result, error);
+    }
+
+    result.clearTape();
+
+    if(m_tapeBuilder == nullptr)
+    {
+        m_tapeBuilder = new JsonTapeBuilder(result.m_tape,
+                                            result.m_strings,
+                                            result.m_arrayIndex,
+                                            result.m_mapIndex);
+    }
+    else
+    {
+        m_tapeBuilder->init(result.m_tape,
+                            result.m_strings,
+                            result.m_arrayIndex,
+                            result.m_mapIndex);
+    }
+
+    const bool parseResult = runParser(input.data(), input.size(), *m_tapeBuilder, error);
+
+    return result.finishTape(parseResult);
+}
+
+/**
+ * @brief parse a json-formated string and forward its content as events to a handler
+ *
+ * @param input json-formated string, which should be parsed. It is never copied as a whole: the
+ *              simd-parser reads it in place and the bison-parser copies it in small parts into
+ *              the buffer of its scanner.
+ * @param handler handler, which receives the events
+ * @param error reference for error-message output
+ *
+ * @return false, if the input is invalid or the handler has aborted the parsing, else true
+ */
+bool
+JsonReusableParser::parse(std::string_view input,
+                          JsonHandler &handler,
+                          ErrorContainer &error)
+{
+    return runParser(input.data(), input.size(), handler, error);
+}
+
+/**
+ * @brief move the content of an item into the pool, so it can be used for the next trees. The
+ *        item is empty afterwards. Content, which is not owned by the item or which is part of
+ *        an arena, is only removed from the item like in a normal deletion.
+ *
+ * @param item item, which content is not necessary anymore
+ */
+void
+JsonReusableParser::recycle(JsonItem &item)
+{
+    if(item.m_content != nullptr
+            && item.m_deletable
+            && item.m_arena == nullptr)
+    {
+        m_pool->recycle(item.m_content);
+        item.m_content = nullptr;
+    }
+
+    item.clear();
+}
+
+/**
+ * @brief delete all items within the pool to release their memory
+ */
+void
+JsonReusableParser::clearPool()
+{
+    m_pool->clear();
+}
+
+/**
+ * @brief get number of unused items and map-entries, which are stored within the pool
+ *
+ * @return number of items
+ */
+uint64_t
+JsonReusableParser::getNumberOfPooledItems() const
+{
+    return m_pool->getNumberOfItems();
+}
+
+/**
+ * @brief run the parser-engine, which is created at the first call
+ *
+ * @param input pointer to the json-formated string, which should be parsed
+ * @param inputSize length of the json-formated string
+ * @param handler handler, which receives the events
+ * @param error reference for error-message output
+ *
+ * @return false, if the input is invalid or the handler has aborted the parsing, else true
+ */
+bool
+JsonReusableParser::runParser(const char* input,
+                              const uint64_t inputSize,
+                              JsonHandler &handler,
+                              ErrorContainer &error)
+{
+    if(m_parserType == JsonItem::SIMD_PARSER)
+    {
+        if(m_simdParser == nullptr) {
+            m_simdParser = new JsonSimdParser();
+        }
+        return m_simdParser->parse(input, inputSize, handler, error, m_strictMode);
+    }
+
+    if(m_bisonParser == nullptr) {
+        m_bisonParser = new JsonParserInterface();
+    }
+    return m_bisonParser->parse(input, inputSize, handler, error, m_strictMode);
+}
+
+}  // namespace Kitsunemimi
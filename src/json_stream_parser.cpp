@@ -0,0 +1,756 @@
+/**
+ *  @file    json_stream_parser.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <libKitsunemimiJson/json_stream_parser.h>
+#include <libKitsunemimiJson/json_item.h>
+
+#include <libKitsunemimiJson/json_tree_handler.h>
+#include <libKitsunemimiCommon/items/data_items.h>
+#include <json_parsing/json_scalar_types.h>
+#include <json_parsing/json_number_parser.h>
+#include <json_parsing/json_string_decoder.h>
+#include <json_parsing/json_key_cache.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief The class parses a json-formated string, which comes in multiple chunks of arbitrary
+ *        size, for example from a socket. Each chunk is processed directly while feeding, so the
+ *        parsing can overlap with the receiving. The state of the lexer and of the parser is kept
+ *        between the chunks. It accepts the same syntax like the other parsers and creates the
+ *        same tree.
+ *
+ * @param strictMode true to reject strings with invalid escape-sequences, control characters
+ *                   or invalid utf-8
+ */
+JsonStreamParser::JsonStreamParser(const bool strictMode)
+{
+    m_treeHandler = new JsonTreeHandler();
+    m_handler = m_treeHandler;
+    m_strictMode = strictMode;
+}
+
+/**
+ * @brief creates a stream-parser, which forwards the events of the parser to a handler instead
+ *        of building a tree
+ *
+ * @param handler handler, which receives the events of the parser
+ * @param strictMode true to reject strings with invalid escape-sequences, control characters
+ *                   or invalid utf-8
+ * @param keyPool optional pool to intern the keys, which are forwarded to the handler. It must
+ *                exist as long as the stream-parser.
+ */
+JsonStreamParser::JsonStreamParser(JsonHandler &handler,
+                                   const bool strictMode,
+                                   JsonKeyPool* keyPool)
+{
+    m_handler = &handler;
+    m_strictMode = strictMode;
+    if(keyPool != nullptr)
+    {
+        m_keyCache = new JsonKeyCache();
+        m_keyCache->init(keyPool);
+    }
+}
+
+/**
+ * @brief destructor
+ */
+JsonStreamParser::~JsonStreamParser()
+{
+    if(m_treeHandler != nullptr) {
+        delete m_treeHandler;
+    }
+    if(m_keyCache != nullptr) {
+        delete m_keyCache;
+    }
+}
+
+/**
+ * @brief process the next chunk of the input
+ *
+ * @param data pointer to the chunk, which is not used anymore after this call
+ * @param dataSize size of the chunk
+ * @param error reference for error-message output
+ *
+ * @return false, if the input so far is invalid, else true
+ */
+bool
+JsonStreamParser::feed(const char* data,
+                       const uint64_t dataSize,
+                       ErrorContainer &error)
+{
+    if(m_failed)
+    {
+        error.addMeesage("stream-parser has already failed and has to be reset");
+        LOG_ERROR(error);
+        return false;
+    }
+
+    m_numberOfBytes += dataSize;
+
+    uint64_t pos = 0;
+    while(pos < dataSize
+          && m_failed == false)
+    {
+        const char c = data[pos];
+
+        // continue a string, which can be splitted over multiple chunks
+        if(m_lexerState == STRING_STATE)
+        {
+            // copy all characters until the next quote or backslash at once
+            uint64_t end = pos;
+            while(end < dataSize
+                  && data[end] != '\"'
+                  && data[end] != '\\')
+            {
+                end++;
+            }
+
+            m_token.append(&data[pos], end - pos);
+            m_column += end - pos;
+            pos = end;
+            if(pos == dataSize) {
+                break;
+            }
+
+            if(data[pos] == '\\')
+            {
+                m_token.push_back('\\');
+                m_lexerState = STRING_ESCAPE_STATE;
+            }
+            else
+            {
+                m_lexerState = NO_TOKEN_STATE;
+                processToken(STRING_TOKEN);
+            }
+
+            m_column++;
+            pos++;
+            continue;
+        }
+
+        // escaped character within a string, which can not be a line-break like in the lexer
+        if(m_lexerState == STRING_ESCAPE_STATE)
+        {
+            if(c == '\n')
+            {
+                setError("invalid character", "\"");
+                break;
+            }
+
+            m_token.push_back(c);
+            m_lexerState = STRING_STATE;
+            m_column++;
+            pos++;
+            continue;
+        }
+
+        // continue an identifier, number or other value without quotes
+        if(m_lexerState == SCALAR_STATE)
+        {
+            uint64_t end = pos;
+            while(end < dataSize)
+            {
+                // a plus-sign is only allowed behind the 'e' of an exponent, which is checked
+                // at the end of the value
+                const char prev = end > pos ? data[end - 1] : m_token.back();
+                if(isPlainJsonChar(data[end]) == false
+                        && (data[end] != '+' || (prev != 'e' && prev != 'E')))
+                {
+                    break;
+                }
+                end++;
+            }
+
+            m_token.append(&data[pos], end - pos);
+            m_column += end - pos;
+            pos = end;
+
+            // the value is only complete, when the next character was found
+            if(pos < dataSize) {
+                endScalar();
+            }
+
+            continue;
+        }
+
+        // whitespaces between the tokens
+        if(c == ' '
+                || c == '\t')
+        {
+            m_column++;
+            pos++;
+            continue;
+        }
+        if(c == '\n')
+        {
+            m_line++;
+            m_column = 1;
+            pos++;
+            continue;
+        }
+
+        // start of a new token
+        m_tokenLine = m_line;
+        m_tokenColumn = m_column;
+        m_token.clear();
+
+        switch(c)
+        {
+            case '{':
+                m_token.push_back(c);
+                processToken(MAP_START_TOKEN);
+                break;
+            case '}':
+                m_token.push_back(c);
+                processToken(MAP_END_TOKEN);
+                break;
+            case '[':
+                m_token.push_back(c);
+                processToken(ARRAY_START_TOKEN);
+                break;
+            case ']':
+                m_token.push_back(c);
+                processToken(ARRAY_END_TOKEN);
+                break;
+            case ',':
+                m_token.push_back(c);
+                processToken(COMMA_TOKEN);
+                break;
+            case ':':
+                m_token.push_back(c);
+                processToken(ASSIGN_TOKEN);
+                break;
+            case '\"':
+                m_lexerState = STRING_STATE;
+                break;
+            default:
+                if(isPlainJsonChar(c) == false)
+                {
+                    setError("invalid character", std::string(1, c));
+                    break;
+                }
+                m_lexerState = SCALAR_STATE;
+                m_token.push_back(c);
+                break;
+        }
+
+        m_column++;
+        pos++;
+    }
+
+    // handle negative result
+    if(m_failed)
+    {
+        error.addMeesage(m_errorMessage);
+        LOG_ERROR(error);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief finish the parsing after the last chunk and reset the parser afterwards, so it can be
+ *        used for the next input
+ *
+ * @param result reference for the resulting item
+ * @param error reference for error-message output
+ *
+ * @return true, if the complete input was valid, else false. It is always false, if the
+ *         stream-parser was created with an external handler.
+ */
+bool
+JsonStreamParser::finish(JsonItem &result,
+                         ErrorContainer &error)
+{
+    if(m_treeHandler == nullptr)
+    {
+        error.addMeesage("stream-parser has no tree, because it uses an external handler");
+        LOG_ERROR(error);
+        reset();
+        return false;
+    }
+
+    // an empty input results in an empty map, like in the parse-function of the json-item
+    if(m_numberOfBytes == 0
+            && m_failed == false)
+    {
+        result.clear();
+        result.m_content = new DataMap();
+        result.m_deletable = true;
+        return true;
+    }
+
+    if(finish(error) == false) {
+        return false;
+    }
+
+    // null as only value is no valid output, like in the other parsers
+    DataItem* content = m_treeHandler->stealResult();
+    if(content == nullptr) {
+        return false;
+    }
+
+    result.clear();
+    result.m_content = content;
+    result.m_deletable = true;
+
+    return true;
+}
+
+/**
+ * @brief finish the parsing after the last chunk and reset the parser afterwards, so it can be
+ *        used for the next input. The tree of the internal handler is kept until the next input.
+ *
+ * @param error reference for error-message output
+ *
+ * @return true, if the complete input was valid, else false
+ */
+bool
+JsonStreamParser::finish(ErrorContainer &error)
+{
+    if(m_failed)
+    {
+        error.addMeesage("stream-parser has already failed and has to be reset");
+        LOG_ERROR(error);
+        reset();
+        return false;
+    }
+
+    // complete the last token
+    if(m_lexerState == SCALAR_STATE) {
+        endScalar();
+    } else if(m_lexerState != NO_TOKEN_STATE) {
+        setError("string was not closed", "");
+    }
+
+    if(m_failed == false
+            && m_parserState != DONE_STATE)
+    {
+        setError("syntax error", "");
+    }
+
+    // handle negative result
+    if(m_failed)
+    {
+        error.addMeesage(m_errorMessage);
+        LOG_ERROR(error);
+        reset();
+        return false;
+    }
+
+    resetState();
+
+    return true;
+}
+
+/**
+ * @brief reset the parser and delete all incomplete results of the last input
+ */
+void
+JsonStreamParser::reset()
+{
+    if(m_treeHandler != nullptr) {
+        m_treeHandler->reset();
+    }
+
+    resetState();
+}
+
+/**
+ * @brief reset the state of the lexer and parser for the next input
+ */
+void
+JsonStreamParser::resetState()
+{
+    m_lexerState = NO_TOKEN_STATE;
+    m_token.clear();
+    m_tokenLine = 1;
+    m_tokenColumn = 1;
+    m_line = 1;
+    m_column = 1;
+    m_numberOfBytes = 0;
+
+    m_parserState = VALUE_STATE;
+    m_stack.clear();
+    m_failed = false;
+    m_errorMessage = "";
+
+    // the statistics of the key-pool are updated after each input
+    if(m_keyCache != nullptr) {
+        m_keyCache->flush();
+    }
+}
+
+/**
+ * @brief check if the parser has failed and must be reset
+ *
+ * @return true, if failed, else false
+ */
+bool
+JsonStreamParser::hasFailed() const
+{
+    return m_failed;
+}
+
+/**
+ * @brief process a complete token based on the current state of the parser
+ *
+ * @param type type of the token
+ *
+ * @return false, if the token is not allowed at this position, else true
+ */
+bool
+JsonStreamParser::processToken(const tokenTypes type)
+{
+    switch(m_parserState)
+    {
+        case VALUE_STATE:
+            return processValue(type);
+
+        case VALUE_OR_END_STATE:
+            if(type == ARRAY_END_TOKEN) {
+                return processClose(type);
+            }
+            return processValue(type);
+
+        case KEY_STATE:
+            return processKey(type);
+
+        case KEY_OR_END_STATE:
+            if(type == MAP_END_TOKEN) {
+                return processClose(type);
+            }
+            return processKey(type);
+
+        case ASSIGN_STATE:
+            if(type == ASSIGN_TOKEN)
+            {
+                m_parserState = VALUE_STATE;
+                return true;
+            }
+            break;
+
+        case NEXT_STATE:
+            if(type == COMMA_TOKEN)
+            {
+                if(m_stack.back()) {
+                    m_parserState = KEY_STATE;
+                } else {
+                    m_parserState = VALUE_STATE;
+                }
+                return true;
+            }
+            if(type == MAP_END_TOKEN
+                    || type == ARRAY_END_TOKEN)
+            {
+                return processClose(type);
+            }
+            break;
+
+        case DONE_STATE:
+            break;
+    }
+
+    if(type == STRING_TOKEN) {
+        setError("syntax error", "\"" + m_token + "\"");
+    } else {
+        setError("syntax error", m_token);
+    }
+
+    return false;
+}
+
+/**
+ * @brief process a token, which has to be a new value
+ *
+ * @param type type of the token
+ *
+ * @return false, if the token is no value or the value is invalid, else true
+ */
+bool
+JsonStreamParser::processValue(const tokenTypes type)
+{
+    // new map or array
+    if(type == MAP_START_TOKEN)
+    {
+        m_stack.push_back(true);
+        m_parserState = KEY_OR_END_STATE;
+        return checkHandlerResult(m_handler->startObject());
+    }
+    if(type == ARRAY_START_TOKEN)
+    {
+        m_stack.push_back(false);
+        m_parserState = VALUE_OR_END_STATE;
+        return checkHandlerResult(m_handler->startArray());
+    }
+
+    // single value
+    if(type == STRING_TOKEN
+            || type == SCALAR_TOKEN)
+    {
+        finishValue();
+        return processScalar(type);
+    }
+
+    setError("syntax error", m_token);
+
+    return false;
+}
+
+/**
+ * @brief process a token, which has to be the key of a new key-value-pair
+ *
+ * @param type type of the token
+ *
+ * @return false, if the token is no valid key, else true
+ */
+bool
+JsonStreamParser::processKey(const tokenTypes type)
+{
+    // numbers and keywords are not allowed as keys without quotes
+    if(type == STRING_TOKEN)
+    {
+        m_parserState = ASSIGN_STATE;
+        return decodeToken()
+               && forwardKey(m_stringBuffer);
+    }
+    if(type == SCALAR_TOKEN
+            && getJsonScalarType(m_token.c_str(), m_token.size()) == STRING_SCALAR)
+    {
+        m_parserState = ASSIGN_STATE;
+        return forwardKey(m_token);
+    }
+
+    if(type == STRING_TOKEN) {
+        setError("syntax error", "\"" + m_token + "\"");
+    } else {
+        setError("syntax error", m_token);
+    }
+
+    return false;
+}
+
+/**
+ * @brief forward a key to the handler. If a key-pool is set, the handler gets the interned key
+ *        instead.
+ *
+ * @param key key of the pair
+ *
+ * @return false, if the handler has aborted, else true
+ */
+bool
+JsonStreamParser::forwardKey(const std::string &key)
+{
+    if(m_keyCache != nullptr)
+    {
+        const std::string* interned = m_keyCache->intern(key);
+        if(interned != nullptr) {
+            return checkHandlerResult(m_handler->key(*interned));
+        }
+    }
+
+    return checkHandlerResult(m_handler->key(key));
+}
+
+/**
+ * @brief process a token, which closes the current map or array
+ *
+ * @param type type of the token
+ *
+ * @return false, if the token doesn't match the current map or array, else true
+ */
+bool
+JsonStreamParser::processClose(const tokenTypes type)
+{
+    const bool isMap = m_stack.back();
+    if(isMap != (type == MAP_END_TOKEN))
+    {
+        setError("syntax error", m_token);
+        return false;
+    }
+
+    m_stack.pop_back();
+    finishValue();
+
+    if(isMap) {
+        return checkHandlerResult(m_handler->endObject());
+    }
+
+    return checkHandlerResult(m_handler->endArray());
+}
+
+/**
+ * @brief forward a single value of the current token to the handler
+ *
+ * @param type type of the token
+ *
+ * @return false, if the value is invalid or the handler has aborted, else true
+ */
+bool
+JsonStreamParser::processScalar(const tokenTypes type)
+{
+    if(type == STRING_TOKEN)
+    {
+        return decodeToken()
+               && checkHandlerResult(m_handler->stringValue(m_stringBuffer));
+    }
+
+    bool result = true;
+    switch(getJsonScalarType(m_token.c_str(), m_token.size()))
+    {
+        case TRUE_SCALAR:
+            result = m_handler->boolValue(true);
+            break;
+        case FALSE_SCALAR:
+            result = m_handler->boolValue(false);
+            break;
+        case NULL_SCALAR:
+            result = m_handler->nullValue();
+            break;
+        case LONG_SCALAR:
+        {
+            long value = 0;
+            if(parseJsonInteger(m_token.c_str(), m_token.size(), value) == false)
+            {
+                setError("integer is out of range", m_token);
+                return false;
+            }
+            result = m_handler->integerValue(value);
+            break;
+        }
+        case DOUBLE_SCALAR:
+        {
+            double value = 0.0;
+            if(parseJsonDouble(m_token.c_str(), m_token.size(), value) == false)
+            {
+                setError("float is out of range", m_token);
+                return false;
+            }
+            result = m_handler->doubleValue(value);
+            break;
+        }
+        default:
+            result = m_handler->stringValue(m_token);
+            break;
+    }
+
+    return checkHandlerResult(result);
+}
+
+/**
+ * @brief decode the escape-sequences of the current string-token into the string-buffer
+ *
+ * @return false, if the string is invalid in the strict mode, else true
+ */
+bool
+JsonStreamParser::decodeToken()
+{
+    uint64_t errorPosition = 0;
+    std::string errorMessage = "";
+    if(decodeJsonString(m_token.c_str(),
+                        m_token.size(),
+                        m_stringBuffer,
+                        m_strictMode,
+                        errorPosition,
+                        errorMessage) == false)
+    {
+        setError(errorMessage, "\"" + m_token + "\"");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief create an error-message, if the handler has aborted the parsing
+ *
+ * @param result result of the handler
+ *
+ * @return result of the handler
+ */
+bool
+JsonStreamParser::checkHandlerResult(const bool result)
+{
+    if(result == false) {
+        setError("parsing was aborted by the handler", m_token);
+    }
+
+    return result;
+}
+
+/**
+ * @brief update the state of the parser after a complete value
+ */
+void
+JsonStreamParser::finishValue()
+{
+    if(m_stack.size() == 0) {
+        m_parserState = DONE_STATE;
+    } else {
+        m_parserState = NEXT_STATE;
+    }
+}
+
+/**
+ * @brief complete a value without quotes
+ *
+ * @return false, if the value is not allowed at this position, else true
+ */
+bool
+JsonStreamParser::endScalar()
+{
+    m_lexerState = NO_TOKEN_STATE;
+
+    // plus-sign is only valid within the exponent of a number
+    if(m_token.find('+') != std::string::npos
+            && getJsonScalarType(m_token.c_str(), m_token.size()) != DOUBLE_SCALAR)
+    {
+        setError("invalid character", m_token);
+        return false;
+    }
+
+    return processToken(SCALAR_TOKEN);
+}
+
+/**
+ * @brief create an error-message in the same format like the other parsers
+ *
+ * @param message error-specific message
+ * @param brokenPart broken part of the input or an empty string, if the position is unknown
+ */
+void
+JsonStreamParser::setError(const std::string &message,
+                           const std::string &brokenPart)
+{
+    if(m_failed) {
+        return;
+    }
+
+    m_failed = true;
+
+    m_errorMessage =  "ERROR while parsing json-formated string \n";
+    m_errorMessage += "parser-message: " + message + " \n";
+
+    if(brokenPart.size() > 0)
+    {
+        m_errorMessage += "line-number: " + std::to_string(m_tokenLine) + " \n";
+        m_errorMessage.append("position in line: " + std::to_string(m_tokenColumn) + "\n");
+        m_errorMessage.append("broken part in string: \"" + brokenPart + "\"");
+    }
+    else
+    {
+        m_errorMessage += "line-number: " + std::to_string(m_line) + " \n";
+        m_errorMessage.append("position in line: UNKNOWN POSITION (maybe a string was not closed)");
+    }
+}
+
+}  // namespace Kitsunemimi
@@ -0,0 +1,536 @@
+/**
+ *  @file    json_tape_document.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <libKitsunemimiJson/json_tape_document.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <libKitsunemimiCommon/items/data_items.h>
+#include <json_parsing/json_tape_builder.h>
+#include <json_parsing/json_file_mapping.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief header at the beginning of a snapshot-file. It is followed by the tape, the
+ *        array-index, the map-index and the string-buffer without any gaps, so the tape
+ *        directly behind the header is aligned to 8 bytes within the mapped file.
+ */
+struct SnapshotHeader
+{
+    char magic[8];
+    uint32_t version = 0;
+    // written in the byte-order of the creator, to detect files of another architecture
+    uint32_t byteOrder = 0;
+    uint64_t tapeSize = 0;
+    uint64_t arrayIndexSize = 0;
+    uint64_t mapIndexSize = 0;
+    uint64_t stringsSize = 0;
+    uint64_t reserved[2] = {0, 0};
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "unexpected size of the snapshot-header");
+
+static const char snapshotMagic[8] = {'K', 'M', 'J', 'T', 'A', 'P', 'E', '\0'};
+static const uint32_t snapshotVersion = 1;
+static const uint32_t snapshotByteOrder = 0x01020304;
+
+/**
+ * @brief forward an item and all of its children as events to a handler
+ *
+ * @param item item to forward
+ * @param handler handler, which receives the events
+ */
+static void
+forwardItem(DataItem* item,
+            JsonHandler &handler)
+{
+    if(item == nullptr)
+    {
+        handler.nullValue();
+        return;
+    }
+
+    if(item->isMap())
+    {
+        handler.startObject();
+        for(const auto &[key, value] : item->toMap()->map)
+        {
+            handler.key(key);
+            forwardItem(value, handler);
+        }
+        handler.endObject();
+        return;
+    }
+
+    if(item->isArray())
+    {
+        handler.startArray();
+        for(DataItem* value : item->toArray()->array) {
+            forwardItem(value, handler);
+        }
+        handler.endArray();
+        return;
+    }
+
+    DataValue* value = item->toValue();
+    switch(value->getValueType())
+    {
+        case DataItem::STRING_TYPE:
+            handler.stringValue(value->content.stringValue);
+            break;
+        case DataItem::INT_TYPE:
+            handler.integerValue(value->content.longValue);
+            break;
+        case DataItem::FLOAT_TYPE:
+            handler.doubleValue(value->content.doubleValue);
+            break;
+        case DataItem::BOOL_TYPE:
+            handler.boolValue(value->content.boolValue);
+            break;
+        default:
+            handler.nullValue();
+            break;
+    }
+}
+
+/**
+ * @brief write a block of data completely into a file
+ *
+ * @param fd file-descriptor of the file
+ * @param data pointer to the data
+ * @param size number of bytes to write
+ *
+ * @return false, if writing failed, else true
+ */
+static bool
+writeBlock(const int fd,
+           const void* data,
+           const uint64_t size)
+{
+    const char* position = static_cast<const char*>(data);
+    uint64_t remaining = size;
+    while(remaining > 0)
+    {
+        const ssize_t written = ::write(fd, position, remaining);
+        if(written == -1
+                && errno == EINTR)
+        {
+            continue;
+        }
+        if(written <= 0) {
+            return false;
+        }
+
+        position += written;
+        remaining -= static_cast<uint64_t>(written);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Read-only document, which stores the whole parsed content in one contiguous tape of
+ *        64-bit words and one buffer for all strings, instead of a tree of separately
+ *        allocated items. The values are read by tape-items, which jump over whole maps and
+ *        arrays with the position of the end-word, which is stored in the start-word, access
+ *        the elements of arrays directly by the array-index and find the keys of big maps with
+ *        the hash-tables of the map-index.
+ */
+JsonTapeDocument::JsonTapeDocument() {}
+
+/**
+ * @brief destructor
+ */
+JsonTapeDocument::~JsonTapeDocument()
+{
+    clearTape();
+}
+
+/**
+ * @brief parse a json-formated string into the tape
+ *
+ * @param input string which should be parsed. It is copied into the document, so it can be
+ *              deleted after the parsing.
+ * @param error reference for error-message
+ * @param parserType parser, which should be used
+ * @param strictMode true to reject strings with invalid escape-sequences, control characters
+ *                   or invalid utf-8
+ *
+ * @return true, if successful, else false
+ */
+bool
+JsonTapeDocument::parse(std::string_view input,
+                        ErrorContainer &error,
+                        const JsonItem::parserTypes parserType,
+                        const bool strictMode)
+{
+    return parse(input.data(), input.size(), error, parserType, strictMode);
+}
+
+/**
+ * @brief parse a json-formated string into the tape
+ *
+ * @param input pointer to the string which should be parsed. It is copied into the document,
+ *              so it can be deleted after the parsing.
+ * @param inputSize length of the string
+ * @param error reference for error-message
+ * @param parserType parser, which should be used
+ * @param strictMode true to reject strings with invalid escape-sequences, control characters
+ *                   or invalid utf-8
+ *
+ * @return true, if successful, else false
+ */
+bool
+JsonTapeDocument::parse(const char* input,
+                        const uint64_t inputSize,
+                        ErrorContainer &error,
+                        const JsonItem::parserTypes parserType,
+                        const bool strictMode)
+{
+    // an empty string results in an empty map like in the json-item
+    if(inputSize == 0)
+    {
+        return parse("{}", 2, error, parserType, strictMode);
+    }
+
+    clearTape();
+
+    JsonTapeBuilder builder(m_tape, m_strings, m_arrayIndex, m_mapIndex);
+    const bool result = parseJson(input, inputSize, builder, error, parserType, strictMode);
+
+    return finishTape(result);
+}
+
+/**
+ * @brief convert the tree of a json-item into the tape
+ *
+ * @param item item, which should be converted
+ * @param error reference for error-message
+ *
+ * @return false, if the item is empty or null, else true
+ */
+bool
+JsonTapeDocument::fromItem(const JsonItem &item,
+                           ErrorContainer &error)
+{
+    clearTape();
+
+    if(item.isNull())
+    {
+        error.addMeesage("failed to convert json-item into a tape: item is empty");
+        LOG_ERROR(error);
+        return false;
+    }
+
+    JsonTapeBuilder builder(m_tape, m_strings, m_arrayIndex, m_mapIndex);
+    forwardItem(item.getItemContent(), builder);
+
+    return finishTape(true);
+}
+
+/**
+ * @brief write the document into a snapshot-file, which can be loaded again with loadSnapshot
+ *        without any parsing. The tape and its indexes contain only positions instead of
+ *        pointers, so they are written unchanged behind a small header. The file is written
+ *        under a temporary name and renamed at the end, so other processes, which load the
+ *        snapshot at the same time, never see an incomplete file.
+ *
+ * @param filePath path of the snapshot-file
+ * @param error reference for error-message
+ *
+ * @return false, if the document is empty or the file can not be written, else true
+ */
+bool
+JsonTapeDocument::saveSnapshot(const std::string &filePath,
+                               ErrorContainer &error) const
+{
+    if(m_isValid == false)
+    {
+        error.addMeesage("failed to write snapshot '" + filePath + "': document is empty");
+        LOG_ERROR(error);
+        return false;
+    }
+
+    SnapshotHeader header;
+    memcpy(header.magic, snapshotMagic, sizeof(snapshotMagic));
+    header.version = snapshotVersion;
+    header.byteOrder = snapshotByteOrder;
+    header.tapeSize = m_tapeSize;
+    header.arrayIndexSize = m_arrayIndexSize;
+    header.mapIndexSize = m_mapIndexSize;
+    header.stringsSize = m_stringsSize;
+
+    const std::string tempPath = filePath + ".tmp";
+    const int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd == -1)
+    {
+        error.addMeesage("failed to write snapshot '" + filePath + "': " + strerror(errno));
+        LOG_ERROR(error);
+        return false;
+    }
+
+    bool success = writeBlock(fd, &header, sizeof(SnapshotHeader))
+                   && writeBlock(fd, m_tapeData, m_tapeSize * sizeof(uint64_t))
+                   && writeBlock(fd, m_arrayIndexData, m_arrayIndexSize * sizeof(uint32_t))
+                   && writeBlock(fd, m_mapIndexData, m_mapIndexSize * sizeof(uint32_t))
+                   && writeBlock(fd, m_stringData, m_stringsSize);
+    if(::close(fd) == -1) {
+        success = false;
+    }
+
+    if(success == false
+            || rename(tempPath.c_str(), filePath.c_str()) == -1)
+    {
+        error.addMeesage("failed to write snapshot '" + filePath + "': " + strerror(errno));
+        LOG_ERROR(error);
+        unlink(tempPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief map a snapshot-file into the memory and use it directly as content of the document.
+ *        Only the header is checked, so the time doesn't depend on the size of the document,
+ *        and the pages of the file are only read, when they are accessed by the tape-items.
+ *        Multiple processes, which load the same snapshot, share its pages in the page-cache.
+ *        The file must be created by saveSnapshot and must not be changed, while it is mapped.
+ *
+ * @param filePath path of the snapshot-file
+ * @param error reference for error-message
+ *
+ * @return false, if the file can not be mapped or is no valid snapshot, else true
+ */
+bool
+JsonTapeDocument::loadSnapshot(const std::string &filePath,
+                               ErrorContainer &error)
+{
+    clearTape();
+
+    JsonFileMapping* mapping = new JsonFileMapping();
+    if(mapping->open(filePath, error, false) == false)
+    {
+        delete mapping;
+        return false;
+    }
+
+    // check the header and if the sizes of all parts match with the size of the file
+    const char* data = mapping->getData();
+    const uint64_t fileSize = mapping->getSize();
+    SnapshotHeader header;
+    std::string errorMessage = "";
+    if(fileSize < sizeof(SnapshotHeader))
+    {
+        errorMessage = "file is too small";
+    }
+    else
+    {
+        memcpy(&header, data, sizeof(SnapshotHeader));
+        const uint64_t maxWords = fileSize / sizeof(uint32_t);
+
+        if(memcmp(header.magic, snapshotMagic, sizeof(snapshotMagic)) != 0) {
+            errorMessage = "file is no snapshot";
+        } else if(header.version != snapshotVersion) {
+            errorMessage = "unsupported version " + std::to_string(header.version);
+        } else if(header.byteOrder != snapshotByteOrder) {
+            errorMessage = "snapshot was created on a system with another byte-order";
+        } else if(header.tapeSize == 0
+                  || header.tapeSize > maxWords
+                  || header.arrayIndexSize > maxWords
+                  || header.mapIndexSize > maxWords
+                  || header.stringsSize > fileSize
+                  || sizeof(SnapshotHeader)
+                     + header.tapeSize * sizeof(uint64_t)
+                     + header.arrayIndexSize * sizeof(uint32_t)
+                     + header.mapIndexSize * sizeof(uint32_t)
+                     + header.stringsSize != fileSize)
+        {
+            errorMessage = "file is incomplete or broken";
+        }
+        else
+        {
+            // the first word must be a value and a map or array at the root must end at the
+            // last word of the tape
+            uint64_t rootWord = 0;
+            memcpy(&rootWord, data + sizeof(SnapshotHeader), sizeof(uint64_t));
+            const jsonTapeTags rootTag = getTapeTag(rootWord);
+            const bool isContainer = rootTag == TAPE_MAP_START
+                                     || rootTag == TAPE_ARRAY_START;
+            if(rootTag == TAPE_NULL
+                    || (isContainer
+                        && (getTapePayload(rootWord) & 0xFFFFFFFF) != header.tapeSize - 1))
+            {
+                errorMessage = "file is incomplete or broken";
+            }
+        }
+    }
+
+    if(errorMessage.size() > 0)
+    {
+        error.addMeesage("failed to load snapshot '" + filePath + "': " + errorMessage);
+        LOG_ERROR(error);
+        delete mapping;
+        return false;
+    }
+
+    // use the parts of the file directly as content of the document
+    const char* position = data + sizeof(SnapshotHeader);
+    m_tapeData = reinterpret_cast<const uint64_t*>(position);
+    m_tapeSize = header.tapeSize;
+    position += header.tapeSize * sizeof(uint64_t);
+    m_arrayIndexData = reinterpret_cast<const uint32_t*>(position);
+    m_arrayIndexSize = header.arrayIndexSize;
+    position += header.arrayIndexSize * sizeof(uint32_t);
+    m_mapIndexData = reinterpret_cast<const uint32_t*>(position);
+    m_mapIndexSize = header.mapIndexSize;
+    position += header.mapIndexSize * sizeof(uint32_t);
+    m_stringData = position;
+    m_stringsSize = header.stringsSize;
+
+    m_mapping = mapping;
+    m_isValid = true;
+
+    return true;
+}
+
+/**
+ * @brief check if the content of the document is a mapped snapshot-file
+ *
+ * @return true, if the document was loaded from a snapshot, else false
+ */
+bool
+JsonTapeDocument::isSnapshot() const
+{
+    return m_mapping != nullptr;
+}
+
+/**
+ * @brief get the root-value of the document
+ *
+ * @return root-value, which is invalid, if the document was not successfully parsed
+ */
+JsonTapeItem
+JsonTapeDocument::getRoot() const
+{
+    if(m_isValid == false) {
+        return JsonTapeItem();
+    }
+
+    return JsonTapeItem(this, 0);
+}
+
+/**
+ * @brief get a specific entry of the root-map
+ *
+ * @param key key of the requested value
+ *
+ * @return invalid item, if the key doesn't exist, else the requested value
+ */
+JsonTapeItem
+JsonTapeDocument::operator[](const std::string &key) const
+{
+    return getRoot().get(key);
+}
+
+/**
+ * @brief get a specific entry of the root-array
+ *
+ * @param index index of the requested value
+ *
+ * @return invalid item, if the index is too high, else the requested value
+ */
+JsonTapeItem
+JsonTapeDocument::operator[](const uint32_t index) const
+{
+    return getRoot().get(index);
+}
+
+/**
+ * @brief get number of bytes, which are used by the tape, the strings and the indexes
+ *
+ * @return number of used bytes
+ */
+uint64_t
+JsonTapeDocument::getUsedBytes() const
+{
+    return m_tapeSize * sizeof(uint64_t)
+           + m_stringsSize
+           + m_arrayIndexSize * sizeof(uint32_t)
+           + m_mapIndexSize * sizeof(uint32_t);
+}
+
+/**
+ * @brief drop the content of the previous input or snapshot. The buffers keep their memory for
+ *        the next one.
+ */
+void
+JsonTapeDocument::clearTape()
+{
+    m_isValid = false;
+    m_tape.clear();
+    m_strings.clear();
+    m_arrayIndex.clear();
+    m_mapIndex.clear();
+
+    m_tapeData = nullptr;
+    m_stringData = nullptr;
+    m_arrayIndexData = nullptr;
+    m_mapIndexData = nullptr;
+    m_tapeSize = 0;
+    m_stringsSize = 0;
+    m_arrayIndexSize = 0;
+    m_mapIndexSize = 0;
+
+    delete m_mapping;
+    m_mapping = nullptr;
+}
+
+/**
+ * @brief check the tape after the parser has written the input into it
+ *
+ * @param parseResult result of the parser
+ *
+ * @return true, if the tape contains a valid document, else false
+ */
+bool
+JsonTapeDocument::finishTape(const bool parseResult)
+{
+    if(parseResult == false)
+    {
+        clearTape();
+        return false;
+    }
+
+    // null as only value is also no valid result
+    if(getTapeTag(m_tape[0]) == TAPE_NULL)
+    {
+        m_tape.clear();
+        return false;
+    }
+
+    m_tapeData = m_tape.data();
+    m_stringData = m_strings.data();
+    m_arrayIndexData = m_arrayIndex.data();
+    m_mapIndexData = m_mapIndex.data();
+    m_tapeSize = m_tape.size();
+    m_stringsSize = m_strings.size();
+    m_arrayIndexSize = m_arrayIndex.size();
+    m_mapIndexSize = m_mapIndex.size();
+    m_isValid = true;
+
+    return true;
+}
+
+}  // namespace Kitsunemimi
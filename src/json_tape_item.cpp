@@ -0,0 +1,648 @@
+/**
+ *  @file    json_tape_item.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <libKitsunemimiJson/json_tape_item.h>
+
+#include <algorithm>
+#include <string.h>
+
+#include <libKitsunemimiJson/json_tape_document.h>
+#include <json_parsing/json_tape_builder.h>
+#include <json_parsing/json_writer.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief creates an invalid item
+ */
+JsonTapeItem::JsonTapeItem() {}
+
+/**
+ * @brief creates an item, which points to a value within a document
+ *
+ * @param document document, which contains the value
+ * @param index position of the value on the tape of the document
+ */
+JsonTapeItem::JsonTapeItem(const JsonTapeDocument* document,
+                           const uint64_t index)
+{
+    m_document = document;
+    m_index = index;
+}
+
+/**
+ * @brief get a specific entry of the item
+ *
+ * @param key key of the requested value
+ *
+ * @return invalid item, if the key doesn't exist or the item is no map, else the value
+ */
+JsonTapeItem
+JsonTapeItem::operator[](const std::string &key) const
+{
+    return get(key);
+}
+
+/**
+ * @brief get a specific entry of the item
+ *
+ * @param index index of the requested value
+ *
+ * @return invalid item, if the index is too high or the item is no array, else the value
+ */
+JsonTapeItem
+JsonTapeItem::operator[](const uint32_t index) const
+{
+    return get(index);
+}
+
+/**
+ * @brief get a specific entry of the item. Big maps are searched with their hash-table and in
+ *        small maps all values in front of the requested one are skipped with a single jump
+ *        each. In case of duplicate keys the first one is returned.
+ *
+ * @param key key of the requested value
+ *
+ * @return invalid item, if the key doesn't exist or the item is no map, else the value
+ */
+JsonTapeItem
+JsonTapeItem::get(const std::string &key) const
+{
+    if(isMap() == false) {
+        return JsonTapeItem();
+    }
+
+    const uint64_t position = findKey(key);
+    if(position == 0) {
+        return JsonTapeItem();
+    }
+
+    return JsonTapeItem(m_document, position + 1);
+}
+
+/**
+ * @brief get a specific entry of the item by the array-index of the document
+ *
+ * @param index index of the requested value
+ *
+ * @return invalid item, if the index is too high or the item is no array, else the value
+ */
+JsonTapeItem
+JsonTapeItem::get(const uint32_t index) const
+{
+    if(isArray() == false
+            || index >= size())
+    {
+        return JsonTapeItem();
+    }
+
+    const uint64_t* tape = m_document->m_tapeData;
+    const uint64_t end = getTapePayload(getWord()) & 0xFFFFFFFF;
+    const uint64_t indexOffset = getTapePayload(tape[end]);
+
+    return JsonTapeItem(m_document, m_document->m_arrayIndexData[indexOffset + 1 + index]);
+}
+
+/**
+ * @brief get string of the item
+ *
+ * @return string, of the item if string-type, else empty string
+ */
+const std::string
+JsonTapeItem::getString() const
+{
+    return std::string(getStringView());
+}
+
+/**
+ * @brief get string of the item without copy
+ *
+ * @return view on the string within the document, if string-type, else empty view
+ */
+std::string_view
+JsonTapeItem::getStringView() const
+{
+    if(isString() == false) {
+        return std::string_view();
+    }
+
+    return JsonTapeBuilder::getString(m_document->m_stringData, getTapePayload(getWord()));
+}
+
+/**
+ * @brief get int-value of the item
+ *
+ * @return int-value, of the item if int-type, else 0
+ */
+int
+JsonTapeItem::getInt() const
+{
+    return static_cast<int>(getLong());
+}
+
+/**
+ * @brief get float-value of the item
+ *
+ * @return float-value, of the item if float-type, else 0
+ */
+float
+JsonTapeItem::getFloat() const
+{
+    return static_cast<float>(getDouble());
+}
+
+/**
+ * @brief get long-value of the item
+ *
+ * @return long-value, of the item if int-type, else 0
+ */
+long
+JsonTapeItem::getLong() const
+{
+    if(isInteger() == false) {
+        return 0;
+    }
+
+    return static_cast<long>(m_document->m_tapeData[m_index + 1]);
+}
+
+/**
+ * @brief get double-value of the item
+ *
+ * @return double-value, of the item if float-type, else 0
+ */
+double
+JsonTapeItem::getDouble() const
+{
+    if(isFloat() == false) {
+        return 0.0;
+    }
+
+    double value = 0.0;
+    memcpy(&value, &m_document->m_tapeData[m_index + 1], sizeof(double));
+
+    return value;
+}
+
+/**
+ * @brief get bool-value of the item
+ *
+ * @return bool-value, of the item if bool-type, else false
+ */
+bool
+JsonTapeItem::getBool() const
+{
+    return m_document != nullptr
+           && getTapeTag(getWord()) == TAPE_TRUE;
+}
+
+/**
+ * @brief getter for the number of elements in the item. It is stored in the start-word of
+ *        maps and arrays, so it has only to be counted for very big ones.
+ *
+ * @return number of elements in the item
+ */
+uint64_t
+JsonTapeItem::size() const
+{
+    if(isMap() == false
+            && isArray() == false)
+    {
+        return 0;
+    }
+
+    const uint64_t count = getTapePayload(getWord()) >> tapeCountShift;
+    if(count < tapeMaxCount) {
+        return count;
+    }
+
+    if(isMap()) {
+        return getKeys().size();
+    }
+
+    // the exact number of elements is also stored in front of the positions of the elements
+    // within the array-index
+    const uint64_t* tape = m_document->m_tapeData;
+    const uint64_t end = getTapePayload(getWord()) & 0xFFFFFFFF;
+
+    return m_document->m_arrayIndexData[getTapePayload(tape[end])];
+}
+
+/**
+ * @brief get list of keys if the item is a map. The list doesn't contain duplicate keys like
+ *        the list of the json-item.
+ *
+ * @param documentOrder true to keep the order of the keys within the document, false to sort
+ *                      them like in the json-item
+ *
+ * @return string-list with the keys of the map
+ */
+const std::vector<std::string>
+JsonTapeItem::getKeys(const bool documentOrder) const
+{
+    std::vector<std::string> keys;
+    if(isMap() == false) {
+        return keys;
+    }
+
+    std::vector<std::pair<std::string_view, uint64_t>> entries;
+    getEntries(entries, documentOrder);
+
+    keys.reserve(entries.size());
+    for(const auto &[key, index] : entries) {
+        keys.push_back(std::string(key));
+    }
+
+    return keys;
+}
+
+/**
+ * @brief check if a key is in the map
+ *
+ * @param key key-string which should be searched in the map
+ *
+ * @return false if the key doesn't exist or the item is no map, else true
+ */
+bool
+JsonTapeItem::contains(const std::string &key) const
+{
+    return get(key).m_document != nullptr;
+}
+
+/**
+ * @brief check if the current item is valid
+ *
+ * @return false, if the item doesn't exist or is a null-value, else true
+ */
+bool
+JsonTapeItem::isValid() const
+{
+    return isNull() == false;
+}
+
+/**
+ * @brief check if the current item is null
+ *
+ * @return true, if the item doesn't exist or is a null-value, else false
+ */
+bool
+JsonTapeItem::isNull() const
+{
+    if(m_document == nullptr) {
+        return true;
+    }
+
+    return getTapeTag(getWord()) == TAPE_NULL;
+}
+
+/**
+ * @brief check if current item is a map
+ *
+ * @return true if current item is a json-object, else false
+ */
+bool
+JsonTapeItem::isMap() const
+{
+    return m_document != nullptr
+           && getTapeTag(getWord()) == TAPE_MAP_START;
+}
+
+/**
+ * @brief check if current item is an array
+ *
+ * @return true if current item is a json-array, else false
+ */
+bool
+JsonTapeItem::isArray() const
+{
+    return m_document != nullptr
+           && getTapeTag(getWord()) == TAPE_ARRAY_START;
+}
+
+/**
+ * @brief check if current item is a value
+ *
+ * @return true if current item is a json-value, else false
+ */
+bool
+JsonTapeItem::isValue() const
+{
+    return isNull() == false
+           && isMap() == false
+           && isArray() == false;
+}
+
+/**
+ * @brief check if current item is a string-value
+ *
+ * @return true if current item is a string-value, else false
+ */
+bool
+JsonTapeItem::isString() const
+{
+    return m_document != nullptr
+           && getTapeTag(getWord()) == TAPE_STRING;
+}
+
+/**
+ * @brief check if current item is a float-value
+ *
+ * @return true if current item is a float-value, else false
+ */
+bool
+JsonTapeItem::isFloat() const
+{
+    return m_document != nullptr
+           && getTapeTag(getWord()) == TAPE_DOUBLE;
+}
+
+/**
+ * @brief check if current item is a int-value
+ *
+ * @return true if current item is a int-value, else false
+ */
+bool
+JsonTapeItem::isInteger() const
+{
+    return m_document != nullptr
+           && getTapeTag(getWord()) == TAPE_LONG;
+}
+
+/**
+ * @brief check if current item is a bool-value
+ *
+ * @return true if current item is a bool-value, else false
+ */
+bool
+JsonTapeItem::isBool() const
+{
+    if(m_document == nullptr) {
+        return false;
+    }
+
+    const jsonTapeTags tag = getTapeTag(getWord());
+    return tag == TAPE_TRUE
+           || tag == TAPE_FALSE;
+}
+
+/**
+ * @brief convert the content of the item into a string in the same format like the json-item
+ *
+ * @param indent true to add indents and line-breaks
+ * @param documentOrder true to write the keys of maps in the order of the document, false to
+ *                      sort them like the json-item
+ *
+ * @return item as json-formated string
+ */
+const std::string
+JsonTapeItem::toString(bool indent,
+                       const bool documentOrder) const
+{
+    std::string output;
+    if(isNull()) {
+        return output;
+    }
+
+    // a single string is returned without quotes like by the json-item
+    if(isString())
+    {
+        output.append(getStringView());
+        return output;
+    }
+
+    writeValue(m_index, indent, documentOrder, 0, output);
+
+    return output;
+}
+
+/**
+ * @brief get the word of the value on the tape
+ *
+ * @return tagged word
+ */
+uint64_t
+JsonTapeItem::getWord() const
+{
+    return m_document->m_tapeData[m_index];
+}
+
+/**
+ * @brief get the position behind a value on the tape
+ *
+ * @param index position of the value on the tape
+ *
+ * @return position of the first word behind the value
+ */
+uint64_t
+JsonTapeItem::skipValue(const uint64_t index) const
+{
+    const uint64_t word = m_document->m_tapeData[index];
+    switch(getTapeTag(word))
+    {
+        case TAPE_MAP_START:
+        case TAPE_ARRAY_START:
+            return (getTapePayload(word) & 0xFFFFFFFF) + 1;
+        case TAPE_LONG:
+        case TAPE_DOUBLE:
+            return index + 2;
+        default:
+            return index + 1;
+    }
+}
+
+/**
+ * @brief search a key within the map
+ *
+ * @param key key to search
+ *
+ * @return position of the first matching key on the tape or 0, if the key doesn't exist
+ */
+uint64_t
+JsonTapeItem::findKey(std::string_view key) const
+{
+    const uint64_t* tape = m_document->m_tapeData;
+    const char* strings = m_document->m_stringData;
+    const uint64_t end = getTapePayload(getWord()) & 0xFFFFFFFF;
+    const uint64_t tablePosition = getTapePayload(tape[end]);
+
+    if(tablePosition != 0)
+    {
+        const uint32_t* table = &m_document->m_mapIndexData[tablePosition - 1];
+        const uint64_t mask = table[0] - 1;
+        const uint32_t* slots = &table[1];
+
+        uint64_t slot = hashTapeKey(key) & mask;
+        while(slots[slot] != 0)
+        {
+            const uint64_t position = slots[slot];
+            if(JsonTapeBuilder::getString(strings, getTapePayload(tape[position])) == key) {
+                return position;
+            }
+            slot = (slot + 1) & mask;
+        }
+
+        return 0;
+    }
+
+    uint64_t i = m_index + 1;
+    while(getTapeTag(tape[i]) != TAPE_MAP_END)
+    {
+        if(JsonTapeBuilder::getString(strings, getTapePayload(tape[i])) == key) {
+            return i;
+        }
+
+        i = skipValue(i + 1);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief get all key-value-pairs of the map, where only the first one of duplicate keys is
+ *        kept, like in the map of the json-item
+ *
+ * @param entries reference for the resulting keys and positions of the values on the tape
+ * @param documentOrder true to keep the order of the document, false to sort by key
+ */
+void
+JsonTapeItem::getEntries(std::vector<std::pair<std::string_view, uint64_t>> &entries,
+                         const bool documentOrder) const
+{
+    const uint64_t* tape = m_document->m_tapeData;
+    uint64_t i = m_index + 1;
+    while(getTapeTag(tape[i]) != TAPE_MAP_END)
+    {
+        const std::string_view key = JsonTapeBuilder::getString(m_document->m_stringData,
+                                                                getTapePayload(tape[i]));
+        entries.emplace_back(key, i + 1);
+        i = skipValue(i + 1);
+    }
+
+    // the number of keys of the start-word doesn't count duplicates, so if it matches, the
+    // entries are already complete in the order of the document
+    const uint64_t numberOfKeys = getTapePayload(getWord()) >> tapeCountShift;
+    if(documentOrder
+            && numberOfKeys < tapeMaxCount
+            && numberOfKeys == entries.size())
+    {
+        return;
+    }
+
+    // equal keys are sorted by the position of their values, so the first one stays in front
+    std::sort(entries.begin(), entries.end());
+    entries.erase(std::unique(entries.begin(),
+                              entries.end(),
+                              [](const auto &a, const auto &b) { return a.first == b.first; }),
+                  entries.end());
+
+    if(documentOrder)
+    {
+        std::sort(entries.begin(),
+                  entries.end(),
+                  [](const auto &a, const auto &b) { return a.second < b.second; });
+    }
+}
+
+/**
+ * @brief convert a value and all of its children
+ *
+ * @param index position of the value on the tape
+ * @param indent true to add indents and line-breaks
+ * @param documentOrder true to write the keys of maps in the order of the document
+ * @param level depth of the value within the document
+ * @param output string, where the result should be appended
+ */
+void
+JsonTapeItem::writeValue(const uint64_t index,
+                         const bool indent,
+                         const bool documentOrder,
+                         const uint32_t level,
+                         std::string &output) const
+{
+    const uint64_t* tape = m_document->m_tapeData;
+    const uint64_t word = tape[index];
+
+    switch(getTapeTag(word))
+    {
+        case TAPE_MAP_START:
+        {
+            std::vector<std::pair<std::string_view, uint64_t>> entries;
+            JsonTapeItem(m_document, index).getEntries(entries, documentOrder);
+
+            output.push_back('{');
+            bool first = true;
+            for(const auto &[key, valueIndex] : entries)
+            {
+                if(first == false) {
+                    output.push_back(',');
+                }
+                first = false;
+
+                JsonWriter::writeIndent(indent, level + 1, output);
+                JsonWriter::writeString(key.data(), key.size(), output);
+                output.push_back(':');
+                if(indent) {
+                    output.push_back(' ');
+                }
+                writeValue(valueIndex, indent, documentOrder, level + 1, output);
+            }
+            JsonWriter::writeIndent(indent, level, output);
+            output.push_back('}');
+            break;
+        }
+        case TAPE_ARRAY_START:
+        {
+            output.push_back('[');
+            bool first = true;
+            uint64_t i = index + 1;
+            while(getTapeTag(tape[i]) != TAPE_ARRAY_END)
+            {
+                if(first == false) {
+                    output.push_back(',');
+                }
+                first = false;
+
+                JsonWriter::writeIndent(indent, level + 1, output);
+                writeValue(i, indent, documentOrder, level + 1, output);
+                i = skipValue(i);
+            }
+            JsonWriter::writeIndent(indent, level, output);
+            output.push_back(']');
+            break;
+        }
+        case TAPE_STRING:
+        {
+            const std::string_view value = JsonTapeBuilder::getString(m_document->m_stringData,
+                                                                      getTapePayload(word));
+            JsonWriter::writeString(value.data(), value.size(), output);
+            break;
+        }
+        case TAPE_LONG:
+            JsonWriter::writeLong(static_cast<long>(tape[index + 1]), output);
+            break;
+        case TAPE_DOUBLE:
+        {
+            double value = 0.0;
+            memcpy(&value, &tape[index + 1], sizeof(double));
+            JsonWriter::writeDouble(value, output);
+            break;
+        }
+        case TAPE_TRUE:
+            output.append("true");
+            break;
+        case TAPE_FALSE:
+            output.append("false");
+            break;
+        default:
+            output.append("null");
+            break;
+    }
+}
+
+}  // namespace Kitsunemimi
@@ -0,0 +1,324 @@
+/**
+ *  @file    json_tree_handler.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <libKitsunemimiJson/json_tree_handler.h>
+
+#include <json_parsing/json_arena.h>
+#include <json_parsing/json_node_pool.h>
+
+#include <libKitsunemimiCommon/items/data_items.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief Handler, which builds a tree of data-items out of the events of the parser. It is used
+ *        by the json-item to parse strings. Like in all parsers before, the first value is kept
+ *        in case of a duplicate key. If an arena is set by the json-item, all items are created
+ *        within the arena. If a node-pool is set by the reusable parser, the items are taken
+ *        from the pool and unused items are moved back into it.
+ */
+JsonTreeHandler::JsonTreeHandler() {}
+
+/**
+ * @brief destructor
+ */
+JsonTreeHandler::~JsonTreeHandler()
+{
+    reset();
+}
+
+/**
+ * @brief start a new map
+ */
+bool
+JsonTreeHandler::startObject()
+{
+    if(m_arena != nullptr) {
+        return addContainer(m_arena->createMap(), true);
+    }
+    if(m_pool != nullptr) {
+        return addContainer(m_pool->createMap(), true);
+    }
+
+    return addContainer(new DataMap(), true);
+}
+
+/**
+ * @brief store the key for the next value of the current map
+ */
+bool
+JsonTreeHandler::key(const std::string &key)
+{
+    m_stack.back().key = key;
+    return true;
+}
+
+/**
+ * @brief close the current map
+ */
+bool
+JsonTreeHandler::endObject()
+{
+    return endContainer();
+}
+
+/**
+ * @brief start a new array
+ */
+bool
+JsonTreeHandler::startArray()
+{
+    if(m_arena != nullptr) {
+        return addContainer(m_arena->createArray(), false);
+    }
+    if(m_pool != nullptr) {
+        return addContainer(m_pool->createArray(), false);
+    }
+
+    return addContainer(new DataArray(), false);
+}
+
+/**
+ * @brief close the current array
+ */
+bool
+JsonTreeHandler::endArray()
+{
+    return endContainer();
+}
+
+/**
+ * @brief add a string-value
+ */
+bool
+JsonTreeHandler::stringValue(const std::string &value)
+{
+    if(m_arena != nullptr) {
+        return addValue(m_arena->createValue(value));
+    }
+    if(m_pool != nullptr) {
+        return addValue(m_pool->createValue(value));
+    }
+
+    return addValue(new DataValue(value));
+}
+
+/**
+ * @brief add an integer-value
+ */
+bool
+JsonTreeHandler::integerValue(const long value)
+{
+    if(m_arena != nullptr) {
+        return addValue(m_arena->createValue(value));
+    }
+    if(m_pool != nullptr) {
+        return addValue(m_pool->createValue(value));
+    }
+
+    return addValue(new DataValue(value));
+}
+
+/**
+ * @brief add a floating-point-value
+ */
+bool
+JsonTreeHandler::doubleValue(const double value)
+{
+    if(m_arena != nullptr) {
+        return addValue(m_arena->createValue(value));
+    }
+    if(m_pool != nullptr) {
+        return addValue(m_pool->createValue(value));
+    }
+
+    return addValue(new DataValue(value));
+}
+
+/**
+ * @brief add a bool-value
+ */
+bool
+JsonTreeHandler::boolValue(const bool value)
+{
+    if(m_arena != nullptr) {
+        return addValue(m_arena->createValue(value));
+    }
+    if(m_pool != nullptr) {
+        return addValue(m_pool->createValue(value));
+    }
+
+    return addValue(new DataValue(value));
+}
+
+/**
+ * @brief add null, which is stored as nullptr within the tree
+ */
+bool
+JsonTreeHandler::nullValue()
+{
+    return addValue(nullptr);
+}
+
+/**
+ * @brief get the resulting tree and reset the handler
+ *
+ * @return resulting tree, or nullptr, if the tree is not complete or the input was only null
+ */
+DataItem*
+JsonTreeHandler::stealResult()
+{
+    if(m_stack.size() > 0)
+    {
+        reset();
+        return nullptr;
+    }
+
+    DataItem* result = m_root;
+    m_root = nullptr;
+
+    return result;
+}
+
+/**
+ * @brief delete the incomplete tree and all items, which are not connected to it
+ */
+void
+JsonTreeHandler::reset()
+{
+    for(const StackEntry &entry : m_stack)
+    {
+        if(entry.isOrphan) {
+            deleteItem(entry.item);
+        }
+    }
+    m_stack.clear();
+
+    if(m_root != nullptr)
+    {
+        deleteItem(m_root);
+        m_root = nullptr;
+    }
+}
+
+/**
+ * @brief add a new map or array to the tree and make it to the current one
+ *
+ * @param item new map or array
+ * @param isMap true, if the item is a map
+ *
+ * @return always true
+ */
+bool
+JsonTreeHandler::addContainer(DataItem* item,
+                              const bool isMap)
+{
+    StackEntry entry;
+    entry.item = item;
+    entry.isMap = isMap;
+    entry.isOrphan = attachItem(item) == false;
+    m_stack.push_back(entry);
+
+    return true;
+}
+
+/**
+ * @brief close the current map or array
+ *
+ * @return always true
+ */
+bool
+JsonTreeHandler::endContainer()
+{
+    // an item, which was not added because of a duplicate key, is not necessary anymore
+    const StackEntry &entry = m_stack.back();
+    if(entry.isOrphan) {
+        deleteItem(entry.item);
+    }
+
+    m_stack.pop_back();
+
+    return true;
+}
+
+/**
+ * @brief add a new value to the tree
+ *
+ * @param item new value
+ *
+ * @return always true
+ */
+bool
+JsonTreeHandler::addValue(DataItem* item)
+{
+    if(attachItem(item) == false) {
+        deleteItem(item);
+    }
+
+    return true;
+}
+
+/**
+ * @brief add a new item to the current map or array, or set it as root, if it is the first one
+ *
+ * @param item new item
+ *
+ * @return false, if the key already exist in the current map, else true
+ */
+bool
+JsonTreeHandler::attachItem(DataItem* item)
+{
+    if(m_stack.size() == 0)
+    {
+        if(m_root != nullptr) {
+            deleteItem(m_root);
+        }
+        m_root = item;
+        return true;
+    }
+
+    StackEntry &parent = m_stack.back();
+    if(parent.isMap)
+    {
+        // keep the first value in case of a duplicate key
+        if(m_pool != nullptr) {
+            return m_pool->insert(parent.item->toMap(), parent.key, item);
+        }
+        return parent.item->toMap()->insert(parent.key, item);
+    }
+
+    parent.item->toArray()->append(item);
+
+    return true;
+}
+
+/**
+ * @brief delete an item, which is not part of the tree. Items within the arena are kept,
+ *        because they are deleted together with the arena, and with a node-pool the items are
+ *        moved back into the pool.
+ *
+ * @param item item to delete
+ */
+void
+JsonTreeHandler::deleteItem(DataItem* item)
+{
+    if(m_arena != nullptr) {
+        return;
+    }
+
+    if(m_pool != nullptr)
+    {
+        m_pool->recycle(item);
+        return;
+    }
+
+    delete item;
+}
+
+}  // namespace Kitsunemimi
@@ -13,13 +13,80 @@ INCLUDEPATH += ../../libKitsunemimiCommon/include
 INCLUDEPATH += $$PWD \
                $$PWD/../include
 
+# use the simd-parser instead of the bison-parser as default for JsonItem::parse
+simd_parser_default {
+    DEFINES += JSON_SIMD_PARSER_DEFAULT
+}
+
+# write floating-point-values with always 6 digits after the point like before, instead of the
+# shortest representation, which results in exactly the same value, when it is parsed again
+fixed_float_format {
+    DEFINES += JSON_FIXED_FLOAT_FORMAT
+}
+
 SOURCES += \
+    json_parsing/json_arena.cpp \
+    json_parsing/json_binary_parser.cpp \
+    json_parsing/json_binary_writer.cpp \
+    json_parsing/json_canonical_writer.cpp \
+    json_parsing/json_file_mapping.cpp \
+    json_parsing/json_hasher.cpp \
+    json_parsing/json_key_cache.cpp \
+    json_parsing/json_node_pool.cpp \
+    json_parsing/json_number_parser.cpp \
+    json_parsing/json_parallel_parser.cpp \
     json_parsing/json_parser_interface.cpp \
-    json_item.cpp
+    json_parsing/json_projection_parser.cpp \
+    json_parsing/json_scalar_types.cpp \
+    json_parsing/json_simd_parser.cpp \
+    json_parsing/json_string_decoder.cpp \
+    json_parsing/json_structural_index.cpp \
+    json_parsing/json_tape_builder.cpp \
+    json_parsing/json_writer.cpp \
+    json_document.cpp \
+    json_handler.cpp \
+    json_item.cpp \
+    json_key_pool.cpp \
+    json_lazy_item.cpp \
+    json_lines_parser.cpp \
+    json_path_matcher.cpp \
+    json_reusable_parser.cpp \
+    json_stream_parser.cpp \
+    json_tape_document.cpp \
+    json_tape_item.cpp \
+    json_tree_handler.cpp
 
 HEADERS += \
+    ../include/libKitsunemimiJson/json_document.h \
+    ../include/libKitsunemimiJson/json_handler.h \
     ../include/libKitsunemimiJson/json_item.h \
-    json_parsing/json_parser_interface.h
+    ../include/libKitsunemimiJson/json_key_pool.h \
+    ../include/libKitsunemimiJson/json_lazy_item.h \
+    ../include/libKitsunemimiJson/json_lines_parser.h \
+    ../include/libKitsunemimiJson/json_path_matcher.h \
+    ../include/libKitsunemimiJson/json_reusable_parser.h \
+    ../include/libKitsunemimiJson/json_stream_parser.h \
+    ../include/libKitsunemimiJson/json_tape_document.h \
+    ../include/libKitsunemimiJson/json_tape_item.h \
+    ../include/libKitsunemimiJson/json_tree_handler.h \
+    json_parsing/json_arena.h \
+    json_parsing/json_binary_parser.h \
+    json_parsing/json_binary_writer.h \
+    json_parsing/json_canonical_writer.h \
+    json_parsing/json_file_mapping.h \
+    json_parsing/json_hasher.h \
+    json_parsing/json_key_cache.h \
+    json_parsing/json_node_pool.h \
+    json_parsing/json_number_parser.h \
+    json_parsing/json_parallel_parser.h \
+    json_parsing/json_parser_interface.h \
+    json_parsing/json_projection_parser.h \
+    json_parsing/json_scalar_types.h \
+    json_parsing/json_simd_parser.h \
+    json_parsing/json_string_decoder.h \
+    json_parsing/json_structural_index.h \
+    json_parsing/json_tape_builder.h \
+    json_parsing/json_writer.h
 
 FLEXSOURCES = grammar/json_lexer.l
 BISONSOURCES = grammar/json_parser.y
@@ -0,0 +1,24 @@
+include(../../defaults.pri)
+
+QT -= qt core gui
+
+CONFIG -= app_bundle
+CONFIG += c++17 console
+
+LIBS += -L../../src -lKitsunemimiJson
+INCLUDEPATH += $$PWD
+
+LIBS += -L../../../libKitsunemimiCommon/src -lKitsunemimiCommon
+LIBS += -L../../../libKitsunemimiCommon/src/debug -lKitsunemimiCommon
+LIBS += -L../../../libKitsunemimiCommon/src/release -lKitsunemimiCommon
+INCLUDEPATH += ../../../libKitsunemimiCommon/include
+
+LIBS += -lpthread
+
+SOURCES += \
+    main.cpp \
+    libKitsunemimiJson/json_item_parse_benchmark.cpp
+
+HEADERS += \
+    libKitsunemimiJson/json_item_parse_benchmark.h
+
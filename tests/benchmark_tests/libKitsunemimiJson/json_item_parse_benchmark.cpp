@@ -0,0 +1,1396 @@
+/**
+ *  @file    json_item_parse_benchmark.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include "json_item_parse_benchmark.h"
+#include <libKitsunemimiJson/json_handler.h>
+#include <libKitsunemimiJson/json_lines_parser.h>
+#include <libKitsunemimiJson/json_document.h>
+#include <libKitsunemimiJson/json_path_matcher.h>
+#include <libKitsunemimiJson/json_key_pool.h>
+#include <libKitsunemimiJson/json_tape_document.h>
+#include <libKitsunemimiJson/json_reusable_parser.h>
+
+#include <libKitsunemimiCommon/items/data_items.h>
+
+#include <thread>
+#include <cstdlib>
+#include <unistd.h>
+
+namespace Kitsunemimi
+{
+
+JsonItem_Parse_Benchmark::JsonItem_Parse_Benchmark()
+    : Kitsunemimi::SpeedTestHelper()
+{
+    m_testString = createTestString(2000);
+    m_testLines = createTestLines(100000);
+    m_testNumbers = createTestNumbers(200000);
+    m_testStrings = createTestStrings(100000);
+    m_testRecords = createTestRecords(50000);
+    m_testObject = createTestObject(5000);
+
+    ErrorContainer error;
+    m_testItem.parse(m_testString, error);
+
+    benchmarkThreads();
+    benchmarkParsers();
+    benchmarkReusable();
+    benchmarkHandler();
+    benchmarkLines();
+    benchmarkParallel();
+    benchmarkReadFields();
+    benchmarkTraverse();
+    benchmarkLookup();
+    benchmarkNumbers();
+    benchmarkStrings();
+    benchmarkKeys();
+    benchmarkConvert();
+    benchmarkBinary();
+    benchmarkHash();
+    benchmarkBuildTree();
+
+    printResult();
+}
+
+/**
+ * @brief run a group of benchmarks, which should be compared with each other. The benchmarks
+ *        are run alternately, so all of them are affected in the same way by other load on the
+ *        system.
+ *
+ * @param names names of the timeslots
+ * @param run function, which runs each benchmark of the group once with the timeslots in the
+ *            order of the names
+ */
+void
+JsonItem_Parse_Benchmark::runSlots(
+        const std::vector<std::string> &names,
+        const std::function<void(std::vector<TimerSlot> &timeSlots)> &run)
+{
+    std::vector<TimerSlot> timeSlots(names.size());
+    for(uint64_t i = 0; i < names.size(); i++)
+    {
+        timeSlots[i].unitName = "ms";
+        timeSlots[i].name = names.at(i);
+    }
+
+    for(uint32_t i = 0; i < m_numberOfRuns; i++) {
+        run(timeSlots);
+    }
+
+    for(const TimerSlot &timeSlot : timeSlots) {
+        addToResult(timeSlot);
+    }
+}
+
+/**
+ * @brief parse with a rising number of threads, where the total amount of work is the same for
+ *        each thread-count, so the time should go down linear
+ */
+void
+JsonItem_Parse_Benchmark::benchmarkThreads()
+{
+    for(const uint32_t numberOfThreads : m_threadCounts)
+    {
+        runSlots({"parse 64 documents with " + std::to_string(numberOfThreads) + " threads"},
+                 [&](std::vector<TimerSlot> &timeSlots)
+        {
+            parseThreads_test(timeSlots[0], numberOfThreads);
+        });
+    }
+}
+
+/**
+ * @brief compare the bison-parser with the simd-parser
+ */
+void
+JsonItem_Parse_Benchmark::benchmarkParsers()
+{
+    runSlots({"parse 16 documents with the bison-parser",
+              "parse 16 documents with the simd-parser",
+              "parse 16 documents with the bison-parser into an arena",
+              "parse 16 documents with the simd-parser into an arena"},
+             [&](std::vector<TimerSlot> &timeSlots)
+    {
+        parseParser_test(timeSlots[0], JsonItem::BISON_PARSER, false);
+        parseParser_test(timeSlots[1], JsonItem::SIMD_PARSER, false);
+        parseParser_test(timeSlots[2], JsonItem::BISON_PARSER, true);
+        parseParser_test(timeSlots[3], JsonItem::SIMD_PARSER, true);
+    });
+}
+
+/**
+ * @brief compare a new tree for each document with a parser, which reuses the items of old trees
+ */
+void
+JsonItem_Parse_Benchmark::benchmarkReusable()
+{
+    runSlots({"parse 16 documents with a reusable bison-parser",
+              "parse 16 documents with a reusable simd-parser"},
+             [&](std::vector<TimerSlot> &timeSlots)
+    {
+        parseReusable_test(timeSlots[0], JsonItem::BISON_PARSER);
+        parseReusable_test(timeSlots[1], JsonItem::SIMD_PARSER);
+    });
+}
+
+/**
+ * @brief compare the parsing with and without building the tree
+ */
+void
+JsonItem_Parse_Benchmark::benchmarkHandler()
+{
+    runSlots({"parse 16 documents with the bison-parser without tree",
+              "parse 16 documents with the simd-parser without tree"},
+             [&](std::vector<TimerSlot> &timeSlots)
+    {
+        parseHandler_test(timeSlots[0], JsonItem::BISON_PARSER);
+        parseHandler_test(timeSlots[1], JsonItem::SIMD_PARSER);
+    });
+}
+
+/**
+ * @brief parse newline-delimited records with a rising number of worker-threads
+ */
+void
+JsonItem_Parse_Benchmark::benchmarkLines()
+{
+    for(const uint32_t numberOfThreads : m_threadCounts)
+    {
+        runSlots({"parse 100000 json-lines with " + std::to_string(numberOfThreads) + " threads"},
+                 [&](std::vector<TimerSlot> &timeSlots)
+        {
+            parseLines_test(timeSlots[0], numberOfThreads);
+        });
+    }
+}
+
+/**
+ * @brief parse one big array, whose elements are distributed over a rising number of threads
+ */
+void
+JsonItem_Parse_Benchmark::benchmarkParallel()
+{
+    for(const uint32_t numberOfThreads : m_threadCounts)
+    {
+        runSlots({"parse 16 documents in parallel with " + std::to_string(numberOfThreads)
+                  + " threads"},
+                 [&](std::vector<TimerSlot> &timeSlots)
+        {
+            parseParallel_test(timeSlots[0], numberOfThreads);
+        });
+    }
+}
+
+/**
+ * @brief compare the reading of a few values with a complete, a lazy, a projection and a tape
+ *        parsing and with the loading of a snapshot
+ */
+void
+JsonItem_Parse_Benchmark::benchmarkReadFields()
+{
+    const std::string snapshotPath = "/tmp/libKitsunemimiJson_benchmark_snapshot.tape";
+    JsonTapeDocument snapshotDocument;
+    ErrorContainer error;
+    snapshotDocument.parse(m_testString, error);
+    snapshotDocument.saveSnapshot(snapshotPath, error);
+
+    runSlots({"read 4 values of 16 documents with complete parsing",
+              "read 4 values of 16 documents with lazy parsing",
+              "read 4 values of 16 documents with projection parsing",
+              "read 4 values of 16 documents with tape parsing",
+              "read 4 values of 16 documents loaded from a snapshot"},
+             [&](std::vector<TimerSlot> &timeSlots)
+    {
+        readFields_test(timeSlots[0]);
+        readFieldsLazy_test(timeSlots[1]);
+        readFieldsPaths_test(timeSlots[2]);
+        readFieldsTape_test(timeSlots[3]);
+        readFieldsSnapshot_test(timeSlots[4], snapshotPath);
+    });
+
+    unlink(snapshotPath.c_str());
+}
+
+/**
+ * @brief compare the reading of all values of an already parsed tree and tape
+ */
+void
+JsonItem_Parse_Benchmark::benchmarkTraverse()
+{
+    runSlots({"read all entries of a document 16 times from the tree",
+              "read all entries of a document 16 times from the tape"},
+             [&](std::vector<TimerSlot> &timeSlots)
+    {
+        traverse_test(timeSlots[0]);
+        traverseTape_test(timeSlots[1]);
+    });
+}
+
+/**
+ * @brief compare the search of keys in an object with many keys in the map of the tree and in
+ *        the hash-table of the tape
+ */
+void
+JsonItem_Parse_Benchmark::benchmarkLookup()
+{
+    runSlots({"search all 5000 keys of an object 16 times in the tree",
+              "search all 5000 keys of an object 16 times in the tape"},
+             [&](std::vector<TimerSlot> &timeSlots)
+    {
+        lookupKeys_test(timeSlots[0]);
+        lookupKeysTape_test(timeSlots[1]);
+    });
+}
+
+/**
+ * @brief compare the number-conversion of the parsers with strtod as reference
+ */
+void
+JsonItem_Parse_Benchmark::benchmarkNumbers()
+{
+    runSlots({"parse 200000 numbers with the bison-parser without tree",
+              "parse 200000 numbers with the simd-parser without tree",
+              "convert 200000 numbers with strtod"},
+             [&](std::vector<TimerSlot> &timeSlots)
+    {
+        parseNumbers_test(timeSlots[0], JsonItem::BISON_PARSER);
+        parseNumbers_test(timeSlots[1], JsonItem::SIMD_PARSER);
+        convertNumbers_test(timeSlots[2]);
+    });
+}
+
+/**
+ * @brief decoding of long strings with a few escape-sequences and non-ascii characters
+ */
+void
+JsonItem_Parse_Benchmark::benchmarkStrings()
+{
+    runSlots({"parse 100000 strings with the bison-parser without tree",
+              "parse 100000 strings with the simd-parser without tree",
+              "parse 100000 strings with the simd-parser in strict mode"},
+             [&](std::vector<TimerSlot> &timeSlots)
+    {
+        parseStrings_test(timeSlots[0], JsonItem::BISON_PARSER, false);
+        parseStrings_test(timeSlots[1], JsonItem::SIMD_PARSER, false);
+        parseStrings_test(timeSlots[2], JsonItem::SIMD_PARSER, true);
+    });
+}
+
+/**
+ * @brief collect the keys of records, where the same few keys repeat in each record
+ */
+void
+JsonItem_Parse_Benchmark::benchmarkKeys()
+{
+    runSlots({"collect keys of 50000 records with the bison-parser",
+              "collect keys of 50000 records with the bison-parser and key-pool",
+              "collect keys of 50000 records with the simd-parser",
+              "collect keys of 50000 records with the simd-parser and key-pool"},
+             [&](std::vector<TimerSlot> &timeSlots)
+    {
+        collectKeys_test(timeSlots[0], JsonItem::BISON_PARSER);
+        collectKeysPool_test(timeSlots[1], JsonItem::BISON_PARSER);
+        collectKeys_test(timeSlots[2], JsonItem::SIMD_PARSER);
+        collectKeysPool_test(timeSlots[3], JsonItem::SIMD_PARSER);
+    });
+}
+
+/**
+ * @brief compare the conversion into a new string for each call with a reused output-string
+ */
+void
+JsonItem_Parse_Benchmark::benchmarkConvert()
+{
+    JsonItem stringsItem;
+    JsonItem numbersItem;
+    ErrorContainer error;
+    stringsItem.parse(m_testStrings, error);
+    numbersItem.parse(m_testNumbers, error);
+
+    runSlots({"convert a document 16 times with the data-items",
+              "convert a document 16 times with toString",
+              "convert a document 16 times into a reused string",
+              "convert a document 16 times with indent into a reused string",
+              "convert 100000 strings 16 times with toString",
+              "convert 100000 strings 16 times into a reused string",
+              "convert 200000 numbers 16 times into a reused string"},
+             [&](std::vector<TimerSlot> &timeSlots)
+    {
+        convertDataItem_test(timeSlots[0], m_testItem);
+        convertToString_test(timeSlots[1], m_testItem);
+        convertWriteTo_test(timeSlots[2], m_testItem, false);
+        convertWriteTo_test(timeSlots[3], m_testItem, true);
+        convertToString_test(timeSlots[4], stringsItem);
+        convertWriteTo_test(timeSlots[5], stringsItem, false);
+        convertWriteTo_test(timeSlots[6], numbersItem, false);
+    });
+}
+
+/**
+ * @brief compare the binary formats with the json-string in speed and size
+ */
+void
+JsonItem_Parse_Benchmark::benchmarkBinary()
+{
+    const std::string cborData = m_testItem.toCbor();
+    const std::string msgPackData = m_testItem.toMsgPack();
+
+    runSlots({"convert a document 16 times into cbor",
+              "convert a document 16 times into msgpack",
+              "parse 16 documents from cbor",
+              "parse 16 documents from msgpack"},
+             [&](std::vector<TimerSlot> &timeSlots)
+    {
+        convertCbor_test(timeSlots[0], m_testItem);
+        convertMsgPack_test(timeSlots[1], m_testItem);
+        parseCbor_test(timeSlots[2], cborData);
+        parseMsgPack_test(timeSlots[3], msgPackData);
+    });
+
+    TimerSlot jsonSizeSlot;
+    jsonSizeSlot.unitName = "KiB";
+    jsonSizeSlot.name = "size of a document as json-string";
+    jsonSizeSlot.values.push_back(static_cast<double>(m_testItem.toString().size()) / 1024.0);
+
+    TimerSlot cborSizeSlot;
+    cborSizeSlot.unitName = "KiB";
+    cborSizeSlot.name = "size of a document as cbor";
+    cborSizeSlot.values.push_back(static_cast<double>(cborData.size()) / 1024.0);
+
+    TimerSlot msgPackSizeSlot;
+    msgPackSizeSlot.unitName = "KiB";
+    msgPackSizeSlot.name = "size of a document as msgpack";
+    msgPackSizeSlot.values.push_back(static_cast<double>(msgPackData.size()) / 1024.0);
+
+    addToResult(jsonSizeSlot);
+    addToResult(cborSizeSlot);
+    addToResult(msgPackSizeSlot);
+}
+
+/**
+ * @brief compare the hashing of the canonical string with the hashing while walking the tree
+ */
+void
+JsonItem_Parse_Benchmark::benchmarkHash()
+{
+    runSlots({"hash a document 16 times over its canonical string",
+              "hash a document 16 times while walking the tree"},
+             [&](std::vector<TimerSlot> &timeSlots)
+    {
+        hashCanonicalString_test(timeSlots[0], m_testItem);
+        hashTree_test(timeSlots[1], m_testItem);
+    });
+}
+
+/**
+ * @brief build a deep tree bottom-up, where the time with copies grows quadratic with the depth
+ *        and the time with moves only linear
+ */
+void
+JsonItem_Parse_Benchmark::benchmarkBuildTree()
+{
+    const uint32_t depths[3] = {125, 250, 500};
+    for(const uint32_t depth : depths)
+    {
+        runSlots({"build a tree with depth " + std::to_string(depth) + " 16 times with copies",
+                  "build a tree with depth " + std::to_string(depth) + " 16 times with moves"},
+                 [&](std::vector<TimerSlot> &timeSlots)
+        {
+            buildTree_test(timeSlots[0], depth, false);
+            buildTree_test(timeSlots[1], depth, true);
+        });
+    }
+}
+
+/**
+ * @brief parse the same number of documents distributed over a specific number of threads
+ *
+ * @param timeSlot timeslot for the results
+ * @param numberOfThreads number of threads, which should parse in parallel
+ */
+void
+JsonItem_Parse_Benchmark::parseThreads_test(TimerSlot &timeSlot,
+                                            const uint32_t numberOfThreads)
+{
+    const uint32_t numberOfDocuments = 64;
+    std::vector<std::thread> threads;
+
+    timeSlot.startTimer();
+
+    for(uint32_t t = 0; t < numberOfThreads; t++)
+    {
+        threads.emplace_back([this, numberOfThreads, numberOfDocuments]()
+        {
+            for(uint32_t i = 0; i < numberOfDocuments / numberOfThreads; i++)
+            {
+                JsonItem item;
+                ErrorContainer error;
+                item.parse(m_testString, error);
+            }
+        });
+    }
+
+    for(std::thread &thread : threads) {
+        thread.join();
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief parse and delete multiple documents with a specific parser
+ *
+ * @param timeSlot timeslot for the results
+ * @param parserType parser, which should be used
+ * @param useArena true to create the trees within an arena
+ */
+void
+JsonItem_Parse_Benchmark::parseParser_test(TimerSlot &timeSlot,
+                                           const JsonItem::parserTypes parserType,
+                                           const bool useArena)
+{
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        JsonItem item;
+        ErrorContainer error;
+        item.parse(m_testString, error, parserType, false, useArena);
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief parse multiple documents into the same item with one reusable parser
+ *
+ * @param timeSlot timeslot for the results
+ * @param parserType parser, which should be used
+ */
+void
+JsonItem_Parse_Benchmark::parseReusable_test(TimerSlot &timeSlot,
+                                             const JsonItem::parserTypes parserType)
+{
+    timeSlot.startTimer();
+
+    JsonReusableParser parser(parserType);
+    JsonItem item;
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        ErrorContainer error;
+        parser.parse(m_testString, item, error);
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief parse multiple documents with a handler, which ignores all events, so only the
+ *        parsing itself is measured without building a tree
+ *
+ * @param timeSlot timeslot for the results
+ * @param parserType parser, which should be used
+ */
+void
+JsonItem_Parse_Benchmark::parseHandler_test(TimerSlot &timeSlot,
+                                            const JsonItem::parserTypes parserType)
+{
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        JsonHandler handler;
+        ErrorContainer error;
+        parseJson(m_testString, handler, error, parserType);
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief parse newline-delimited records with a specific number of worker-threads
+ *
+ * @param timeSlot timeslot for the results
+ * @param numberOfThreads number of worker-threads of the parser
+ */
+void
+JsonItem_Parse_Benchmark::parseLines_test(TimerSlot &timeSlot,
+                                          const uint32_t numberOfThreads)
+{
+    JsonLinesParser parser(numberOfThreads);
+
+    timeSlot.startTimer();
+
+    uint64_t counter = 0;
+    parser.parse(m_testLines, [&counter](JsonLinesParser::Record &)
+    {
+        counter++;
+        return true;
+    });
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief parse multiple documents, where the elements of each document are parsed by a
+ *        specific number of threads
+ *
+ * @param timeSlot timeslot for the results
+ * @param numberOfThreads number of threads, which should parse in parallel
+ */
+void
+JsonItem_Parse_Benchmark::parseParallel_test(TimerSlot &timeSlot,
+                                             const uint32_t numberOfThreads)
+{
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        JsonItem item;
+        ErrorContainer error;
+        item.parseParallel(m_testString, error, numberOfThreads);
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief parse multiple documents completely and read a few values of each
+ *
+ * @param timeSlot timeslot for the results
+ */
+void
+JsonItem_Parse_Benchmark::readFields_test(TimerSlot &timeSlot)
+{
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        JsonItem item;
+        ErrorContainer error;
+        item.parse(m_testString, error, JsonItem::SIMD_PARSER);
+        item[0]["name"].getString();
+        item[10]["value"].getDouble();
+        item[1000]["id"].getLong();
+        item[1999]["tags"][2].getString();
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief parse multiple documents lazy and read a few values of each
+ *
+ * @param timeSlot timeslot for the results
+ */
+void
+JsonItem_Parse_Benchmark::readFieldsLazy_test(TimerSlot &timeSlot)
+{
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        JsonDocument document;
+        ErrorContainer error;
+        document.parse(m_testString, error);
+        document[0]["name"].getString();
+        document[10]["value"].getDouble();
+        document[1000]["id"].getLong();
+        document[1999]["tags"][2].getString();
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief parse only a few paths of multiple documents and read their values
+ *
+ * @param timeSlot timeslot for the results
+ */
+void
+JsonItem_Parse_Benchmark::readFieldsPaths_test(TimerSlot &timeSlot)
+{
+    JsonPathMatcher matcher;
+    ErrorContainer error;
+    matcher.addPath("/0/name", error);
+    matcher.addPath("/10/value", error);
+    matcher.addPath("/1000/id", error);
+    matcher.addPath("/1999/tags/2", error);
+
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        JsonItem item;
+        item.parse(m_testString, matcher, error);
+        item[0]["name"].getString();
+        item[1]["value"].getDouble();
+        item[2]["id"].getLong();
+        item[3]["tags"][0].getString();
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief parse multiple documents into a tape and read a few values of each
+ *
+ * @param timeSlot timeslot for the results
+ */
+void
+JsonItem_Parse_Benchmark::readFieldsTape_test(TimerSlot &timeSlot)
+{
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        JsonTapeDocument document;
+        ErrorContainer error;
+        document.parse(m_testString, error, JsonItem::SIMD_PARSER);
+        document[0]["name"].getString();
+        document[10]["value"].getDouble();
+        document[1000]["id"].getLong();
+        document[1999]["tags"][2].getString();
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief map a snapshot of the document multiple times and read a few values of each
+ *
+ * @param timeSlot timeslot for the results
+ * @param filePath path of the snapshot-file
+ */
+void
+JsonItem_Parse_Benchmark::readFieldsSnapshot_test(TimerSlot &timeSlot,
+                                                  const std::string &filePath)
+{
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        JsonTapeDocument document;
+        ErrorContainer error;
+        document.loadSnapshot(filePath, error);
+        document[0]["name"].getString();
+        document[10]["value"].getDouble();
+        document[1000]["id"].getLong();
+        document[1999]["tags"][2].getString();
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief read the values of all entries of an already parsed tree multiple times
+ *
+ * @param timeSlot timeslot for the results
+ */
+void
+JsonItem_Parse_Benchmark::traverse_test(TimerSlot &timeSlot)
+{
+    JsonItem item;
+    ErrorContainer error;
+    item.parse(m_testString, error, JsonItem::SIMD_PARSER);
+
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        const uint32_t numberOfEntries = item.size();
+        for(uint32_t j = 0; j < numberOfEntries; j++)
+        {
+            JsonItem entry = item.get(j);
+            entry.get("id").getLong();
+            entry.get("name").getString();
+            entry.get("value").getDouble();
+            entry.get("tags").get(2).getString();
+        }
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief read the values of all entries of an already parsed tape multiple times
+ *
+ * @param timeSlot timeslot for the results
+ */
+void
+JsonItem_Parse_Benchmark::traverseTape_test(TimerSlot &timeSlot)
+{
+    JsonTapeDocument document;
+    ErrorContainer error;
+    document.parse(m_testString, error, JsonItem::SIMD_PARSER);
+
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        const JsonTapeItem root = document.getRoot();
+        const uint32_t numberOfEntries = root.size();
+        for(uint32_t j = 0; j < numberOfEntries; j++)
+        {
+            const JsonTapeItem entry = root.get(j);
+            entry.get("id").getLong();
+            entry.get("name").getString();
+            entry.get("value").getDouble();
+            entry.get("tags").get(2).getString();
+        }
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief search all keys of an already parsed object with many keys within the tree
+ *
+ * @param timeSlot timeslot for the results
+ */
+void
+JsonItem_Parse_Benchmark::lookupKeys_test(TimerSlot &timeSlot)
+{
+    JsonItem item;
+    ErrorContainer error;
+    item.parse(m_testObject, error, JsonItem::SIMD_PARSER);
+
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        for(const std::string &key : m_testKeys) {
+            item.get(key).getLong();
+        }
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief search all keys of an already parsed object with many keys within the tape
+ *
+ * @param timeSlot timeslot for the results
+ */
+void
+JsonItem_Parse_Benchmark::lookupKeysTape_test(TimerSlot &timeSlot)
+{
+    JsonTapeDocument document;
+    ErrorContainer error;
+    document.parse(m_testObject, error, JsonItem::SIMD_PARSER);
+
+    timeSlot.startTimer();
+
+    const JsonTapeItem root = document.getRoot();
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        for(const std::string &key : m_testKeys) {
+            root.get(key).getLong();
+        }
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief parse an array of numbers with a handler, which ignores all events, so mostly the
+ *        conversion of the numbers is measured
+ *
+ * @param timeSlot timeslot for the results
+ * @param parserType parser, which should be used
+ */
+void
+JsonItem_Parse_Benchmark::parseNumbers_test(TimerSlot &timeSlot,
+                                            const JsonItem::parserTypes parserType)
+{
+    timeSlot.startTimer();
+
+    JsonHandler handler;
+    ErrorContainer error;
+    parseJson(m_testNumbers, handler, error, parserType);
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief convert the same array of numbers with strtod as reference for the number-parsing
+ *
+ * @param timeSlot timeslot for the results
+ */
+void
+JsonItem_Parse_Benchmark::convertNumbers_test(TimerSlot &timeSlot)
+{
+    timeSlot.startTimer();
+
+    // volatile, so the conversion can not be removed by the compiler
+    volatile double sum = 0.0;
+    const char* pos = &m_testNumbers[1];
+    while(*pos != ']')
+    {
+        char* end = nullptr;
+        sum = sum + strtod(pos, &end);
+        pos = end;
+        if(*pos == ',') {
+            pos++;
+        }
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief parse an array of strings with a handler, which ignores all events, so mostly the
+ *        decoding of the strings is measured
+ *
+ * @param timeSlot timeslot for the results
+ * @param parserType parser, which should be used
+ * @param strictMode true to validate the strings
+ */
+void
+JsonItem_Parse_Benchmark::parseStrings_test(TimerSlot &timeSlot,
+                                            const JsonItem::parserTypes parserType,
+                                            const bool strictMode)
+{
+    timeSlot.startTimer();
+
+    JsonHandler handler;
+    ErrorContainer error;
+    parseJson(m_testStrings, handler, error, parserType, strictMode);
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief handler, which stores a copy of each key
+ */
+class KeyCollectHandler
+        : public JsonHandler
+{
+public:
+    std::vector<std::string> keys;
+
+    bool key(const std::string &key)
+    {
+        keys.push_back(key);
+        return true;
+    }
+};
+
+/**
+ * @brief handler, which stores only the pointer of each interned key
+ */
+class InternedKeyCollectHandler
+        : public JsonHandler
+{
+public:
+    std::vector<const std::string*> keys;
+
+    bool key(const std::string &key)
+    {
+        keys.push_back(&key);
+        return true;
+    }
+};
+
+/**
+ * @brief collect copies of the keys of records with repeated keys
+ *
+ * @param timeSlot timeslot for the results
+ * @param parserType parser, which should be used
+ */
+void
+JsonItem_Parse_Benchmark::collectKeys_test(TimerSlot &timeSlot,
+                                           const JsonItem::parserTypes parserType)
+{
+    timeSlot.startTimer();
+
+    KeyCollectHandler handler;
+    ErrorContainer error;
+    parseJson(m_testRecords, handler, error, parserType);
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief collect the interned keys of records with repeated keys
+ *
+ * @param timeSlot timeslot for the results
+ * @param parserType parser, which should be used
+ */
+void
+JsonItem_Parse_Benchmark::collectKeysPool_test(TimerSlot &timeSlot,
+                                               const JsonItem::parserTypes parserType)
+{
+    timeSlot.startTimer();
+
+    JsonKeyPool keyPool;
+    InternedKeyCollectHandler handler;
+    ErrorContainer error;
+    parseJson(m_testRecords, handler, error, parserType, false, &keyPool);
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief convert a tree multiple times with the toString-function of the data-items
+ *
+ * @param timeSlot timeslot for the results
+ * @param item item to convert
+ */
+void
+JsonItem_Parse_Benchmark::convertDataItem_test(TimerSlot &timeSlot,
+                                               const JsonItem &item)
+{
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        const std::string output = item.getItemContent()->toString();
+        m_outputSize = output.size();
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief convert a tree multiple times into a new string
+ *
+ * @param timeSlot timeslot for the results
+ * @param item item to convert
+ */
+void
+JsonItem_Parse_Benchmark::convertToString_test(TimerSlot &timeSlot,
+                                               const JsonItem &item)
+{
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        const std::string output = item.toString();
+        m_outputSize = output.size();
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief convert a tree multiple times into the same string, which keeps its capacity
+ *
+ * @param timeSlot timeslot for the results
+ * @param item item to convert
+ * @param indent true to add indents and line-breaks
+ */
+void
+JsonItem_Parse_Benchmark::convertWriteTo_test(TimerSlot &timeSlot,
+                                              const JsonItem &item,
+                                              const bool indent)
+{
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        m_output.clear();
+        item.writeTo(m_output, indent);
+        m_outputSize = m_output.size();
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief convert an item multiple times into the CBOR-format
+ *
+ * @param timeSlot timeslot for the results
+ * @param item item to convert
+ */
+void
+JsonItem_Parse_Benchmark::convertCbor_test(TimerSlot &timeSlot,
+                                           const JsonItem &item)
+{
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        const std::string output = item.toCbor();
+        m_outputSize = output.size();
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief convert an item multiple times into the MessagePack-format
+ *
+ * @param timeSlot timeslot for the results
+ * @param item item to convert
+ */
+void
+JsonItem_Parse_Benchmark::convertMsgPack_test(TimerSlot &timeSlot,
+                                              const JsonItem &item)
+{
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        const std::string output = item.toMsgPack();
+        m_outputSize = output.size();
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief convert CBOR-data multiple times into a new tree
+ *
+ * @param timeSlot timeslot for the results
+ * @param data CBOR-data of the test-document
+ */
+void
+JsonItem_Parse_Benchmark::parseCbor_test(TimerSlot &timeSlot,
+                                         const std::string &data)
+{
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        JsonItem item;
+        ErrorContainer error;
+        item.fromCbor(data, error);
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief convert MessagePack-data multiple times into a new tree
+ *
+ * @param timeSlot timeslot for the results
+ * @param data MessagePack-data of the test-document
+ */
+void
+JsonItem_Parse_Benchmark::parseMsgPack_test(TimerSlot &timeSlot,
+                                            const std::string &data)
+{
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        JsonItem item;
+        ErrorContainer error;
+        item.fromMsgPack(data, error);
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief convert an item multiple times into its canonical string and hash the string
+ *
+ * @param timeSlot timeslot for the results
+ * @param item item to hash
+ */
+void
+JsonItem_Parse_Benchmark::hashCanonicalString_test(TimerSlot &timeSlot,
+                                                   const JsonItem &item)
+{
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        const std::string output = item.toCanonicalString();
+        m_outputSize = std::hash<std::string>{}(output);
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief hash an item multiple times without creating the canonical string
+ *
+ * @param timeSlot timeslot for the results
+ * @param item item to hash
+ */
+void
+JsonItem_Parse_Benchmark::hashTree_test(TimerSlot &timeSlot,
+                                        const JsonItem &item)
+{
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        uint64_t first = 0;
+        uint64_t second = 0;
+        item.hash128(first, second);
+        m_outputSize = first ^ second;
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief build a tree bottom-up multiple times, where each level is a map with a few values and
+ *        the tree of the level below
+ *
+ * @param timeSlot timeslot for the results
+ * @param depth number of levels of the tree
+ * @param move true to move the subtrees into the new levels, false to copy them
+ */
+void
+JsonItem_Parse_Benchmark::buildTree_test(TimerSlot &timeSlot,
+                                         const uint32_t depth,
+                                         const bool move)
+{
+    timeSlot.startTimer();
+
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        JsonItem tree("leaf");
+        for(uint32_t level = 0; level < depth; level++)
+        {
+            JsonItem node;
+            node.insert("level", JsonItem(static_cast<long>(level)));
+            node.insert("name", JsonItem("node"));
+            if(move) {
+                node.insert("child", std::move(tree));
+            } else {
+                node.insert("child", tree);
+            }
+            tree = std::move(node);
+        }
+        m_outputSize = tree.size();
+    }
+
+    timeSlot.stopTimer();
+    timeSlot.values.push_back(timeSlot.getDuration(MILLI_SECONDS));
+}
+
+/**
+ * @brief create a json-string with an array of objects for the benchmarks
+ *
+ * @param numberOfEntries number of objects within the array
+ *
+ * @return json-formated string
+ */
+const std::string
+JsonItem_Parse_Benchmark::createTestString(const uint32_t numberOfEntries)
+{
+    std::string output = "[";
+
+    for(uint32_t i = 0; i < numberOfEntries; i++)
+    {
+        if(i != 0) {
+            output.append(",");
+        }
+
+        output.append("{\"id\": " + std::to_string(i) + ", "
+                      "\"name\": \"entry_" + std::to_string(i) + "\", "
+                      "\"value\": " + std::to_string(i) + ".5, "
+                      "\"active\": true, "
+                      "\"parent\": null, "
+                      "\"tags\": [\"first\", \"second\", \"third\"]}");
+    }
+
+    output.append("]");
+
+    return output;
+}
+
+/**
+ * @brief create newline-delimited records for the benchmarks
+ *
+ * @param numberOfLines number of records
+ *
+ * @return string with one json-object per line
+ */
+const std::string
+JsonItem_Parse_Benchmark::createTestLines(const uint32_t numberOfLines)
+{
+    std::string output = "";
+
+    for(uint32_t i = 0; i < numberOfLines; i++)
+    {
+        output.append("{\"id\": " + std::to_string(i) + ", "
+                      "\"level\": \"info\", "
+                      "\"message\": \"request " + std::to_string(i) + " done\", "
+                      "\"duration\": " + std::to_string(i % 100) + ".25, "
+                      "\"tags\": [\"http\", \"api\"]}\n");
+    }
+
+    return output;
+}
+
+/**
+ * @brief create a json-string with an array of integers, decimals and numbers with exponent
+ *
+ * @param numberOfNumbers number of values within the array
+ *
+ * @return json-formated string
+ */
+const std::string
+JsonItem_Parse_Benchmark::createTestNumbers(const uint32_t numberOfNumbers)
+{
+    std::string output = "[";
+
+    for(uint32_t i = 0; i < numberOfNumbers; i++)
+    {
+        if(i > 0) {
+            output.append(",");
+        }
+
+        switch(i % 4)
+        {
+            case 0:
+                output.append(std::to_string(i * 7919));
+                break;
+            case 1:
+                output.append("-" + std::to_string(i) + "." + std::to_string(i % 1000));
+                break;
+            case 2:
+                output.append(std::to_string(i % 97) + ".125e-" + std::to_string(i % 300));
+                break;
+            default:
+                output.append("0." + std::to_string(i * 104729) + "E+" + std::to_string(i % 20));
+                break;
+        }
+    }
+
+    output.append("]");
+
+    return output;
+}
+
+/**
+ * @brief create a json-string with an array of long strings, where some of them contain
+ *        escape-sequences or non-ascii characters
+ *
+ * @param numberOfStrings number of strings within the array
+ *
+ * @return json-formated string
+ */
+const std::string
+JsonItem_Parse_Benchmark::createTestStrings(const uint32_t numberOfStrings)
+{
+    std::string output = "[";
+
+    for(uint32_t i = 0; i < numberOfStrings; i++)
+    {
+        if(i > 0) {
+            output.append(",");
+        }
+
+        output.append("\"request " + std::to_string(i) + " was processed by the server "
+                      "and returned a response without any errors");
+        switch(i % 4)
+        {
+            case 0:
+                output.append(" \\\"ok\\\"\\n");
+                break;
+            case 1:
+                output.append(" \xc3\xa4\xc3\xb6\xc3\xbc \\u00e4\\u20ac");
+                break;
+            default:
+                break;
+        }
+        output.append("\"");
+    }
+
+    output.append("]");
+
+    return output;
+}
+
+/**
+ * @brief create a json-string with an array of records, which all have the same long keys
+ *
+ * @param numberOfRecords number of records within the array
+ *
+ * @return json-formated string
+ */
+const std::string
+JsonItem_Parse_Benchmark::createTestRecords(const uint32_t numberOfRecords)
+{
+    std::string output = "[";
+
+    for(uint32_t i = 0; i < numberOfRecords; i++)
+    {
+        if(i > 0) {
+            output.append(",");
+        }
+
+        output.append("{\"transaction_identifier\":" + std::to_string(i)
+                      + ",\"transaction_timestamp\":" + std::to_string(1600000000 + i)
+                      + ",\"customer_account_number\":\"" + std::to_string(i % 977) + "\""
+                      + ",\"payment_method_category\":\"card\""
+                      + ",\"is_flagged_for_review\":false"
+                      + ",\"billing_address_country\":\"de\"}");
+    }
+
+    output.append("]");
+
+    return output;
+}
+
+/**
+ * @brief create an object with many keys for the benchmarks and remember the keys
+ *
+ * @param numberOfKeys number of keys of the object
+ *
+ * @return json-formated string
+ */
+const std::string
+JsonItem_Parse_Benchmark::createTestObject(const uint32_t numberOfKeys)
+{
+    std::string output = "{";
+    m_testKeys.clear();
+
+    for(uint32_t i = 0; i < numberOfKeys; i++)
+    {
+        if(i != 0) {
+            output.append(",");
+        }
+
+        // mix the numbers, so the keys are not already sorted within the input
+        m_testKeys.push_back("property_" + std::to_string((i * 7919) % 100000));
+        output.append("\"" + m_testKeys.back() + "\": " + std::to_string(i));
+    }
+
+    output.append("}");
+
+    return output;
+}
+
+}  // namespace Kitsunemimi
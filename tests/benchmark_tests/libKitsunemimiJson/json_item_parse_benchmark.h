@@ -0,0 +1,130 @@
+/**
+ *  @file    json_item_parse_benchmark.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_ITEM_PARSE_BENCHMARK_H
+#define JSON_ITEM_PARSE_BENCHMARK_H
+
+#include <libKitsunemimiCommon/test_helper/speed_test_helper.h>
+#include <libKitsunemimiJson/json_item.h>
+
+#include <functional>
+
+namespace Kitsunemimi
+{
+
+class JsonItem_Parse_Benchmark
+        : public Kitsunemimi::SpeedTestHelper
+{
+public:
+    JsonItem_Parse_Benchmark();
+
+private:
+    void runSlots(const std::vector<std::string> &names,
+                  const std::function<void(std::vector<TimerSlot> &timeSlots)> &run);
+
+    void benchmarkThreads();
+    void benchmarkParsers();
+    void benchmarkReusable();
+    void benchmarkHandler();
+    void benchmarkLines();
+    void benchmarkParallel();
+    void benchmarkReadFields();
+    void benchmarkTraverse();
+    void benchmarkLookup();
+    void benchmarkNumbers();
+    void benchmarkStrings();
+    void benchmarkKeys();
+    void benchmarkConvert();
+    void benchmarkBinary();
+    void benchmarkHash();
+    void benchmarkBuildTree();
+
+    void parseThreads_test(TimerSlot &timeSlot,
+                           const uint32_t numberOfThreads);
+    void parseParser_test(TimerSlot &timeSlot,
+                          const JsonItem::parserTypes parserType,
+                          const bool useArena);
+    void parseReusable_test(TimerSlot &timeSlot,
+                            const JsonItem::parserTypes parserType);
+    void parseHandler_test(TimerSlot &timeSlot,
+                           const JsonItem::parserTypes parserType);
+    void parseLines_test(TimerSlot &timeSlot,
+                         const uint32_t numberOfThreads);
+    void parseParallel_test(TimerSlot &timeSlot,
+                            const uint32_t numberOfThreads);
+    void readFields_test(TimerSlot &timeSlot);
+    void readFieldsLazy_test(TimerSlot &timeSlot);
+    void readFieldsPaths_test(TimerSlot &timeSlot);
+    void readFieldsTape_test(TimerSlot &timeSlot);
+    void readFieldsSnapshot_test(TimerSlot &timeSlot,
+                                 const std::string &filePath);
+    void traverse_test(TimerSlot &timeSlot);
+    void traverseTape_test(TimerSlot &timeSlot);
+    void lookupKeys_test(TimerSlot &timeSlot);
+    void lookupKeysTape_test(TimerSlot &timeSlot);
+    void parseNumbers_test(TimerSlot &timeSlot,
+                           const JsonItem::parserTypes parserType);
+    void convertNumbers_test(TimerSlot &timeSlot);
+    void parseStrings_test(TimerSlot &timeSlot,
+                           const JsonItem::parserTypes parserType,
+                           const bool strictMode);
+    void collectKeys_test(TimerSlot &timeSlot,
+                          const JsonItem::parserTypes parserType);
+    void collectKeysPool_test(TimerSlot &timeSlot,
+                              const JsonItem::parserTypes parserType);
+    void convertDataItem_test(TimerSlot &timeSlot,
+                              const JsonItem &item);
+    void convertToString_test(TimerSlot &timeSlot,
+                              const JsonItem &item);
+    void convertWriteTo_test(TimerSlot &timeSlot,
+                             const JsonItem &item,
+                             const bool indent);
+    void convertCbor_test(TimerSlot &timeSlot,
+                          const JsonItem &item);
+    void convertMsgPack_test(TimerSlot &timeSlot,
+                             const JsonItem &item);
+    void parseCbor_test(TimerSlot &timeSlot,
+                        const std::string &data);
+    void parseMsgPack_test(TimerSlot &timeSlot,
+                           const std::string &data);
+    void hashCanonicalString_test(TimerSlot &timeSlot,
+                                  const JsonItem &item);
+    void hashTree_test(TimerSlot &timeSlot,
+                       const JsonItem &item);
+    void buildTree_test(TimerSlot &timeSlot,
+                        const uint32_t depth,
+                        const bool move);
+
+    const std::string createTestString(const uint32_t numberOfEntries);
+    const std::string createTestLines(const uint32_t numberOfLines);
+    const std::string createTestNumbers(const uint32_t numberOfNumbers);
+    const std::string createTestStrings(const uint32_t numberOfStrings);
+    const std::string createTestRecords(const uint32_t numberOfRecords);
+    const std::string createTestObject(const uint32_t numberOfKeys);
+
+    std::string m_testString = "";
+    std::string m_testLines = "";
+    std::string m_testNumbers = "";
+    std::string m_testStrings = "";
+    std::string m_testRecords = "";
+    std::string m_testObject = "";
+    std::vector<std::string> m_testKeys;
+    JsonItem m_testItem;
+
+    // each benchmark is run this number of times and the thread-benchmarks with each count
+    const uint32_t m_numberOfRuns = 5;
+    const uint32_t m_threadCounts[4] = {1, 2, 4, 8};
+
+    // output of the conversions, which is reused by all runs
+    std::string m_output = "";
+    uint64_t m_outputSize = 0;
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_ITEM_PARSE_BENCHMARK_H
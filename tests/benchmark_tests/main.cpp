@@ -0,0 +1,15 @@
+/**
+ *  @file    main.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include <iostream>
+#include <libKitsunemimiJson/json_item_parse_benchmark.h>
+
+int main()
+{
+    Kitsunemimi::JsonItem_Parse_Benchmark();
+}
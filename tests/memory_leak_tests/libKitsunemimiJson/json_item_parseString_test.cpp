@@ -44,6 +44,10 @@ JsonItem_ParseString_Test::parseString_test()
             "loop: \n"
             "[ {x :\"test1\" }, {x :\"test2\" }, {x :\"test3\" }]\n"
             "}";
+    const std::string duplicateKeyInput =
+            "{\"x\": [1, 2, 3], \"x\": {\"y\": \"test\"}}";
+    const std::string invalidCharInput =
+            "{\"x\": [1, 2, 3], \"y\": \"test\"} #";
 
     ErrorContainer error;
 
@@ -73,6 +77,69 @@ JsonItem_ParseString_Test::parseString_test()
     error._possibleSolution.clear();
     delete paredItem;
     CHECK_MEMORY();
+
+
+    // parse string with duplicate key
+    REINIT_TEST();
+    paredItem = new JsonItem();
+    paredItem->parse(duplicateKeyInput, error);
+    delete paredItem;
+    CHECK_MEMORY();
+
+
+    // parse string with an invalid character behind a complete object
+    REINIT_TEST();
+    paredItem = new JsonItem();
+    paredItem->parse(invalidCharInput, error);
+    error._errorMessages.clear();
+    error._possibleSolution.clear();
+    delete paredItem;
+    CHECK_MEMORY();
+
+
+    // parse valid and invalid strings with the simd-parser
+    REINIT_TEST();
+    paredItem = new JsonItem();
+    paredItem->parse(validInput1, error, JsonItem::SIMD_PARSER);
+    paredItem->parse(duplicateKeyInput, error, JsonItem::SIMD_PARSER);
+    paredItem->parse(invalidInput, error, JsonItem::SIMD_PARSER);
+    paredItem->parse(invalidCharInput, error, JsonItem::SIMD_PARSER);
+    error._errorMessages.clear();
+    error._possibleSolution.clear();
+    delete paredItem;
+    CHECK_MEMORY();
+
+
+    // parse only a part of the string into an item, which points into another tree
+    JsonItem rootItem;
+    rootItem.parse(validInput1, error);
+    REINIT_TEST();
+    JsonItem* viewItem = new JsonItem(rootItem.get("item"));
+    viewItem->parse(validInput1, {"/loop/0"}, error);
+    viewItem->parse("", {"/loop/0"}, error);
+    delete viewItem;
+    CHECK_MEMORY();
+
+
+    // parse in parallel into an item, which points into another tree, where the big array is
+    // parsed by the threads and the small one by the serial fallback
+    std::string bigArrayInput = "[";
+    for(uint32_t i = 0; i < 5000; i++) {
+        bigArrayInput += "{\"x\": " + std::to_string(i) + ", \"y\": \"test\"},";
+    }
+    bigArrayInput += "1]";
+    paredItem = new JsonItem();
+    paredItem->parseParallel(bigArrayInput, error, 2);
+    delete paredItem;
+
+    REINIT_TEST();
+    viewItem = new JsonItem(rootItem.get("item"));
+    viewItem->parseParallel(bigArrayInput, error, 2);
+    delete viewItem;
+    viewItem = new JsonItem(rootItem.get("item"));
+    viewItem->parseParallel(validInput2, error, 2);
+    delete viewItem;
+    CHECK_MEMORY();
 }
 
 }  // namespace Kitsunemimi
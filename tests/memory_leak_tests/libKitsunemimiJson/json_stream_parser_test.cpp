@@ -0,0 +1,75 @@
+/**
+ *  @file    json_stream_parser_test.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include "json_stream_parser_test.h"
+#include <libKitsunemimiJson/json_stream_parser.h>
+#include <libKitsunemimiJson/json_item.h>
+
+namespace Kitsunemimi
+{
+
+JsonStreamParser_Test::JsonStreamParser_Test()
+    : Kitsunemimi::MemoryLeakTestHelpter("JsonStreamParser_Test")
+{
+    feed_test();
+}
+
+/**
+ * feed_test
+ */
+void
+JsonStreamParser_Test::feed_test()
+{
+    const std::string validInput =
+            "{\"x\": [1, 2, {\"y\": \"test\"}], \"x\": {\"z\": [3, 4]}, \"w\": null}";
+    const std::string invalidInput =
+            "{\"x\": [1, 2, {\"y\": \"test\"}], \"x\": {\"z\": [3, 4}}";
+
+    ErrorContainer error;
+
+    // make one untested run to allow the parser to allocate one-time global stuff
+    JsonStreamParser* parser = new JsonStreamParser();
+    JsonItem* result = new JsonItem();
+    parser->feed(validInput.c_str(), validInput.size(), error);
+    parser->finish(*result, error);
+    parser->feed(invalidInput.c_str(), invalidInput.size(), error);
+    parser->reset();
+    error._errorMessages.clear();
+    error._possibleSolution.clear();
+    delete result;
+    delete parser;
+
+    // parse valid input with duplicate key
+    REINIT_TEST();
+    parser = new JsonStreamParser();
+    result = new JsonItem();
+    parser->feed(validInput.c_str(), 20, error);
+    parser->feed(validInput.c_str() + 20, validInput.size() - 20, error);
+    parser->finish(*result, error);
+    delete result;
+    delete parser;
+    CHECK_MEMORY();
+
+    // abort within a duplicate key
+    REINIT_TEST();
+    parser = new JsonStreamParser();
+    parser->feed(invalidInput.c_str(), invalidInput.size(), error);
+    error._errorMessages.clear();
+    error._possibleSolution.clear();
+    delete parser;
+    CHECK_MEMORY();
+
+    // incomplete input without finish
+    REINIT_TEST();
+    parser = new JsonStreamParser();
+    parser->feed(validInput.c_str(), 42, error);
+    delete parser;
+    CHECK_MEMORY();
+}
+
+}  // namespace Kitsunemimi
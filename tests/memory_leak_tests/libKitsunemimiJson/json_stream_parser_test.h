@@ -0,0 +1,28 @@
+/**
+ *  @file    json_stream_parser_test.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_STREAM_PARSER_TEST_H
+#define JSON_STREAM_PARSER_TEST_H
+
+#include <libKitsunemimiCommon/test_helper/memory_leak_test_helper.h>
+
+namespace Kitsunemimi
+{
+class JsonStreamParser_Test
+        : public Kitsunemimi::MemoryLeakTestHelpter
+{
+public:
+    JsonStreamParser_Test();
+
+private:
+    void feed_test();
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_STREAM_PARSER_TEST_H
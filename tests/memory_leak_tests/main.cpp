@@ -9,9 +9,11 @@
 #include <iostream>
 #include <libKitsunemimiJson/json_item_parseString_test.h>
 #include <libKitsunemimiJson/json_item_test.h>
+#include <libKitsunemimiJson/json_stream_parser_test.h>
 
 int main()
 {
     Kitsunemimi::JsonItem_ParseString_Test();
     Kitsunemimi::JsonItem_Test();
+    Kitsunemimi::JsonStreamParser_Test();
 }
@@ -16,9 +16,11 @@ INCLUDEPATH += ../../../libKitsunemimiCommon/include
 SOURCES += \
     main.cpp \
     libKitsunemimiJson/json_item_parseString_test.cpp \
-    libKitsunemimiJson/json_item_test.cpp
+    libKitsunemimiJson/json_item_test.cpp \
+    libKitsunemimiJson/json_stream_parser_test.cpp
 
 HEADERS += \
     libKitsunemimiJson/json_item_parseString_test.h \
-    libKitsunemimiJson/json_item_test.h
+    libKitsunemimiJson/json_item_test.h \
+    libKitsunemimiJson/json_stream_parser_test.h
 
@@ -5,6 +5,7 @@ CONFIG += c++17
 
 SUBDIRS = \
     unit_tests \
-    memory_leak_tests
+    memory_leak_tests \
+    benchmark_tests
 
 tests.depends = src
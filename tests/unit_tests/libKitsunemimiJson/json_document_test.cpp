@@ -0,0 +1,146 @@
+/**
+ *  @file    json_document_test.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include "json_document_test.h"
+#include <libKitsunemimiJson/json_document.h>
+
+namespace Kitsunemimi
+{
+
+const std::string testInput("{\"item\": {\"sub_item\": \"test_value\", \"list\": [1, [2, \"]\"], 3]},"
+                            " \"loop\": [{\"x\": 42}, {\"x\": 42.5}, 1234, {\"x\": -42.0, y: true}],"
+                            " key_pln: a.b-c,"
+                            " \"null_value\": null,"
+                            " \"item\": \"duplicate\"}");
+
+JsonDocument_Test::JsonDocument_Test()
+    : Kitsunemimi::CompareTestHelper("JsonDocument_Test")
+{
+    parse_test();
+    get_test();
+    checks_test();
+    toJsonItem_test();
+}
+
+/**
+ * parse_test
+ */
+void
+JsonDocument_Test::parse_test()
+{
+    JsonDocument document;
+    ErrorContainer error;
+
+    // positive test
+    TEST_EQUAL(document.parse(testInput, error), true);
+    TEST_EQUAL(document.getRoot().isMap(), true);
+    TEST_EQUAL(document.parse("[1, 2]", error), true);
+    TEST_EQUAL(document.getRoot().isArray(), true);
+    TEST_EQUAL(document.parse("", error), true);
+    TEST_EQUAL(document.getRoot().isMap(), true);
+    TEST_EQUAL(document.getRoot().size(), 0);
+
+    // negative test
+    TEST_EQUAL(document.parse("{\"x\": [1, 2}", error), false);
+    TEST_EQUAL(document.getRoot().isValid(), false);
+    TEST_EQUAL(document.parse("null", error), false);
+    TEST_EQUAL(document.getRoot().isValid(), false);
+}
+
+/**
+ * get_test
+ */
+void
+JsonDocument_Test::get_test()
+{
+    JsonDocument document;
+    ErrorContainer error;
+    TEST_EQUAL(document.parse(testInput, error), true);
+
+    // get by key, where the first value of a duplicate key is used
+    TEST_EQUAL(document["item"]["sub_item"].getString(), "test_value");
+    TEST_EQUAL(document["item"].get("list").get(1).get(1).getString(), "]");
+    TEST_EQUAL(document["item"]["list"][2].getInt(), 3);
+    TEST_EQUAL(document["key_pln"].getString(), "a.b-c");
+
+    // get by index
+    TEST_EQUAL(document["loop"][0]["x"].getLong(), 42);
+    TEST_EQUAL(document["loop"][1]["x"].getDouble(), 42.5);
+    TEST_EQUAL(document["loop"][1]["x"].getFloat(), 42.5f);
+    TEST_EQUAL(document["loop"][2].getInt(), 1234);
+    TEST_EQUAL(document["loop"][3]["y"].getBool(), true);
+
+    // size and keys
+    TEST_EQUAL(document.getRoot().size(), 4);
+    TEST_EQUAL(document["loop"].size(), 4);
+    TEST_EQUAL(document["item"]["list"].size(), 3);
+    const std::vector<std::string> keys = document.getRoot().getKeys();
+    TEST_EQUAL(keys.size(), 4);
+    TEST_EQUAL(keys.at(0), "item");
+    TEST_EQUAL(keys.at(1), "key_pln");
+    TEST_EQUAL(document.getRoot().contains("loop"), true);
+    TEST_EQUAL(document.getRoot().contains("fail"), false);
+
+    // negative test
+    TEST_EQUAL(document["fail"].isValid(), false);
+    TEST_EQUAL(document["loop"][4].isValid(), false);
+    TEST_EQUAL(document["loop"]["x"].isValid(), false);
+    TEST_EQUAL(document["item"][0].isValid(), false);
+    TEST_EQUAL(document["fail"]["x"][1].getString(), "");
+    TEST_EQUAL(document["loop"].getString(), "");
+    TEST_EQUAL(document["loop"][2].getString(), "");
+    TEST_EQUAL(document["key_pln"].getInt(), 0);
+}
+
+/**
+ * checks_test
+ */
+void
+JsonDocument_Test::checks_test()
+{
+    JsonDocument document;
+    ErrorContainer error;
+    TEST_EQUAL(document.parse(testInput, error), true);
+
+    TEST_EQUAL(document["item"].isMap(), true);
+    TEST_EQUAL(document["item"].isArray(), false);
+    TEST_EQUAL(document["loop"].isArray(), true);
+    TEST_EQUAL(document["loop"].isValue(), false);
+    TEST_EQUAL(document["key_pln"].isValue(), true);
+    TEST_EQUAL(document["key_pln"].isString(), true);
+    TEST_EQUAL(document["loop"][2].isInteger(), true);
+    TEST_EQUAL(document["loop"][2].isFloat(), false);
+    TEST_EQUAL(document["loop"][1]["x"].isFloat(), true);
+    TEST_EQUAL(document["loop"][3]["y"].isBool(), true);
+    TEST_EQUAL(document["null_value"].isNull(), true);
+    TEST_EQUAL(document["null_value"].isValid(), false);
+    TEST_EQUAL(document["null_value"].isValue(), false);
+}
+
+/**
+ * toJsonItem_test
+ */
+void
+JsonDocument_Test::toJsonItem_test()
+{
+    JsonDocument document;
+    ErrorContainer error;
+    TEST_EQUAL(document.parse(testInput, error), true);
+
+    JsonItem completeItem;
+    TEST_EQUAL(completeItem.parse(testInput, error), true);
+
+    TEST_EQUAL(document.getRoot().toString(), completeItem.toString());
+    TEST_EQUAL(document["loop"].toString(true), completeItem["loop"].toString(true));
+    TEST_EQUAL(document["loop"][2].toJsonItem().getInt(), 1234);
+    TEST_EQUAL(document["loop"][3]["y"].toJsonItem().getBool(), true);
+    TEST_EQUAL(document["key_pln"].toJsonItem().getString(), "a.b-c");
+    TEST_EQUAL(document["null_value"].toJsonItem().isValid(), false);
+}
+
+}  // namespace Kitsunemimi
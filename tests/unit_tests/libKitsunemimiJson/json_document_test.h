@@ -0,0 +1,31 @@
+/**
+ *  @file    json_document_test.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_DOCUMENT_TEST_H
+#define JSON_DOCUMENT_TEST_H
+
+#include <libKitsunemimiCommon/test_helper/compare_test_helper.h>
+
+namespace Kitsunemimi
+{
+class JsonDocument_Test
+        : public Kitsunemimi::CompareTestHelper
+{
+public:
+    JsonDocument_Test();
+
+private:
+    void parse_test();
+    void get_test();
+    void checks_test();
+    void toJsonItem_test();
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_DOCUMENT_TEST_H
@@ -0,0 +1,239 @@
+/**
+ *  @file    json_handler_test.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include "json_handler_test.h"
+#include <libKitsunemimiJson/json_handler.h>
+#include <libKitsunemimiJson/json_tree_handler.h>
+#include <libKitsunemimiJson/json_stream_parser.h>
+#include <libKitsunemimiJson/json_key_pool.h>
+#include <libKitsunemimiCommon/items/data_items.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief handler, which writes all events into a string and can abort after a number of events
+ */
+class RecordingHandler
+        : public JsonHandler
+{
+public:
+    std::string events = "";
+    uint32_t numberOfEvents = 0;
+    uint32_t abortAfter = 0xFFFFFFFF;
+
+    bool startObject() { return record("{"); }
+    bool key(const std::string &key) { return record("k:" + key); }
+    bool endObject() { return record("}"); }
+    bool startArray() { return record("["); }
+    bool endArray() { return record("]"); }
+    bool stringValue(const std::string &value) { return record("s:" + value); }
+    bool integerValue(const long value) { return record("i:" + std::to_string(value)); }
+    bool doubleValue(const double value) { return record("d:" + std::to_string(value)); }
+    bool boolValue(const bool value) { return record(value ? "true" : "false"); }
+    bool nullValue() { return record("null"); }
+
+private:
+    bool record(const std::string &event)
+    {
+        numberOfEvents++;
+        events += event + " ";
+        return numberOfEvents < abortAfter;
+    }
+};
+
+/**
+ * @brief handler, which counts the keys, which are the same string-object like a specific key
+ */
+class KeyCountHandler
+        : public JsonHandler
+{
+public:
+    const std::string* searchedKey = nullptr;
+    uint32_t numberOfKeys = 0;
+    uint32_t numberOfMatches = 0;
+
+    bool key(const std::string &key)
+    {
+        numberOfKeys++;
+        if(&key == searchedKey) {
+            numberOfMatches++;
+        }
+        return true;
+    }
+};
+
+JsonHandler_Test::JsonHandler_Test()
+    : Kitsunemimi::CompareTestHelper("JsonHandler_Test")
+{
+    events_test();
+    abort_test();
+    treeHandler_test();
+    keyPool_test();
+}
+
+/**
+ * events_test
+ */
+void
+JsonHandler_Test::events_test()
+{
+    const std::string input("{\"item\": {sub_item: \"test_value\"},"
+                            "\"loop\": [1, -2.5, true, false, null, a.b-c, {}, []]}");
+    const std::string expectedEvents("{ k:item { k:sub_item s:test_value } "
+                                     "k:loop [ i:1 d:-2.500000 true false null s:a.b-c "
+                                     "{ } [ ] ] } ");
+    ErrorContainer error;
+
+    RecordingHandler bisonHandler;
+    TEST_EQUAL(parseJson(input, bisonHandler, error, JsonItem::BISON_PARSER), true);
+    TEST_EQUAL(bisonHandler.events, expectedEvents);
+
+    RecordingHandler simdHandler;
+    TEST_EQUAL(parseJson(input, simdHandler, error, JsonItem::SIMD_PARSER), true);
+    TEST_EQUAL(simdHandler.events, expectedEvents);
+
+    RecordingHandler streamHandler;
+    JsonStreamParser streamParser(streamHandler);
+    TEST_EQUAL(streamParser.feed(input.c_str(), 20, error), true);
+    TEST_EQUAL(streamParser.feed(input.c_str() + 20, input.size() - 20, error), true);
+    TEST_EQUAL(streamParser.finish(error), true);
+    TEST_EQUAL(streamHandler.events, expectedEvents);
+
+    // the default-handler ignores all events
+    JsonHandler emptyHandler;
+    TEST_EQUAL(parseJson(input, emptyHandler, error), true);
+
+    // negative test
+    TEST_EQUAL(parseJson("{\"x\": [1, 2}", emptyHandler, error, JsonItem::BISON_PARSER), false);
+    TEST_EQUAL(parseJson("{\"x\": [1, 2}", emptyHandler, error, JsonItem::SIMD_PARSER), false);
+}
+
+/**
+ * abort_test
+ */
+void
+JsonHandler_Test::abort_test()
+{
+    const std::string input("{\"first\": 1, \"second\": [2, 3], \"third\": 4}");
+    ErrorContainer error;
+
+    // abort after the value of the second key
+    RecordingHandler bisonHandler;
+    bisonHandler.abortAfter = 4;
+    TEST_EQUAL(parseJson(input, bisonHandler, error, JsonItem::BISON_PARSER), false);
+    TEST_EQUAL(bisonHandler.numberOfEvents, 4);
+
+    RecordingHandler simdHandler;
+    simdHandler.abortAfter = 4;
+    TEST_EQUAL(parseJson(input, simdHandler, error, JsonItem::SIMD_PARSER), false);
+    TEST_EQUAL(simdHandler.numberOfEvents, 4);
+
+    RecordingHandler streamHandler;
+    streamHandler.abortAfter = 4;
+    JsonStreamParser streamParser(streamHandler);
+    TEST_EQUAL(streamParser.feed(input.c_str(), input.size(), error), false);
+    TEST_EQUAL(streamHandler.numberOfEvents, 4);
+}
+
+/**
+ * treeHandler_test
+ */
+void
+JsonHandler_Test::treeHandler_test()
+{
+    const std::string input("{\"x\": [1, 2], \"x\": {\"y\": 3}, \"z\": \"test\"}");
+    ErrorContainer error;
+
+    // the built-in handler creates the same tree like the json-item and keeps the first value
+    // of a duplicate key
+    JsonTreeHandler handler;
+    TEST_EQUAL(parseJson(input, handler, error), true);
+    DataItem* result = handler.stealResult();
+    TEST_EQUAL(result != nullptr, true);
+    if(result == nullptr) {
+        return;
+    }
+
+    JsonItem item;
+    TEST_EQUAL(item.parse(input, error), true);
+    TEST_EQUAL(result->toString(), item.toString());
+    TEST_EQUAL(result->toString(), std::string("{\"x\":[1,2],\"z\":\"test\"}"));
+    delete result;
+
+    // incomplete tree after an error
+    TEST_EQUAL(parseJson("[1, [2, 3", handler, error), false);
+    TEST_EQUAL(handler.stealResult() == nullptr, true);
+}
+
+/**
+ * keyPool_test
+ */
+void
+JsonHandler_Test::keyPool_test()
+{
+    const std::string input("[{\"identifier\": 1, name: \"a\"},"
+                            " {\"identifier\": 2, name: \"b\"},"
+                            " {\"ident\\u0069fier\": 3, \"name\": \"c\"}]");
+    ErrorContainer error;
+
+    JsonKeyPool pool;
+    const std::string* identifier = pool.intern("identifier");
+    TEST_EQUAL(identifier != nullptr, true);
+    TEST_EQUAL(pool.find("identifier") == identifier, true);
+    TEST_EQUAL(pool.find("name") == nullptr, true);
+    TEST_EQUAL(pool.getNumberOfKeys(), 1);
+
+    // all parsers forward the interned key, also for keys without quotes or with escapes
+    KeyCountHandler bisonHandler;
+    bisonHandler.searchedKey = identifier;
+    TEST_EQUAL(parseJson(input, bisonHandler, error, JsonItem::BISON_PARSER, false, &pool), true);
+    TEST_EQUAL(bisonHandler.numberOfKeys, 6);
+    TEST_EQUAL(bisonHandler.numberOfMatches, 3);
+
+    KeyCountHandler simdHandler;
+    simdHandler.searchedKey = identifier;
+    TEST_EQUAL(parseJson(input, simdHandler, error, JsonItem::SIMD_PARSER, false, &pool), true);
+    TEST_EQUAL(simdHandler.numberOfKeys, 6);
+    TEST_EQUAL(simdHandler.numberOfMatches, 3);
+
+    KeyCountHandler streamHandler;
+    streamHandler.searchedKey = identifier;
+    JsonStreamParser streamParser(streamHandler, false, &pool);
+    for(uint64_t i = 0; i < input.size(); i++) {
+        streamParser.feed(&input[i], 1, error);
+    }
+    TEST_EQUAL(streamParser.finish(error), true);
+    TEST_EQUAL(streamHandler.numberOfKeys, 6);
+    TEST_EQUAL(streamHandler.numberOfMatches, 3);
+
+    // statistics: only the first "name" was new, all other 17 keys were found in the pool
+    TEST_EQUAL(pool.getNumberOfKeys(), 2);
+    TEST_EQUAL(pool.getNumberOfHits(), 17);
+    TEST_EQUAL(pool.getSavedBytes(), 9 * 10 + 8 * 4);
+
+    // without pool the handler gets other string-objects
+    KeyCountHandler plainHandler;
+    plainHandler.searchedKey = identifier;
+    TEST_EQUAL(parseJson(input, plainHandler, error, JsonItem::SIMD_PARSER), true);
+    TEST_EQUAL(plainHandler.numberOfMatches, 0);
+
+    // a full pool doesn't add new keys, but the parsing still works
+    JsonKeyPool smallPool(1);
+    KeyCountHandler smallHandler;
+    TEST_EQUAL(parseJson(input, smallHandler, error, JsonItem::SIMD_PARSER, false, &smallPool),
+               true);
+    TEST_EQUAL(smallHandler.numberOfKeys, 6);
+    TEST_EQUAL(smallPool.getNumberOfKeys(), 1);
+
+    pool.clear();
+    TEST_EQUAL(pool.getNumberOfKeys(), 0);
+    TEST_EQUAL(pool.getSavedBytes(), 0);
+}
+
+}  // namespace Kitsunemimi
@@ -0,0 +1,31 @@
+/**
+ *  @file    json_handler_test.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_HANDLER_TEST_H
+#define JSON_HANDLER_TEST_H
+
+#include <libKitsunemimiCommon/test_helper/compare_test_helper.h>
+
+namespace Kitsunemimi
+{
+class JsonHandler_Test
+        : public Kitsunemimi::CompareTestHelper
+{
+public:
+    JsonHandler_Test();
+
+private:
+    void events_test();
+    void abort_test();
+    void treeHandler_test();
+    void keyPool_test();
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_HANDLER_TEST_H
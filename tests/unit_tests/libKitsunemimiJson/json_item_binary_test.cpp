@@ -0,0 +1,331 @@
+/**
+ *  @file    json_item_binary_test.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include "json_item_binary_test.h"
+#include <libKitsunemimiJson/json_item.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief convert a hex-string into binary data
+ */
+static const std::string
+fromHex(const std::string &hex)
+{
+    std::string result = "";
+    for(uint64_t i = 0; i + 1 < hex.size(); i += 2) {
+        result.push_back(static_cast<char>(std::stoi(hex.substr(i, 2), nullptr, 16)));
+    }
+
+    return result;
+}
+
+/**
+ * @brief convert binary data into a hex-string
+ */
+static const std::string
+toHex(const std::string &data)
+{
+    const char digits[] = "0123456789abcdef";
+    std::string result = "";
+    for(const char c : data)
+    {
+        result.push_back(digits[static_cast<uint8_t>(c) >> 4]);
+        result.push_back(digits[static_cast<uint8_t>(c) & 0x0f]);
+    }
+
+    return result;
+}
+
+JsonItem_Binary_Test::JsonItem_Binary_Test()
+    : Kitsunemimi::CompareTestHelper("JsonItem_Binary_Test")
+{
+    toCbor_test();
+    fromCbor_test();
+    toMsgPack_test();
+    fromMsgPack_test();
+    roundTrip_test();
+    invalidInput_test();
+}
+
+/**
+ * toCbor_test
+ */
+void
+JsonItem_Binary_Test::toCbor_test()
+{
+    // examples of the appendix of RFC 8949
+    TEST_EQUAL(toHex(JsonItem(0).toCbor()), std::string("00"));
+    TEST_EQUAL(toHex(JsonItem(23).toCbor()), std::string("17"));
+    TEST_EQUAL(toHex(JsonItem(24).toCbor()), std::string("1818"));
+    TEST_EQUAL(toHex(JsonItem(1000).toCbor()), std::string("1903e8"));
+    TEST_EQUAL(toHex(JsonItem(1000000).toCbor()), std::string("1a000f4240"));
+    TEST_EQUAL(toHex(JsonItem(1000000000000l).toCbor()), std::string("1b000000e8d4a51000"));
+    TEST_EQUAL(toHex(JsonItem(-1).toCbor()), std::string("20"));
+    TEST_EQUAL(toHex(JsonItem(-1000).toCbor()), std::string("3903e7"));
+    TEST_EQUAL(toHex(JsonItem(1.5).toCbor()), std::string("fa3fc00000"));
+    TEST_EQUAL(toHex(JsonItem(100000.0).toCbor()), std::string("fa47c35000"));
+    TEST_EQUAL(toHex(JsonItem(1.1).toCbor()), std::string("fb3ff199999999999a"));
+    TEST_EQUAL(toHex(JsonItem(-4.1).toCbor()), std::string("fbc010666666666666"));
+    TEST_EQUAL(toHex(JsonItem(false).toCbor()), std::string("f4"));
+    TEST_EQUAL(toHex(JsonItem(true).toCbor()), std::string("f5"));
+    TEST_EQUAL(toHex(JsonItem("").toCbor()), std::string("60"));
+    TEST_EQUAL(toHex(JsonItem("IETF").toCbor()), std::string("6449455446"));
+    TEST_EQUAL(toHex(JsonItem("\xc3\xbc").toCbor()), std::string("62c3bc"));
+    TEST_EQUAL(toHex(JsonItem().toCbor()), std::string("f6"));
+
+    // limits of long
+    TEST_EQUAL(toHex(JsonItem(9223372036854775807l).toCbor()),
+               std::string("1b7fffffffffffffff"));
+    TEST_EQUAL(toHex(JsonItem(-9223372036854775807l - 1).toCbor()),
+               std::string("3b7fffffffffffffff"));
+
+    // maps and arrays
+    JsonItem item;
+    ErrorContainer error;
+    TEST_EQUAL(item.parse("[1, [2, 3], [4, 5]]", error), true);
+    TEST_EQUAL(toHex(item.toCbor()), std::string("8301820203820405"));
+    TEST_EQUAL(item.parse("{\"a\": 1, \"b\": [2, 3]}", error), true);
+    TEST_EQUAL(toHex(item.toCbor()), std::string("a26161016162820203"));
+    TEST_EQUAL(item.parse("[\"a\", {\"b\": \"c\"}, null]", error), true);
+    TEST_EQUAL(toHex(item.toCbor()), std::string("836161a161626163f6"));
+    TEST_EQUAL(item.parse("[]", error), true);
+    TEST_EQUAL(toHex(item.toCbor()), std::string("80"));
+    TEST_EQUAL(item.parse("{}", error), true);
+    TEST_EQUAL(toHex(item.toCbor()), std::string("a0"));
+}
+
+/**
+ * fromCbor_test
+ */
+void
+JsonItem_Binary_Test::fromCbor_test()
+{
+    JsonItem item;
+    ErrorContainer error;
+
+    // definite length
+    TEST_EQUAL(item.fromCbor(fromHex("a26161016162820203"), error), true);
+    TEST_EQUAL(item.toString(), std::string("{\"a\":1,\"b\":[2,3]}"));
+    TEST_EQUAL(item.fromCbor(fromHex("3903e7"), error), true);
+    TEST_EQUAL(item.getLong(), -1000);
+    TEST_EQUAL(item.fromCbor(fromHex("3b7fffffffffffffff"), error), true);
+    TEST_EQUAL(item.getLong(), -9223372036854775807l - 1);
+    TEST_EQUAL(item.fromCbor(fromHex("6449455446"), error), true);
+    TEST_EQUAL(item.getString(), std::string("IETF"));
+
+    // half, single and double precision
+    TEST_EQUAL(item.fromCbor(fromHex("83f93e00fa47c35000fb3ff199999999999a"), error), true);
+    TEST_EQUAL(item.get(0).getDouble(), 1.5);
+    TEST_EQUAL(item.get(1).getDouble(), 100000.0);
+    TEST_EQUAL(item.get(2).getDouble(), 1.1);
+    TEST_EQUAL(item.fromCbor(fromHex("f90001"), error), true);
+    TEST_EQUAL(item.getDouble(), 5.960464477539063e-8);
+    TEST_EQUAL(item.fromCbor(fromHex("f9c400"), error), true);
+    TEST_EQUAL(item.getDouble(), -4.0);
+
+    // simple values, where undefined is handled like null
+    TEST_EQUAL(item.fromCbor(fromHex("84f4f5f6f7"), error), true);
+    TEST_EQUAL(item.toString(), std::string("[false,true,null,null]"));
+
+    // indefinite length
+    TEST_EQUAL(item.fromCbor(fromHex("9f018202039f0405ffff"), error), true);
+    TEST_EQUAL(item.toString(), std::string("[1,[2,3],[4,5]]"));
+    TEST_EQUAL(item.fromCbor(fromHex("bf61610161629f0203ffff"), error), true);
+    TEST_EQUAL(item.toString(), std::string("{\"a\":1,\"b\":[2,3]}"));
+    TEST_EQUAL(item.fromCbor(fromHex("7f657374726561646d696e67ff"), error), true);
+    TEST_EQUAL(item.getString(), std::string("streaming"));
+    TEST_EQUAL(item.fromCbor(fromHex("bf7f6161626263ff01ff"), error), true);
+    TEST_EQUAL(item.toString(), std::string("{\"abc\":1}"));
+
+    // tags are ignored and byte-strings are handled like normal strings
+    TEST_EQUAL(item.fromCbor(fromHex("c074323031332d30332d32315432303a30343a30305a"), error),
+               true);
+    TEST_EQUAL(item.getString(), std::string("2013-03-21T20:04:00Z"));
+    TEST_EQUAL(item.fromCbor(fromHex("a1d82043616263c11a514b67b0"), error), true);
+    TEST_EQUAL(item.toString(), std::string("{\"abc\":1363896240}"));
+
+    // the first value of duplicate keys is used, like in the json-parsers
+    TEST_EQUAL(item.fromCbor(fromHex("a2616101616102"), error), true);
+    TEST_EQUAL(item.toString(), std::string("{\"a\":1}"));
+}
+
+/**
+ * toMsgPack_test
+ */
+void
+JsonItem_Binary_Test::toMsgPack_test()
+{
+    // integers with the smallest possible type
+    TEST_EQUAL(toHex(JsonItem(0).toMsgPack()), std::string("00"));
+    TEST_EQUAL(toHex(JsonItem(127).toMsgPack()), std::string("7f"));
+    TEST_EQUAL(toHex(JsonItem(128).toMsgPack()), std::string("cc80"));
+    TEST_EQUAL(toHex(JsonItem(256).toMsgPack()), std::string("cd0100"));
+    TEST_EQUAL(toHex(JsonItem(65536).toMsgPack()), std::string("ce00010000"));
+    TEST_EQUAL(toHex(JsonItem(4294967296l).toMsgPack()), std::string("cf0000000100000000"));
+    TEST_EQUAL(toHex(JsonItem(-1).toMsgPack()), std::string("ff"));
+    TEST_EQUAL(toHex(JsonItem(-32).toMsgPack()), std::string("e0"));
+    TEST_EQUAL(toHex(JsonItem(-33).toMsgPack()), std::string("d0df"));
+    TEST_EQUAL(toHex(JsonItem(-129).toMsgPack()), std::string("d1ff7f"));
+    TEST_EQUAL(toHex(JsonItem(-32769).toMsgPack()), std::string("d2ffff7fff"));
+    TEST_EQUAL(toHex(JsonItem(-2147483649l).toMsgPack()), std::string("d3ffffffff7fffffff"));
+
+    // other values
+    TEST_EQUAL(toHex(JsonItem(1.5).toMsgPack()), std::string("ca3fc00000"));
+    TEST_EQUAL(toHex(JsonItem(1.1).toMsgPack()), std::string("cb3ff199999999999a"));
+    TEST_EQUAL(toHex(JsonItem(false).toMsgPack()), std::string("c2"));
+    TEST_EQUAL(toHex(JsonItem(true).toMsgPack()), std::string("c3"));
+    TEST_EQUAL(toHex(JsonItem().toMsgPack()), std::string("c0"));
+    TEST_EQUAL(toHex(JsonItem("abc").toMsgPack()), std::string("a3616263"));
+
+    // strings, maps and arrays with a length, which doesn't fit into the type-byte
+    const std::string longString(32, 'x');
+    TEST_EQUAL(toHex(JsonItem(longString).toMsgPack()).substr(0, 4), std::string("d920"));
+    const std::string veryLongString(256, 'x');
+    TEST_EQUAL(toHex(JsonItem(veryLongString).toMsgPack()).substr(0, 6), std::string("da0100"));
+
+    JsonItem item;
+    ErrorContainer error;
+    TEST_EQUAL(item.parse("{\"compact\": true, \"schema\": 0}", error), true);
+    TEST_EQUAL(toHex(item.toMsgPack()), std::string("82a7636f6d70616374c3a6736368656d6100"));
+    TEST_EQUAL(item.parse("[1, [2, 3], {}]", error), true);
+    TEST_EQUAL(toHex(item.toMsgPack()), std::string("930192020380"));
+    TEST_EQUAL(item.parse("[0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15]", error), true);
+    TEST_EQUAL(toHex(item.toMsgPack()).substr(0, 6), std::string("dc0010"));
+}
+
+/**
+ * fromMsgPack_test
+ */
+void
+JsonItem_Binary_Test::fromMsgPack_test()
+{
+    JsonItem item;
+    ErrorContainer error;
+
+    TEST_EQUAL(item.fromMsgPack(fromHex("82a7636f6d70616374c3a6736368656d6100"), error), true);
+    TEST_EQUAL(item.toString(), std::string("{\"compact\":true,\"schema\":0}"));
+
+    // all integer-types
+    TEST_EQUAL(item.fromMsgPack(fromHex("9a7fe0cc80cd0100ce00010000cf0000000100000000"
+                                        "d0dfd1ff7fd2ffff7fffd3ffffffff7fffffff"), error), true);
+    TEST_EQUAL(item.toString(), std::string("[127,-32,128,256,65536,4294967296,"
+                                            "-33,-129,-32769,-2147483649]"));
+
+    // floating-point-values, null and bool
+    TEST_EQUAL(item.fromMsgPack(fromHex("95ca3fc00000cb3ff199999999999ac0c2c3"), error), true);
+    TEST_EQUAL(item.get(0).getDouble(), 1.5);
+    TEST_EQUAL(item.get(1).getDouble(), 1.1);
+    TEST_EQUAL(item.toString(), std::string("[1.5,1.1,null,false,true]"));
+
+    // all string-types, where byte-strings are handled like normal strings
+    TEST_EQUAL(item.fromMsgPack(fromHex("96a161d90162da000163db0000000164"
+                                        "c40165c5000166"), error), true);
+    TEST_EQUAL(item.toString(), std::string("[\"a\",\"b\",\"c\",\"d\",\"e\",\"f\"]"));
+    TEST_EQUAL(item.fromMsgPack(fromHex("91c6000000026767"), error), true);
+    TEST_EQUAL(item.toString(), std::string("[\"gg\"]"));
+
+    // maps and arrays with 16- and 32-bit length
+    TEST_EQUAL(item.fromMsgPack(fromHex("dc0002de0001a16101dd00000001df00000000"), error),
+               true);
+    TEST_EQUAL(item.toString(), std::string("[{\"a\":1},[{}]]"));
+}
+
+/**
+ * roundTrip_test
+ */
+void
+JsonItem_Binary_Test::roundTrip_test()
+{
+    const std::string input = "{\"name\": \"test\", \"values\": [1, -2, 3.5, 1e-07, true, null],"
+                              " \"nested\": {\"list\": [{\"x\": 9223372036854775807},"
+                              " {\"y\": \"\\u00fc\\n\"}], \"empty\": []},"
+                              " \"big\": 1.7976931348623157e+308}";
+    JsonItem item;
+    ErrorContainer error;
+    TEST_EQUAL(item.parse(input, error), true);
+
+    JsonItem cborItem;
+    const std::string cbor = item.toCbor();
+    TEST_EQUAL(cborItem.fromCbor(cbor, error), true);
+    TEST_EQUAL(cborItem.toString(), item.toString());
+    TEST_EQUAL(cborItem.toCbor(), cbor);
+
+    JsonItem msgPackItem;
+    const std::string msgPack = item.toMsgPack();
+    TEST_EQUAL(msgPackItem.fromMsgPack(msgPack, error), true);
+    TEST_EQUAL(msgPackItem.toString(), item.toString());
+    TEST_EQUAL(msgPackItem.toMsgPack(), msgPack);
+
+    // the binary formats are smaller than the json-string
+    TEST_EQUAL(cbor.size() < item.toString().size(), true);
+    TEST_EQUAL(msgPack.size() < item.toString().size(), true);
+
+    // long strings and many entries
+    JsonItem bigItem;
+    TEST_EQUAL(bigItem.parse("[]", error), true);
+    for(uint32_t i = 0; i < 70000; i++) {
+        bigItem.append(JsonItem(static_cast<long>(i) * 70000));
+    }
+    JsonItem mapItem;
+    TEST_EQUAL(mapItem.parse("{}", error), true);
+    mapItem.insert(std::string(70000, 'k'), bigItem);
+    mapItem.insert("s", JsonItem(std::string(300, 's')));
+
+    TEST_EQUAL(cborItem.fromCbor(mapItem.toCbor(), error), true);
+    TEST_EQUAL(cborItem.toString(), mapItem.toString());
+    TEST_EQUAL(msgPackItem.fromMsgPack(mapItem.toMsgPack(), error), true);
+    TEST_EQUAL(msgPackItem.toString(), mapItem.toString());
+}
+
+/**
+ * invalidInput_test
+ */
+void
+JsonItem_Binary_Test::invalidInput_test()
+{
+    JsonItem item;
+    ErrorContainer error;
+    TEST_EQUAL(item.parse("{\"x\": 1}", error), true);
+
+    // cbor
+    TEST_EQUAL(item.fromCbor("", error), false);
+    TEST_EQUAL(item.fromCbor(fromHex("8201"), error), false);
+    TEST_EQUAL(item.fromCbor(fromHex("0000"), error), false);
+    TEST_EQUAL(item.fromCbor(fromHex("a10101"), error), false);
+    TEST_EQUAL(item.fromCbor(fromHex("ff"), error), false);
+    TEST_EQUAL(item.fromCbor(fromHex("9f01"), error), false);
+    TEST_EQUAL(item.fromCbor(fromHex("1f"), error), false);
+    TEST_EQUAL(item.fromCbor(fromHex("1c"), error), false);
+    TEST_EQUAL(item.fromCbor(fromHex("f6"), error), false);
+    TEST_EQUAL(item.fromCbor(fromHex("f0"), error), false);
+    TEST_EQUAL(item.fromCbor(fromHex("f97c00"), error), false);
+    TEST_EQUAL(item.fromCbor(fromHex("1b8000000000000000"), error), false);
+    TEST_EQUAL(item.fromCbor(fromHex("3b8000000000000000"), error), false);
+    TEST_EQUAL(item.fromCbor(fromHex("7affffffff61"), error), false);
+    TEST_EQUAL(item.fromCbor(fromHex("7f61610102ff"), error), false);
+    TEST_EQUAL(item.fromCbor(fromHex("bf6161ff"), error), false);
+
+    // msgpack
+    TEST_EQUAL(item.fromMsgPack("", error), false);
+    TEST_EQUAL(item.fromMsgPack(fromHex("9201"), error), false);
+    TEST_EQUAL(item.fromMsgPack(fromHex("0101"), error), false);
+    TEST_EQUAL(item.fromMsgPack(fromHex("810101"), error), false);
+    TEST_EQUAL(item.fromMsgPack(fromHex("c1"), error), false);
+    TEST_EQUAL(item.fromMsgPack(fromHex("c0"), error), false);
+    TEST_EQUAL(item.fromMsgPack(fromHex("d40100"), error), false);
+    TEST_EQUAL(item.fromMsgPack(fromHex("cf8000000000000000"), error), false);
+    TEST_EQUAL(item.fromMsgPack(fromHex("cb7ff8000000000000"), error), false);
+    TEST_EQUAL(item.fromMsgPack(fromHex("dbffffffff61"), error), false);
+
+    // the item keeps its content in case of an error
+    TEST_EQUAL(item.toString(), std::string("{\"x\":1}"));
+}
+
+}  // namespace Kitsunemimi
@@ -0,0 +1,33 @@
+/**
+ *  @file    json_item_binary_test.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_ITEM_BINARY_TEST_H
+#define JSON_ITEM_BINARY_TEST_H
+
+#include <libKitsunemimiCommon/test_helper/compare_test_helper.h>
+
+namespace Kitsunemimi
+{
+class JsonItem_Binary_Test
+        : public Kitsunemimi::CompareTestHelper
+{
+public:
+    JsonItem_Binary_Test();
+
+private:
+    void toCbor_test();
+    void fromCbor_test();
+    void toMsgPack_test();
+    void fromMsgPack_test();
+    void roundTrip_test();
+    void invalidInput_test();
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_ITEM_BINARY_TEST_H
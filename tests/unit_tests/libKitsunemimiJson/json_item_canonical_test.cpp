@@ -0,0 +1,205 @@
+/**
+ *  @file    json_item_canonical_test.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include "json_item_canonical_test.h"
+#include <libKitsunemimiJson/json_item.h>
+
+namespace Kitsunemimi
+{
+
+/**
+ * @brief parse a string and convert it into its canonical form
+ */
+static const std::string
+canonical(const std::string &input)
+{
+    JsonItem item;
+    ErrorContainer error;
+    item.parse(input, error);
+
+    return item.toCanonicalString();
+}
+
+/**
+ * @brief parse a string and calculate the 64-bit hash
+ */
+static uint64_t
+hashOf(const std::string &input)
+{
+    JsonItem item;
+    ErrorContainer error;
+    item.parse(input, error);
+
+    return item.hash();
+}
+
+JsonItem_Canonical_Test::JsonItem_Canonical_Test()
+    : Kitsunemimi::CompareTestHelper("JsonItem_Canonical_Test")
+{
+    toCanonicalString_test();
+    canonicalNumbers_test();
+    hash_test();
+    hash128_test();
+}
+
+/**
+ * toCanonicalString_test
+ */
+void
+JsonItem_Canonical_Test::toCanonicalString_test()
+{
+    // no whitespace and sorted keys
+    TEST_EQUAL(canonical("{ \"b\": 1,\n \"a\": [ true, false, null ], \"c\": {\"z\": {}, \"y\": []}}"),
+               std::string("{\"a\":[true,false,null],\"b\":1,\"c\":{\"y\":[],\"z\":{}}}"));
+
+    // the order of the keys in the input doesn't change the result
+    TEST_EQUAL(canonical("{\"x\": {\"b\": 2, \"a\": 1}, \"w\": 0}"),
+               canonical("{\"w\": 0, \"x\": {\"a\": 1, \"b\": 2}}"));
+
+    // keys are sorted by their bytes, so upper-case letters come before lower-case letters
+    // and non-ascii characters at the end
+    TEST_EQUAL(canonical("{\"\xc3\xa4\": 1, \"a\": 2, \"B\": 3, \"\": 4}"),
+               std::string("{\"\":4,\"B\":3,\"a\":2,\"\xc3\xa4\":1}"));
+
+    // only the quote, the backslash and control characters are escaped
+    TEST_EQUAL(canonical("[\"a\\/b\\u00e4\\u0001\\n\\\"\\\\\"]"),
+               std::string("[\"a/b\xc3\xa4\\u0001\\n\\\"\\\\\"]"));
+
+    // a single string is written with quotes unlike by toString
+    TEST_EQUAL(JsonItem("test").toCanonicalString(), std::string("\"test\""));
+    TEST_EQUAL(JsonItem("test").toString(), std::string("test"));
+
+    // the canonical form can be parsed again and results in the same form
+    const std::string input = "{\"b\": [1.5, -2, \"x\\ty\"], \"a\": {\"d\": null, \"c\": 1e30}}";
+    const std::string output = canonical(input);
+    TEST_EQUAL(canonical(output), output);
+
+    // empty item
+    JsonItem emptyItem;
+    TEST_EQUAL(emptyItem.toCanonicalString(), std::string(""));
+}
+
+/**
+ * canonicalNumbers_test
+ */
+void
+JsonItem_Canonical_Test::canonicalNumbers_test()
+{
+    // integers
+    TEST_EQUAL(JsonItem(0).toCanonicalString(), std::string("0"));
+    TEST_EQUAL(JsonItem(-42).toCanonicalString(), std::string("-42"));
+    TEST_EQUAL(JsonItem(9223372036854775807l).toCanonicalString(),
+               std::string("9223372036854775807"));
+
+    // floating-point-values without fraction have the same form like integers
+    TEST_EQUAL(JsonItem(42.0).toCanonicalString(), std::string("42"));
+    TEST_EQUAL(JsonItem(-0.0).toCanonicalString(), std::string("0"));
+    TEST_EQUAL(JsonItem(1e20).toCanonicalString(), std::string("100000000000000000000"));
+    TEST_EQUAL(canonical("[1.0, 1, 1e0, 10e-1]"), std::string("[1,1,1,1]"));
+
+    // shortest digits, which result in the same value
+    TEST_EQUAL(JsonItem(0.1).toCanonicalString(), std::string("0.1"));
+    TEST_EQUAL(JsonItem(-1.5).toCanonicalString(), std::string("-1.5"));
+    TEST_EQUAL(JsonItem(123.456).toCanonicalString(), std::string("123.456"));
+    TEST_EQUAL(JsonItem(0.000001).toCanonicalString(), std::string("0.000001"));
+    TEST_EQUAL(JsonItem(1.0 / 3.0).toCanonicalString(), std::string("0.3333333333333333"));
+
+    // exponent-format for very small and big values
+    TEST_EQUAL(JsonItem(1e21).toCanonicalString(), std::string("1e+21"));
+    TEST_EQUAL(JsonItem(1e-7).toCanonicalString(), std::string("1e-7"));
+    TEST_EQUAL(JsonItem(-1.5e-10).toCanonicalString(), std::string("-1.5e-10"));
+    TEST_EQUAL(JsonItem(1.7976931348623157e308).toCanonicalString(),
+               std::string("1.7976931348623157e+308"));
+    TEST_EQUAL(JsonItem(5e-324).toCanonicalString(), std::string("5e-324"));
+
+    // different notations of the same value
+    TEST_EQUAL(canonical("[1.5e3, 1500, 15E2, 0.15e4]"), std::string("[1500,1500,1500,1500]"));
+}
+
+/**
+ * hash_test
+ */
+void
+JsonItem_Canonical_Test::hash_test()
+{
+    // equal documents have the same hash, whatever the order of the keys or the whitespace
+    TEST_EQUAL(hashOf("{\"a\": 1, \"b\": [1, 2], \"c\": {\"d\": \"e\", \"f\": null}}"),
+               hashOf("{\"c\":{\"f\":null,\"d\":\"e\"},\"b\":[1,2],\"a\":1}"));
+    TEST_EQUAL(hashOf("{\"a\": 42}"), hashOf("{\"a\": 42.0}"));
+    TEST_EQUAL(hashOf("[\"\\u00e4\"]"), hashOf("[\"\xc3\xa4\"]"));
+
+    // different documents have different hashes
+    TEST_NOT_EQUAL(hashOf("{\"a\": 1}"), hashOf("{\"a\": \"1\"}"));
+    TEST_NOT_EQUAL(hashOf("{\"a\": 1}"), hashOf("{\"a\": [1]}"));
+    TEST_NOT_EQUAL(hashOf("{\"a\": 1}"), hashOf("{\"b\": 1}"));
+    TEST_NOT_EQUAL(hashOf("[1, 2]"), hashOf("[2, 1]"));
+    TEST_NOT_EQUAL(hashOf("[\"a\", \"b\"]"), hashOf("[\"ab\"]"));
+    TEST_NOT_EQUAL(hashOf("[\"a,b\"]"), hashOf("[\"a\", \"b\"]"));
+    TEST_NOT_EQUAL(hashOf("[null]"), hashOf("[]"));
+    TEST_NOT_EQUAL(hashOf("{\"a\": true}"), hashOf("{\"a\": false}"));
+
+    // the 64-bit hash is the first half of the 128-bit hash
+    JsonItem item;
+    ErrorContainer error;
+    item.parse("{\"x\": [1, 2, 3]}", error);
+    uint64_t first = 0;
+    uint64_t second = 0;
+    item.hash128(first, second);
+    TEST_EQUAL(item.hash(), first);
+
+    // changes of the item change the hash
+    const uint64_t oldHash = item.hash();
+    item.insert("y", JsonItem(1));
+    TEST_NOT_EQUAL(item.hash(), oldHash);
+    item.remove("y");
+    TEST_EQUAL(item.hash(), oldHash);
+}
+
+/**
+ * hash128_test
+ */
+void
+JsonItem_Canonical_Test::hash128_test()
+{
+    uint64_t first = 1;
+    uint64_t second = 1;
+
+    // the hash of an empty item is the hash of an empty input
+    JsonItem emptyItem;
+    emptyItem.hash128(first, second);
+    TEST_EQUAL(first, 0ul);
+    TEST_EQUAL(second, 0ul);
+
+    // MurmurHash3 of the canonical string {"a":[1,2.5,"x"],"b":{"c":null}}, so the hash is the
+    // same on all platforms and for all builds
+    JsonItem item;
+    ErrorContainer error;
+    item.parse("{\"b\": {\"c\": null}, \"a\": [1.0, 2.5, \"x\"]}", error);
+    TEST_EQUAL(item.toCanonicalString(), std::string("{\"a\":[1,2.5,\"x\"],\"b\":{\"c\":null}}"));
+    item.hash128(first, second);
+    TEST_EQUAL(first, 0x2c71ae1c29390678ul);
+    TEST_EQUAL(second, 0xf4ab5df8d5eccb09ul);
+
+    // long strings, which are hashed in multiple blocks
+    const std::string longString(1000, 'x');
+    JsonItem longItem1(longString);
+    JsonItem longItem2(longString);
+    longItem1.hash128(first, second);
+    uint64_t otherFirst = 0;
+    uint64_t otherSecond = 0;
+    longItem2.hash128(otherFirst, otherSecond);
+    TEST_EQUAL(first, otherFirst);
+    TEST_EQUAL(second, otherSecond);
+
+    JsonItem longItem3(longString + "y");
+    longItem3.hash128(otherFirst, otherSecond);
+    TEST_NOT_EQUAL(first, otherFirst);
+    TEST_NOT_EQUAL(second, otherSecond);
+}
+
+}  // namespace Kitsunemimi
@@ -0,0 +1,31 @@
+/**
+ *  @file    json_item_canonical_test.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_ITEM_CANONICAL_TEST_H
+#define JSON_ITEM_CANONICAL_TEST_H
+
+#include <libKitsunemimiCommon/test_helper/compare_test_helper.h>
+
+namespace Kitsunemimi
+{
+class JsonItem_Canonical_Test
+        : public Kitsunemimi::CompareTestHelper
+{
+public:
+    JsonItem_Canonical_Test();
+
+private:
+    void toCanonicalString_test();
+    void canonicalNumbers_test();
+    void hash_test();
+    void hash128_test();
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_ITEM_CANONICAL_TEST_H
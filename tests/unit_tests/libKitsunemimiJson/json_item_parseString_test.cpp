@@ -8,8 +8,16 @@
 
 #include "json_item_parseString_test.h"
 #include <libKitsunemimiJson/json_item.h>
+#include <libKitsunemimiJson/json_path_matcher.h>
+#include <libKitsunemimiJson/json_stream_parser.h>
+#include <libKitsunemimiJson/json_document.h>
+#include <libKitsunemimiJson/json_handler.h>
+#include <libKitsunemimiJson/json_tape_document.h>
 #include <libKitsunemimiCommon/items/data_items.h>
 
+#include <stdio.h>
+#include <unistd.h>
+
 namespace Kitsunemimi
 {
 
@@ -17,6 +25,14 @@ JsonItem_ParseString_Test::JsonItem_ParseString_Test()
     : Kitsunemimi::CompareTestHelper("JsonItems_ParseString_Test")
 {
     parseString_test();
+    parseString_simdParser_test();
+    parseDeepNesting_test();
+    parseFile_test();
+    parseParallel_test();
+    parsePaths_test();
+    parseNumbers_test();
+    parseStrings_test();
+    parseArena_test();
 }
 
 /**
@@ -55,12 +71,12 @@ JsonItem_ParseString_Test::parseString_test()
                             "            \"x\": 42\n"
                             "        },\n"
                             "        {\n"
-                            "            \"x\": 42.000000\n"
+                            "            \"x\": 42.0\n"
                             "        },\n"
                             "        1234,\n"
                             "        {\n"
                             "            \"w\": null,\n"
-                            "            \"x\": -42.000000,\n"
+                            "            \"x\": -42.0,\n"
                             "            \"y\": true,\n"
                             "            \"z\": false\n"
                             "        }\n"
@@ -105,5 +121,531 @@ JsonItem_ParseString_Test::parseString_test()
     TEST_EQUAL(error.toString(), expectedError);
 }
 
-}  // namespace Kitsunemimi
+/**
+ * parseString_simdParser_test
+ */
+void
+JsonItem_ParseString_Test::parseString_simdParser_test()
+{
+    const std::vector<std::string> validInputs = {
+        "{\"item\": "
+        "{ \"sub_item\": \"test_value\"},"
+        "\"item2\": "
+        "{ \"sub_item2\": \"something\"},"
+        "\"loop\": "
+        "[ {\"x\" :42 }, {\"x\" :42.0 }, 1234, {\"x\" :-42.0, \"y\": true, \"z\": false, \"w\": null}]"
+        "}",
+        "[ {x :\"test1\" }, {x :\"test2\" }, {x :\"test3\" }]",
+        "{\n"
+        "    item: {\n"
+        "        sub_item: \"test_value\"\n"
+        "    },\n"
+        "    loop: [\n"
+        "        {\n"
+        "            x: 42.000000\n"
+        "        },\n"
+        "        1234,\n"
+        "        a.b-c,\n"
+        "        \"esc\\\"aped\"\n"
+        "    ]\n"
+        "}",
+        "{}",
+        "[]",
+        "\"single value\""
+    };
+
+    // both parser have to create the same tree
+    for(const std::string &input : validInputs)
+    {
+        JsonItem bisonItem;
+        JsonItem simdItem;
+        ErrorContainer error;
+        TEST_EQUAL(bisonItem.parse(input, error, JsonItem::BISON_PARSER), true);
+        TEST_EQUAL(simdItem.parse(input, error, JsonItem::SIMD_PARSER), true);
+        TEST_EQUAL(simdItem.toString(true), bisonItem.toString(true));
+    }
+
+    // negative test
+    const std::vector<std::string> invalidInputs = {
+        "{item: \n"
+        "{ sub_item: \"test_value\"}, \n"
+        "item2: \n"
+        "[ sub_item2: \"something\"}, \n"
+        "}",
+        "{\"x\": 1,}",
+        "[1, 2",
+        "{\"x\": \"not closed}",
+        "{42: 1}",
+        "[1] [2]",
+        "[1, #]"
+    };
+
+    for(const std::string &input : invalidInputs)
+    {
+        JsonItem simdItem;
+        ErrorContainer error;
+        TEST_EQUAL(simdItem.parse(input, error, JsonItem::SIMD_PARSER), false);
+    }
+}
+
+/**
+ * parseDeepNesting_test
+ */
+void
+JsonItem_ParseString_Test::parseDeepNesting_test()
+{
+    // the depth is only limited by the memory, so both parser accept the same input without
+    // an overflow of the call-stack. The inputs are not parsed into a tree, because the
+    // deletion of the data-items is recursive.
+    const uint64_t depth = 100000;
+    const std::string arrayInput = std::string(depth, '[') + std::string(depth, ']');
+    std::string mapInput = "";
+    for(uint64_t i = 0; i < depth; i++) {
+        mapInput += "{\"a\": ";
+    }
+    mapInput += "1" + std::string(depth, '}');
+
+    JsonHandler handler;
+    ErrorContainer error;
+    TEST_EQUAL(parseJson(arrayInput, handler, error, JsonItem::BISON_PARSER), true);
+    TEST_EQUAL(parseJson(arrayInput, handler, error, JsonItem::SIMD_PARSER), true);
+    TEST_EQUAL(parseJson(mapInput, handler, error, JsonItem::BISON_PARSER), true);
+    TEST_EQUAL(parseJson(mapInput, handler, error, JsonItem::SIMD_PARSER), true);
+
+    JsonDocument document;
+    TEST_EQUAL(document.parse(arrayInput, error), true);
+    TEST_EQUAL(document.getRoot().size(), 1);
+    TEST_EQUAL(document.parse(mapInput, error), true);
+    TEST_EQUAL(document["a"].isMap(), true);
+
+    JsonTapeDocument tapeDocument;
+    TEST_EQUAL(tapeDocument.parse(arrayInput, error, JsonItem::SIMD_PARSER), true);
+    TEST_EQUAL(tapeDocument.getRoot().size(), 1);
+    TEST_EQUAL(tapeDocument.parse(mapInput, error, JsonItem::SIMD_PARSER), true);
+    TEST_EQUAL(tapeDocument["a"].isMap(), true);
+
+    JsonItem parsedItem;
+    TEST_EQUAL(parsedItem.parse(arrayInput, {"/1"}, error), true);
+    TEST_EQUAL(parsedItem.toString(), std::string("[]"));
+    TEST_EQUAL(parsedItem.parse(mapInput, {"/b"}, error), true);
+    TEST_EQUAL(parsedItem.toString(), std::string("{}"));
 
+    // negative test
+    const std::string unclosedInput = std::string(depth, '[') + std::string(depth - 1, ']');
+    TEST_EQUAL(parseJson(unclosedInput, handler, error, JsonItem::SIMD_PARSER), false);
+    const std::string mismatchInput = std::string(depth, '[') + "}" + std::string(depth - 1, ']');
+    TEST_EQUAL(parseJson(mismatchInput, handler, error, JsonItem::SIMD_PARSER), false);
+}
+
+/**
+ * parseFile_test
+ */
+void
+JsonItem_ParseString_Test::parseFile_test()
+{
+    const std::string filePath = "/tmp/libKitsunemimiJson_parseFile_test.json";
+    const std::string content = "{\n"
+                                "    \"item\": {\"sub_item\": \"test_value\"},\n"
+                                "    \"loop\": [1, 2.5, true]\n"
+                                "}\n";
+    JsonItem parsedItem;
+    ErrorContainer error;
+
+    // write test-file
+    FILE* file = fopen(filePath.c_str(), "w");
+    fwrite(content.c_str(), 1, content.size(), file);
+    fclose(file);
+
+    // positive test
+    TEST_EQUAL(parsedItem.parseFile(filePath, error, JsonItem::BISON_PARSER), true);
+    TEST_EQUAL(parsedItem.toString(),
+               std::string("{\"item\":{\"sub_item\":\"test_value\"},\"loop\":[1,2.5,true]}"));
+    TEST_EQUAL(parsedItem.parseFile(filePath, error, JsonItem::SIMD_PARSER), true);
+    TEST_EQUAL(parsedItem.toString(),
+               std::string("{\"item\":{\"sub_item\":\"test_value\"},\"loop\":[1,2.5,true]}"));
+
+    // empty file
+    file = fopen(filePath.c_str(), "w");
+    fclose(file);
+    TEST_EQUAL(parsedItem.parseFile(filePath, error), true);
+    TEST_EQUAL(parsedItem.isMap(), true);
+    TEST_EQUAL(parsedItem.size(), 0);
+
+    // invalid content
+    file = fopen(filePath.c_str(), "w");
+    fwrite("[1, 2", 1, 5, file);
+    fclose(file);
+    TEST_EQUAL(parsedItem.parseFile(filePath, error), false);
+
+    unlink(filePath.c_str());
+
+    // negative test
+    TEST_EQUAL(parsedItem.parseFile(filePath, error), false);
+    TEST_EQUAL(parsedItem.parseFile("/tmp", error), false);
+}
+
+/**
+ * parseParallel_test
+ */
+void
+JsonItem_ParseString_Test::parseParallel_test()
+{
+    // big array with elements, which contain commas and brackets within strings
+    std::string input = "[";
+    for(uint32_t i = 0; i < 5000; i++)
+    {
+        if(i != 0) {
+            input.append(",\n");
+        }
+        input.append("{\"id\": " + std::to_string(i) + ", "
+                     "\"text\": \"a, [b], {c}\", "
+                     "\"list\": [1, [2, 3], {\"x\": \"y\"}]}");
+    }
+    input.append(", 42, \"last\", true, [], {}]");
+
+    JsonItem serialItem;
+    JsonItem parallelItem;
+    ErrorContainer error;
+
+    // positive test
+    TEST_EQUAL(serialItem.parse(input, error, JsonItem::BISON_PARSER), true);
+    TEST_EQUAL(parallelItem.parseParallel(input, error, 4, JsonItem::BISON_PARSER), true);
+    TEST_EQUAL(parallelItem.size(), 5005);
+    TEST_EQUAL(parallelItem.toString(), serialItem.toString());
+    TEST_EQUAL(parallelItem.parseParallel(input, error, 3, JsonItem::SIMD_PARSER), true);
+    TEST_EQUAL(parallelItem.toString(), serialItem.toString());
+
+    // input, which is no array, is parsed by the normal parser
+    TEST_EQUAL(parallelItem.parseParallel("{\"x\": [1, 2]}", error, 4), true);
+    TEST_EQUAL(parallelItem.toString(), std::string("{\"x\":[1,2]}"));
+
+    // negative test
+    std::string invalidInput = input;
+    invalidInput.insert(invalidInput.size() - 1, ",");
+    TEST_EQUAL(parallelItem.parseParallel(invalidInput, error, 4), false);
+
+    invalidInput = input;
+    invalidInput.replace(invalidInput.find("[1, [2"), 1, "{");
+    TEST_EQUAL(parallelItem.parseParallel(invalidInput, error, 4), false);
+
+    invalidInput = input;
+    invalidInput.append("]");
+    TEST_EQUAL(parallelItem.parseParallel(invalidInput, error, 4), false);
+}
+
+/**
+ * parsePaths_test
+ */
+void
+JsonItem_ParseString_Test::parsePaths_test()
+{
+    const std::string input("{\"user\": {\"id\": 42, \"name\": \"test\", \"tags\": [\"a\", \"}\"]},"
+                            " \"items\": [{\"price\": 1.5, \"count\": 2},"
+                            "             {\"count\": 3},"
+                            "             {\"price\": 2.5, \"info\": {\"x\": [1, {}]}}],"
+                            " \"a/b\": {\"c~d\": true},"
+                            " \"user\": {\"id\": 0}}");
+    JsonItem parsedItem;
+    ErrorContainer error;
+
+    // positive test
+    TEST_EQUAL(parsedItem.parse(input, {"/user/id", "/items/*/price"}, error), true);
+    TEST_EQUAL(parsedItem.toString(),
+               std::string("{\"items\":[{\"price\":1.5},{\"price\":2.5}],"
+                           "\"user\":{\"id\":42}}"));
+
+    JsonPathMatcher matcher;
+    TEST_EQUAL(matcher.addPath("/items/2/info", error), true);
+    TEST_EQUAL(matcher.addPath("/a~1b/c~0d", error), true);
+    TEST_EQUAL(matcher.addPath("/user/tags", error), true);
+    TEST_EQUAL(matcher.getNumberOfPaths(), 3);
+    TEST_EQUAL(parsedItem.parse(input, matcher, error), true);
+    TEST_EQUAL(parsedItem.toString(),
+               std::string("{\"a/b\":{\"c~d\":true},"
+                           "\"items\":[{\"info\":{\"x\":[1,{}]}}],"
+                           "\"user\":{\"tags\":[\"a\",\"}\"]}}"));
+
+    // whole document and no match
+    JsonItem completeItem;
+    TEST_EQUAL(completeItem.parse(input, error), true);
+    TEST_EQUAL(parsedItem.parse(input, {""}, error), true);
+    TEST_EQUAL(parsedItem.toString(), completeItem.toString());
+    TEST_EQUAL(parsedItem.parse(input, {"/fail/id"}, error), true);
+    TEST_EQUAL(parsedItem.toString(), std::string("{}"));
+    TEST_EQUAL(parsedItem.parse("[1, 2]", {"/fail"}, error), true);
+    TEST_EQUAL(parsedItem.toString(), std::string("[]"));
+
+    // negative test
+    TEST_EQUAL(matcher.addPath("user/id", error), false);
+    TEST_EQUAL(matcher.addPath("/user~2", error), false);
+    TEST_EQUAL(parsedItem.parse(input, {"user"}, error), false);
+    TEST_EQUAL(parsedItem.parse("{\"user\": {\"id\": 42}", {"/user/id"}, error), false);
+    TEST_EQUAL(parsedItem.parse("{\"user\": {\"id\": [1, 2}}", {"/user/id"}, error), false);
+    TEST_EQUAL(parsedItem.parse("{\"user\": 1,, \"x\": 2}", {"/x"}, error), false);
+    TEST_EQUAL(parsedItem.parse("{\"user\": 1} 2", {"/user"}, error), false);
+}
+
+/**
+ * parseNumbers_test
+ */
+void
+JsonItem_ParseString_Test::parseNumbers_test()
+{
+    const std::string input("{\"a\": 1e-7, \"b\": 2E10, \"c\": 1.5e+3, \"d\": -0.1,"
+                            " \"e\": 0.1, \"f\": 9223372036854775807, \"g\": -42,"
+                            " \"h\": 1.7976931348623157e308, \"i\": 4.9e-324, \"j\": 1e,"
+                            " \"k\": 123456789012345678901234567890.5}");
+
+    // all parser have to read the same values
+    for(uint32_t parser = 0; parser < 3; parser++)
+    {
+        JsonItem item;
+        ErrorContainer error;
+        if(parser == 0) {
+            TEST_EQUAL(item.parse(input, error, JsonItem::BISON_PARSER), true);
+        } else if(parser == 1) {
+            TEST_EQUAL(item.parse(input, error, JsonItem::SIMD_PARSER), true);
+        }
+        else
+        {
+            // feed byte by byte, so each number is splitted at every position
+            JsonStreamParser streamParser;
+            bool success = true;
+            for(uint64_t pos = 0; pos < input.size(); pos++) {
+                success = success && streamParser.feed(&input[pos], 1, error);
+            }
+            TEST_EQUAL(success, true);
+            TEST_EQUAL(streamParser.finish(item, error), true);
+        }
+
+        TEST_EQUAL(item.get("a").isFloat(), true);
+        TEST_EQUAL(item.get("a").getDouble(), 1e-7);
+        TEST_EQUAL(item.get("b").isFloat(), true);
+        TEST_EQUAL(item.get("b").getDouble(), 2e10);
+        TEST_EQUAL(item.get("c").getDouble(), 1500.0);
+        TEST_EQUAL(item.get("d").getDouble(), -0.1);
+        TEST_EQUAL(item.get("e").getDouble(), 0.1);
+        TEST_EQUAL(item.get("f").isInteger(), true);
+        TEST_EQUAL(item.get("f").getLong(), 9223372036854775807L);
+        TEST_EQUAL(item.get("g").getLong(), -42L);
+        TEST_EQUAL(item.get("h").getDouble(), 1.7976931348623157e308);
+        TEST_EQUAL(item.get("i").getDouble(), 4.9e-324);
+        TEST_EQUAL(item.get("j").isString(), true);
+        TEST_EQUAL(item.get("j").getString(), "1e");
+        TEST_EQUAL(item.get("k").getDouble(), 123456789012345678901234567890.5);
+    }
+
+    // output has the shortest representation, which results in exactly the same value again
+    const std::string numbersInput("[0.1, -0.0, 42.0, 1e-7, 2E10, 1e21, 1.7976931348623157e308,"
+                                   " 4.9e-324, 2.2250738585072014e-308, 0.30000000000000004,"
+                                   " 123456.789, 9007199254740993.0, -42]");
+    JsonItem numbersItem;
+    ErrorContainer error;
+    TEST_EQUAL(numbersItem.parse(numbersInput, error), true);
+    const std::string numbersOutput = numbersItem.toString();
+    TEST_EQUAL(numbersOutput, std::string("[0.1,-0.0,42.0,1e-07,2e+10,1e+21,"
+                                          "1.7976931348623157e+308,5e-324,"
+                                          "2.2250738585072014e-308,0.30000000000000004,"
+                                          "123456.789,9007199254740992.0,-42]"));
+
+    JsonItem parsedAgain;
+    TEST_EQUAL(parsedAgain.parse(numbersOutput, error), true);
+    TEST_EQUAL(parsedAgain.size(), numbersItem.size());
+    for(uint32_t i = 0; i < numbersItem.size(); i++)
+    {
+        TEST_EQUAL(parsedAgain.get(i).isFloat(), numbersItem.get(i).isFloat());
+        TEST_EQUAL(parsedAgain.get(i).getDouble(), numbersItem.get(i).getDouble());
+    }
+    TEST_EQUAL(parsedAgain.toString(), numbersOutput);
+
+    // negative test
+    const std::vector<std::string> invalidInputs = {
+        "[1e400]",
+        "[-1e400]",
+        "[9223372036854775808]",
+        "[1e+]",
+        "[a+1]"
+    };
+
+    for(const std::string &input : invalidInputs)
+    {
+        JsonItem item;
+        ErrorContainer error;
+        TEST_EQUAL(item.parse(input, error, JsonItem::BISON_PARSER), false);
+        TEST_EQUAL(item.parse(input, error, JsonItem::SIMD_PARSER), false);
+    }
+}
+
+/**
+ * parseStrings_test
+ */
+void
+JsonItem_ParseString_Test::parseStrings_test()
+{
+    const std::string input("{\"a\": \"line\\nbreak\", \"b\": \"quote\\\" and \\\\ backslash\","
+                            " \"c\": \"\\u00e4\\u20AC\\ud83d\\ude00\", \"d\": \"\xc3\xa4\xe2\x82\xac\","
+                            " \"e\\\"key\": \"\\/\\b\\f\\r\\t\"}");
+
+    // all parser have to decode the same strings, also in the strict mode
+    for(uint32_t parser = 0; parser < 3; parser++)
+    {
+        JsonItem item;
+        ErrorContainer error;
+        if(parser == 0) {
+            TEST_EQUAL(item.parse(input, error, JsonItem::BISON_PARSER, true), true);
+        } else if(parser == 1) {
+            TEST_EQUAL(item.parse(input, error, JsonItem::SIMD_PARSER, true), true);
+        }
+        else
+        {
+            // feed byte by byte, so each escape-sequence is splitted at every position
+            JsonStreamParser streamParser(true);
+            bool success = true;
+            for(uint64_t pos = 0; pos < input.size(); pos++) {
+                success = success && streamParser.feed(&input[pos], 1, error);
+            }
+            TEST_EQUAL(success, true);
+            TEST_EQUAL(streamParser.finish(item, error), true);
+        }
+
+        TEST_EQUAL(item.get("a").getString(), "line\nbreak");
+        TEST_EQUAL(item.get("b").getString(), "quote\" and \\ backslash");
+        TEST_EQUAL(item.get("c").getString(), "\xc3\xa4\xe2\x82\xac\xf0\x9f\x98\x80");
+        TEST_EQUAL(item.get("d").getString(), "\xc3\xa4\xe2\x82\xac");
+        TEST_EQUAL(item.get("e\"key").getString(), "/\b\f\r\t");
+
+        // output has to be escaped again, so it results in the same tree
+        JsonItem reparsedItem;
+        TEST_EQUAL(reparsedItem.parse(item.toString(), error), true);
+        TEST_EQUAL(reparsedItem.toString(), item.toString());
+    }
+
+    TEST_EQUAL(JsonItem("x\"y").toString(), "x\"y");
+    JsonItem arrayItem;
+    ErrorContainer error;
+    arrayItem.parse("[]", error);
+    arrayItem.append(JsonItem("tab\tquote\"\x01"));
+    TEST_EQUAL(arrayItem.toString(), "[\"tab\\tquote\\\"\\u0001\"]");
+
+    // special characters in front of, within and behind the full 32-byte blocks of long strings
+    const std::string padding(70, 'x');
+    for(const uint64_t pos : {0, 31, 33, 64, 70})
+    {
+        const std::string raw = padding.substr(0, pos) + "\"\n\xc3\xa4" + padding.substr(pos);
+        const std::string escaped = padding.substr(0, pos) + "\\\"\\n\xc3\xa4" + padding.substr(pos);
+        JsonItem longItem;
+        TEST_EQUAL(longItem.parse("[\"" + escaped + "\"]", error, JsonItem::BISON_PARSER, true), true);
+        TEST_EQUAL(longItem[0].getString(), raw);
+        TEST_EQUAL(longItem.parse("[\"" + escaped + "\"]", error, JsonItem::SIMD_PARSER, true), true);
+        TEST_EQUAL(longItem[0].getString(), raw);
+        TEST_EQUAL(longItem.parse("[]", error), true);
+        longItem.append(JsonItem(raw));
+        TEST_EQUAL(longItem.toString(), "[\"" + escaped + "\"]");
+
+        const std::string control = padding.substr(0, pos) + "\t" + padding.substr(pos);
+        TEST_EQUAL(longItem.parse("[\"" + control + "\"]", error, JsonItem::SIMD_PARSER, true), false);
+    }
+
+    // the lazy document has to decode strings and keys in the same way
+    JsonDocument document;
+    TEST_EQUAL(document.parse(input, error), true);
+    TEST_EQUAL(document["c"].getString(), "\xc3\xa4\xe2\x82\xac\xf0\x9f\x98\x80");
+    TEST_EQUAL(document["e\"key"].getString(), "/\b\f\r\t");
+
+    // invalid strings are kept unchanged in the normal mode and rejected in the strict mode
+    const std::vector<std::string> invalidInputs = {
+        "[\"\\x\"]",
+        "[\"\\ud800\"]",
+        "[\"\\udc00\"]",
+        "[\"\\u12g4\"]",
+        "[\"a\xff\"]",
+        "[\"\xc0\xaf\"]",
+        "[\"\xed\xa0\x80\"]",
+        "[\"\xf4\x90\x80\x80\"]",
+        "[\"tab\tinside\"]"
+    };
+
+    for(const std::string &invalidInput : invalidInputs)
+    {
+        JsonItem item;
+        TEST_EQUAL(item.parse(invalidInput, error, JsonItem::BISON_PARSER), true);
+        TEST_EQUAL(item.parse(invalidInput, error, JsonItem::SIMD_PARSER), true);
+        TEST_EQUAL(item.parse(invalidInput, error, JsonItem::BISON_PARSER, true), false);
+        TEST_EQUAL(item.parse(invalidInput, error, JsonItem::SIMD_PARSER, true), false);
+
+        JsonStreamParser streamParser(true);
+        TEST_EQUAL(streamParser.feed(invalidInput.c_str(), invalidInput.size(), error), false);
+    }
+
+    JsonItem item;
+    TEST_EQUAL(item.parse("[\"\\x\", \"\\ud800\"]", error), true);
+    TEST_EQUAL(item[0].getString(), "\\x");
+    TEST_EQUAL(item[1].getString(), "\\ud800");
+}
+
+/**
+ * parseArena_test
+ */
+void
+JsonItem_ParseString_Test::parseArena_test()
+{
+    const std::string input("{\"item\": {\"sub_item\": \"test_value\"},"
+                            " \"loop\": [1, -2.5, true, null, \"x\\ty\"],"
+                            " \"dup\": [1, {\"a\": 1}], \"dup\": {\"b\": \"c\"}}");
+
+    for(uint32_t parser = 1; parser < 3; parser++)
+    {
+        const JsonItem::parserTypes parserType = static_cast<JsonItem::parserTypes>(parser);
+        ErrorContainer error;
+
+        // the arena creates the same tree like the normal parsing
+        JsonItem normalItem;
+        JsonItem arenaItem;
+        TEST_EQUAL(normalItem.parse(input, error, parserType), true);
+        TEST_EQUAL(arenaItem.parse(input, error, parserType, false, true), true);
+        TEST_EQUAL(arenaItem.toString(), normalItem.toString());
+        TEST_EQUAL(arenaItem.get("loop").get(4).getString(), std::string("x\ty"));
+        TEST_EQUAL(arenaItem["item"]["sub_item"].getString(), std::string("test_value"));
+
+        // a copy out of the arena is still valid after the arena was deleted
+        JsonItem copiedItem = arenaItem.get("item", true);
+        JsonItem copiedValue = arenaItem.get("loop").get(4, true);
+        TEST_EQUAL(copiedItem.insert("new", JsonItem(42)), true);
+
+        // parts of the arena can not be changed
+        JsonItem part = arenaItem.get("item");
+        TEST_EQUAL(part.insert("new", JsonItem(42)), false);
+        TEST_EQUAL(part.remove("sub_item"), false);
+        TEST_EQUAL(part.get("sub_item").setValue("changed"), false);
+        TEST_EQUAL(part.stealItemContent() == nullptr, true);
+        TEST_EQUAL(arenaItem.get("loop").replaceItem(0, JsonItem(2)), false);
+        TEST_EQUAL(arenaItem.get("loop").append(JsonItem(2)), false);
+        TEST_EQUAL(arenaItem.get("loop").deleteContent(), false);
+
+        // the root converts the tree into normal items before a change
+        JsonItem changedItem;
+        TEST_EQUAL(changedItem.parse(input, error, parserType, false, true), true);
+        TEST_EQUAL(changedItem.insert("new", JsonItem(42)), true);
+        TEST_EQUAL(changedItem.remove("item"), true);
+        TEST_EQUAL(changedItem.get("loop").append(JsonItem(2)), true);
+        TEST_EQUAL(changedItem.toString(),
+                   std::string("{\"dup\":[1,{\"a\":1}],\"loop\":[1,-2.5,true,null,"
+                               "\"x\\ty\",2],\"new\":42}"));
+
+        // parsing again and deleting releases the arena
+        TEST_EQUAL(arenaItem.parse("[1, 2]", error, parserType, false, true), true);
+        TEST_EQUAL(arenaItem.toString(), std::string("[1,2]"));
+        TEST_EQUAL(arenaItem.deleteContent(), true);
+        TEST_EQUAL(arenaItem.isNull(), true);
+
+        TEST_EQUAL(copiedItem.toString(),
+                   std::string("{\"new\":42,\"sub_item\":\"test_value\"}"));
+        TEST_EQUAL(copiedValue.getString(), std::string("x\ty"));
+
+        // negative test, where the incomplete tree is deleted with the arena
+        TEST_EQUAL(arenaItem.parse("{\"a\": [1, {\"b\": 2}", error, parserType, false, true),
+                   false);
+    }
+}
+
+}  // namespace Kitsunemimi
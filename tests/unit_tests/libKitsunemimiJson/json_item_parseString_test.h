@@ -21,6 +21,14 @@ public:
 
 private:
     void parseString_test();
+    void parseString_simdParser_test();
+    void parseDeepNesting_test();
+    void parseFile_test();
+    void parseParallel_test();
+    void parsePaths_test();
+    void parseNumbers_test();
+    void parseStrings_test();
+    void parseArena_test();
 };
 
 }  // namespace Kitsunemimi
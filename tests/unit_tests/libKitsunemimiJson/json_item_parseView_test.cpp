@@ -0,0 +1,160 @@
+/**
+ *  @file    json_item_parseView_test.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include "json_item_parseView_test.h"
+#include <libKitsunemimiJson/json_item.h>
+#include <libKitsunemimiJson/json_handler.h>
+#include <libKitsunemimiCommon/items/data_items.h>
+
+#include <malloc.h>
+
+namespace Kitsunemimi
+{
+
+JsonItem_ParseView_Test::JsonItem_ParseView_Test()
+    : Kitsunemimi::CompareTestHelper("JsonItem_ParseView_Test")
+{
+    parseView_test();
+    parsePointer_test();
+    parseWithoutCopy_test();
+}
+
+/**
+ * parseView_test
+ */
+void
+JsonItem_ParseView_Test::parseView_test()
+{
+    // the view covers only the first part of the buffer, which is not null-terminated
+    const std::string buffer = "{\"x\": [1, 2, \"test\"]}[\"not part of the view\"]";
+    const std::string_view input(buffer.data(), 21);
+
+    JsonItem bisonItem;
+    JsonItem simdItem;
+    ErrorContainer error;
+    TEST_EQUAL(bisonItem.parse(input, error, JsonItem::BISON_PARSER), true);
+    TEST_EQUAL(simdItem.parse(input, error, JsonItem::SIMD_PARSER), true);
+    TEST_EQUAL(bisonItem.toString(), std::string("{\"x\":[1,2,\"test\"]}"));
+    TEST_EQUAL(simdItem.toString(), std::string("{\"x\":[1,2,\"test\"]}"));
+
+    // string-literals have to work without ambiguity
+    JsonItem literalItem;
+    TEST_EQUAL(literalItem.parse("[1, 2]", error), true);
+    TEST_EQUAL(literalItem.size(), 2);
+
+    // negative test
+    const std::string_view brokenInput(buffer.data(), 20);
+    TEST_EQUAL(bisonItem.parse(brokenInput, error, JsonItem::BISON_PARSER), false);
+    TEST_EQUAL(simdItem.parse(brokenInput, error, JsonItem::SIMD_PARSER), false);
+}
+
+/**
+ * parsePointer_test
+ */
+void
+JsonItem_ParseView_Test::parsePointer_test()
+{
+    const char buffer[] = "[{\"y\": true}, {\"y\": false}] trailing garbage";
+
+    JsonItem bisonItem;
+    JsonItem simdItem;
+    ErrorContainer error;
+    TEST_EQUAL(bisonItem.parse(buffer, 27, error, JsonItem::BISON_PARSER), true);
+    TEST_EQUAL(simdItem.parse(buffer, 27, error, JsonItem::SIMD_PARSER), true);
+    TEST_EQUAL(bisonItem.toString(), std::string("[{\"y\":true},{\"y\":false}]"));
+    TEST_EQUAL(simdItem.toString(), std::string("[{\"y\":true},{\"y\":false}]"));
+
+    // empty input
+    JsonItem emptyItem;
+    TEST_EQUAL(emptyItem.parse(buffer, 0, error), true);
+    TEST_EQUAL(emptyItem.isMap(), true);
+    TEST_EQUAL(emptyItem.size(), 0);
+
+    // the error-message has to point to the broken part within the input
+    TEST_EQUAL(bisonItem.parse(buffer, sizeof(buffer) - 1, error, JsonItem::BISON_PARSER), false);
+}
+
+/**
+ * @brief get the number of bytes, which are currently allocated by malloc and operator new
+ */
+static uint64_t
+getAllocatedMemory()
+{
+    const struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+/**
+ * @brief handler, which checks at each event, how much memory was allocated since the start of
+ *        the parsing. A copy of the input would be kept until the end of the parsing, so it
+ *        would be found at every event.
+ */
+class MemoryCheckHandler
+        : public JsonHandler
+{
+public:
+    uint64_t m_startMemory = getAllocatedMemory();
+    uint64_t m_maxAdditionalMemory = 0;
+    uint64_t m_numberOfStrings = 0;
+
+    bool stringValue(const std::string &)
+    {
+        m_numberOfStrings++;
+        const uint64_t memory = getAllocatedMemory();
+        if(memory > m_startMemory
+                && memory - m_startMemory > m_maxAdditionalMemory)
+        {
+            m_maxAdditionalMemory = memory - m_startMemory;
+        }
+        return true;
+    }
+};
+
+/**
+ * parseWithoutCopy_test
+ */
+void
+JsonItem_ParseView_Test::parseWithoutCopy_test()
+{
+    // create a big input out of many strings like a normal document. A single token, which is
+    // bigger than the buffer of the scanner, like a long run of whitespaces, would let flex
+    // grow its buffer for the complete token. Long strings keep the structural index of the
+    // simd-parser small in relation to the input.
+    const std::string value(120, 'x');
+    std::string input = "[";
+    for(uint32_t i = 0; i < 32768; i++) {
+        input.append("\"" + value + "\", ");
+    }
+    input.append("\"end\"]");
+
+    // the json-item builds its tree with the same function, so also there the input is never
+    // copied as a whole: the simd-parser reads it in place and the bison-parser copies it in
+    // small parts into the buffer of its scanner
+    ErrorContainer error;
+    for(const JsonItem::parserTypes parserType : {JsonItem::BISON_PARSER, JsonItem::SIMD_PARSER})
+    {
+        MemoryCheckHandler viewHandler;
+        TEST_EQUAL(parseJson(std::string_view(input), viewHandler, error, parserType), true);
+        TEST_EQUAL(viewHandler.m_numberOfStrings, 32769);
+        TEST_EQUAL(viewHandler.m_maxAdditionalMemory < input.size() / 2, true);
+
+        MemoryCheckHandler pointerHandler;
+        TEST_EQUAL(parseJson(input.c_str(), input.size(), pointerHandler, error, parserType), true);
+        TEST_EQUAL(pointerHandler.m_numberOfStrings, 32769);
+        TEST_EQUAL(pointerHandler.m_maxAdditionalMemory < input.size() / 2, true);
+
+        JsonItem viewItem;
+        JsonItem pointerItem;
+        TEST_EQUAL(viewItem.parse(std::string_view(input), error, parserType), true);
+        TEST_EQUAL(pointerItem.parse(input.c_str(), input.size(), error, parserType), true);
+        TEST_EQUAL(viewItem.size(), 32769);
+        TEST_EQUAL(pointerItem[32768].getString(), "end");
+    }
+}
+
+}  // namespace Kitsunemimi
@@ -0,0 +1,30 @@
+/**
+ *  @file    json_item_parseView_test.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_ITEM_PARSEVIEW_TEST_H
+#define JSON_ITEM_PARSEVIEW_TEST_H
+
+#include <libKitsunemimiCommon/test_helper/compare_test_helper.h>
+
+namespace Kitsunemimi
+{
+class JsonItem_ParseView_Test
+        : public Kitsunemimi::CompareTestHelper
+{
+public:
+    JsonItem_ParseView_Test();
+
+private:
+    void parseView_test();
+    void parsePointer_test();
+    void parseWithoutCopy_test();
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_ITEM_PARSEVIEW_TEST_H
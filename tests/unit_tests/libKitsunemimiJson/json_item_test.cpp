@@ -9,6 +9,11 @@
 #include "json_item_test.h"
 #include <libKitsunemimiCommon/items/data_items.h>
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <fstream>
+#include <sstream>
+
 namespace Kitsunemimi
 {
 
@@ -17,10 +22,15 @@ JsonItem_Test::JsonItem_Test()
 {
     constructor_test();
     assigmentOperator_test();
+    moveConstructor_test();
+    moveAssignmentOperator_test();
     setValue_test();
     insert_test();
     append_test();
     replaceItem_test();
+    insertMove_test();
+    appendMove_test();
+    replaceItemMove_test();
     deleteContent_test();
 
     getItemContent_test();
@@ -37,6 +47,9 @@ JsonItem_Test::JsonItem_Test()
     isString_isInteger_isFloat_isBool_test();
 
     remove_test();
+
+    writeTo_test();
+    writeToFile_test();
 }
 
 /**
@@ -101,6 +114,108 @@ JsonItem_Test::assigmentOperator_test()
     TEST_EQUAL(testItem.toString(), testMap.toString());
 }
 
+/**
+ * @brief moveConstructor_test
+ */
+void
+JsonItem_Test::moveConstructor_test()
+{
+    // the content is taken without copy
+    JsonItem source = getTestItem();
+    DataItem* content = source.getItemContent();
+    JsonItem target(std::move(source));
+    TEST_EQUAL(target.getItemContent() == content, true);
+    TEST_EQUAL(source.isValid(), false);
+
+    // an item, which only points into another tree, is copied
+    JsonItem view = target["item"];
+    JsonItem viewCopy(std::move(view));
+    TEST_EQUAL(viewCopy.getItemContent() == target["item"].getItemContent(), false);
+    TEST_EQUAL(viewCopy.toString(), target["item"].toString());
+    TEST_EQUAL(view.isValid(), true);
+
+    // an item, which is moved from a view into a vector, stays valid without the source-tree
+    std::vector<JsonItem> views;
+    {
+        JsonItem root = getTestItem();
+        views.push_back(root["loop"]);
+    }
+    TEST_EQUAL(views[0].size(), 4);
+    TEST_EQUAL(views[0][0]["x"].getInt(), 42);
+    TEST_EQUAL(views[0].toString(), "[{\"x\":42},{\"x\":42.0},1234,{\"x\":-42.0}]");
+
+    // the root of an arena-document keeps its arena
+    JsonItem arenaItem;
+    ErrorContainer error;
+    arenaItem.parse("{\"a\": [1, 2, 3], \"b\": \"c\"}", error, JsonItem::DEFAULT_PARSER, false, true);
+    content = arenaItem.getItemContent();
+    JsonItem arenaTarget(std::move(arenaItem));
+    TEST_EQUAL(arenaTarget.getItemContent() == content, true);
+    TEST_EQUAL(arenaTarget["a"][2].getInt(), 3);
+    TEST_EQUAL(arenaItem.isValid(), false);
+
+    // map and vector with items, which are moved into the new item
+    std::map<std::string, JsonItem> map;
+    map["a"] = JsonItem(1);
+    map["b"] = getTestItem();
+    content = map["b"].getItemContent();
+    JsonItem mapItem(std::move(map));
+    TEST_EQUAL(mapItem.isMap(), true);
+    TEST_EQUAL(mapItem["a"].getInt(), 1);
+    TEST_EQUAL(mapItem["b"].getItemContent() == content, true);
+
+    std::vector<JsonItem> vector;
+    vector.push_back(JsonItem("x"));
+    vector.push_back(getTestItem());
+    content = vector[1].getItemContent();
+    JsonItem arrayItem(std::move(vector));
+    TEST_EQUAL(arrayItem.isArray(), true);
+    TEST_EQUAL(arrayItem[0].getString(), "x");
+    TEST_EQUAL(arrayItem[1].getItemContent() == content, true);
+
+    // a vector moves its items, when it grows
+    std::vector<JsonItem> items;
+    items.push_back(getTestItem());
+    content = items[0].getItemContent();
+    for(int i = 0; i < 100; i++) {
+        items.push_back(JsonItem(i));
+    }
+    TEST_EQUAL(items[0].getItemContent() == content, true);
+    TEST_EQUAL(items[100].getInt(), 99);
+}
+
+/**
+ * @brief moveAssignmentOperator_test
+ */
+void
+JsonItem_Test::moveAssignmentOperator_test()
+{
+    JsonItem source = getTestItem();
+    DataItem* content = source.getItemContent();
+    JsonItem target(42);
+    target = std::move(source);
+    TEST_EQUAL(target.getItemContent() == content, true);
+    TEST_EQUAL(source.isValid(), false);
+
+    // an item, which only points into another tree, is copied
+    JsonItem copy;
+    copy = target["item2"];
+    TEST_EQUAL(copy.getItemContent() == target["item2"].getItemContent(), false);
+    TEST_EQUAL(copy.toString(), target["item2"].toString());
+
+    // an item can be replaced by a part of its own tree
+    JsonItem ownItem = getTestItem();
+    ownItem = ownItem["item"];
+    TEST_EQUAL(ownItem.isMap(), true);
+    TEST_EQUAL(ownItem["sub_item"].getString(), "test_value");
+
+    // an assignment to an item, which points into another tree, doesn't change the tree
+    JsonItem view = target["item"];
+    view = JsonItem(5);
+    TEST_EQUAL(view.getInt(), 5);
+    TEST_EQUAL(target["item"].isMap(), true);
+}
+
 /**
  * @brief setValue_test
  */
@@ -174,6 +289,107 @@ JsonItem_Test::replaceItem_test()
     TEST_EQUAL(testItem.replaceItem(0, JsonItem()), false);
 }
 
+/**
+ * @brief insertMove_test
+ */
+void
+JsonItem_Test::insertMove_test()
+{
+    JsonItem child = getTestItem();
+    DataItem* content = child.getItemContent();
+    JsonItem testItem;
+    TEST_EQUAL(testItem.insert("child", std::move(child)), true);
+    TEST_EQUAL(testItem["child"].getItemContent() == content, true);
+    TEST_EQUAL(child.isValid(), false);
+
+    // an item, which points into another tree, is copied
+    TEST_EQUAL(testItem.insert("copy", testItem["child"]["item"]), true);
+    TEST_EQUAL(testItem["copy"].toString(), testItem["child"]["item"].toString());
+    TEST_EQUAL(testItem["copy"].getItemContent()
+               == testItem["child"]["item"].getItemContent(), false);
+
+    // insert the item into itself
+    JsonItem selfItem;
+    selfItem.insert("a", JsonItem(1));
+    TEST_EQUAL(selfItem.insert("self", std::move(selfItem)), true);
+    TEST_EQUAL(selfItem["self"]["a"].getInt(), 1);
+    TEST_EQUAL(selfItem.size(), 2);
+
+    // build a deep tree bottom-up
+    JsonItem deepItem(0);
+    for(int i = 1; i <= 100; i++)
+    {
+        JsonItem parent;
+        parent.insert("value", JsonItem(i));
+        parent.insert("child", std::move(deepItem));
+        deepItem = std::move(parent);
+    }
+    JsonItem deepestItem = deepItem;
+    for(int i = 0; i < 100; i++) {
+        deepestItem = deepestItem["child"];
+    }
+    TEST_EQUAL(deepItem["value"].getInt(), 100);
+    TEST_EQUAL(deepestItem.getInt(), 0);
+
+    // negative test, where the value stays unchanged
+    JsonItem failItem(43);
+    TEST_EQUAL(testItem.insert("child", std::move(failItem)), false);
+    TEST_EQUAL(failItem.getInt(), 43);
+    TEST_EQUAL(testItem.insert("", std::move(failItem)), false);
+    TEST_EQUAL(failItem.getInt(), 43);
+    TEST_EQUAL(testItem.insert("child", std::move(failItem), true), true);
+    TEST_EQUAL(testItem["child"].getInt(), 43);
+    TEST_EQUAL(failItem.isValid(), false);
+}
+
+/**
+ * @brief appendMove_test
+ */
+void
+JsonItem_Test::appendMove_test()
+{
+    JsonItem child = getTestItem();
+    DataItem* content = child.getItemContent();
+    JsonItem testItem;
+    TEST_EQUAL(testItem.append(std::move(child)), true);
+    TEST_EQUAL(testItem.isArray(), true);
+    TEST_EQUAL(testItem[0].getItemContent() == content, true);
+    TEST_EQUAL(child.isValid(), false);
+
+    // an item, which points into another tree, is copied
+    TEST_EQUAL(testItem.append(testItem[0]["loop"]), true);
+    TEST_EQUAL(testItem[1].toString(), testItem[0]["loop"].toString());
+    TEST_EQUAL(testItem[1].getItemContent() == testItem[0]["loop"].getItemContent(), false);
+
+    // negative test, where the value stays unchanged
+    JsonItem mapItem = getTestItem();
+    JsonItem failItem(43);
+    TEST_EQUAL(mapItem.append(std::move(failItem)), false);
+    TEST_EQUAL(failItem.getInt(), 43);
+}
+
+/**
+ * @brief replaceItemMove_test
+ */
+void
+JsonItem_Test::replaceItemMove_test()
+{
+    JsonItem testItem;
+    testItem.append(JsonItem(42));
+    testItem.append(JsonItem("42"));
+
+    JsonItem child = getTestItem();
+    DataItem* content = child.getItemContent();
+    TEST_EQUAL(testItem.replaceItem(0, std::move(child)), true);
+    TEST_EQUAL(testItem[0].getItemContent() == content, true);
+    TEST_EQUAL(child.isValid(), false);
+
+    // negative test, where the value stays unchanged
+    JsonItem failItem("fail");
+    TEST_EQUAL(testItem.replaceItem(10, std::move(failItem)), false);
+    TEST_EQUAL(failItem.getString(), "fail");
+}
+
 /**
  * @brief deleteContent_test
  */
@@ -198,7 +414,12 @@ JsonItem_Test::getItemContent_test()
     JsonItem testItem = getTestItem();
     DataItem* itemPtr = testItem.getItemContent();
 
-    TEST_EQUAL(itemPtr->toString(true), testItem.toString(true));
+    // the string-conversion of the common-library still writes floating-point-values with a
+    // fixed number of digits, so both outputs are compared after parsing them again
+    JsonItem contentItem;
+    ErrorContainer error;
+    TEST_EQUAL(contentItem.parse(itemPtr->toString(true), error), true);
+    TEST_EQUAL(contentItem.toString(true), testItem.toString(true));
 }
 
 /**
@@ -409,6 +630,109 @@ JsonItem_Test::remove_test()
     TEST_EQUAL(testItem.size(), 2);
 }
 
+/**
+ * @brief writeTo_test
+ */
+void
+JsonItem_Test::writeTo_test()
+{
+    JsonItem testItem = getTestItem();
+    std::string output = "prefix:";
+
+    // output is appended and is the same like the result of toString
+    testItem.writeTo(output);
+    TEST_EQUAL(output, "prefix:" + testItem.toString());
+
+    output.clear();
+    testItem.writeTo(output, true);
+    TEST_EQUAL(output, testItem.toString(true));
+
+    // reused string keeps its capacity
+    const uint64_t capacity = output.capacity();
+    output.clear();
+    testItem.writeTo(output, true);
+    TEST_EQUAL(output.capacity(), capacity);
+
+    // strings with escapes before, within and after blocks of 16 characters
+    JsonItem stringItem;
+    ErrorContainer error;
+    const std::string input("[\"0123456789abcdef\\\"0123456789abcdef\\n\\t\", "
+                            "\"\\u0001\xc3\xa4\xe2\x82\xac" "0123456789abcdef0123456789\\\\\"]");
+    TEST_EQUAL(stringItem.parse(input, error), true);
+
+    output.clear();
+    stringItem.writeTo(output);
+    TEST_EQUAL(output, "[\"0123456789abcdef\\\"0123456789abcdef\\n\\t\","
+                       "\"\\u0001\xc3\xa4\xe2\x82\xac" "0123456789abcdef0123456789\\\\\"]");
+
+    JsonItem parsedAgain;
+    TEST_EQUAL(parsedAgain.parse(output, error), true);
+    TEST_EQUAL(parsedAgain.toString(), output);
+
+    // numbers
+    output.clear();
+    JsonItem numbers;
+    TEST_EQUAL(numbers.parse("[-9223372036854775807, 0, 1.5, -2.25, 1e300]", error), true);
+    numbers.writeTo(output);
+    TEST_EQUAL(output, "[-9223372036854775807,0,1.5,-2.25,1e+300]");
+
+    // invalid item writes nothing
+    output.clear();
+    JsonItem emptyItem;
+    emptyItem.writeTo(output);
+    TEST_EQUAL(output, "");
+}
+
+/**
+ * @brief writeToFile_test
+ */
+void
+JsonItem_Test::writeToFile_test()
+{
+    const std::string filePath = "/tmp/libKitsunemimiJson_writeToFile_test.json";
+    ErrorContainer error;
+
+    // output of multiple chunks
+    std::string input = "[";
+    for(uint32_t i = 0; i < 20000; i++)
+    {
+        if(i > 0) {
+            input.append(",");
+        }
+        input.append("{\"id\": " + std::to_string(i) + ", \"name\": \"entry\\n" + std::to_string(i)
+                     + "\", \"list\": [true, null, 1.5]}");
+    }
+    input.append("]");
+
+    JsonItem testItem;
+    TEST_EQUAL(testItem.parse(input, error), true);
+
+    // file-descriptor
+    const int fd = open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    TEST_EQUAL(testItem.writeTo(fd, error, true), true);
+    close(fd);
+
+    std::ifstream file(filePath);
+    std::stringstream fileContent;
+    fileContent << file.rdbuf();
+    TEST_EQUAL(fileContent.str(), testItem.toString(true));
+    unlink(filePath.c_str());
+
+    // stream
+    std::ostringstream stream;
+    TEST_EQUAL(testItem.writeTo(stream, error), true);
+    TEST_EQUAL(stream.str(), testItem.toString());
+
+    std::ostringstream smallStream;
+    TEST_EQUAL(getTestItem().writeTo(smallStream, error), true);
+    TEST_EQUAL(smallStream.str(), getTestItem().toString());
+
+    // negative tests
+    TEST_EQUAL(testItem.writeTo(-1, error), false);
+    std::ofstream closedFile;
+    TEST_EQUAL(testItem.writeTo(closedFile, error), false);
+}
+
 /**
  * @brief get a item for tests
  *
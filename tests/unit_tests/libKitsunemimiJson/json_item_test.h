@@ -25,10 +25,15 @@ public:
 private:
     void constructor_test();
     void assigmentOperator_test();
+    void moveConstructor_test();
+    void moveAssignmentOperator_test();
     void setValue_test();
     void insert_test();
     void append_test();
     void replaceItem_test();
+    void insertMove_test();
+    void appendMove_test();
+    void replaceItemMove_test();
     void deleteContent_test();
 
     void getItemContent_test();
@@ -46,6 +51,9 @@ private:
 
     void remove_test();
 
+    void writeTo_test();
+    void writeToFile_test();
+
     JsonItem getTestItem();
 };
 
@@ -0,0 +1,171 @@
+/**
+ *  @file    json_lines_parser_test.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include "json_lines_parser_test.h"
+#include <libKitsunemimiJson/json_lines_parser.h>
+
+#include <stdio.h>
+#include <unistd.h>
+
+namespace Kitsunemimi
+{
+
+JsonLinesParser_Test::JsonLinesParser_Test()
+    : Kitsunemimi::CompareTestHelper("JsonLinesParser_Test")
+{
+    parse_test();
+    parseCallback_test();
+    parseFile_test();
+}
+
+/**
+ * parse_test
+ */
+void
+JsonLinesParser_Test::parse_test()
+{
+    const std::string input("{\"id\": 1, \"name\": \"first\"}\n"
+                            "\n"
+                            "{\"id\": 2, \"tags\": [\"a\", \"b\"]}\r\n"
+                            "   \n"
+                            "{\"id\": 3, \"broken\": [1, 2}\n"
+                            "[4, 5.5, true]");
+
+    JsonLinesParser parser(4);
+    TEST_EQUAL(parser.getNumberOfThreads(), 4);
+
+    std::vector<JsonLinesParser::Record> results;
+    TEST_EQUAL(parser.parse(input, results), false);
+    TEST_EQUAL(results.size(), 4);
+
+    TEST_EQUAL(results[0].success, true);
+    TEST_EQUAL(results[0].lineNumber, 1);
+    TEST_EQUAL(results[0].item.toString(), std::string("{\"id\":1,\"name\":\"first\"}"));
+
+    TEST_EQUAL(results[1].success, true);
+    TEST_EQUAL(results[1].lineNumber, 3);
+    TEST_EQUAL(results[1].item.toString(), std::string("{\"id\":2,\"tags\":[\"a\",\"b\"]}"));
+
+    TEST_EQUAL(results[2].success, false);
+    TEST_EQUAL(results[2].lineNumber, 5);
+    TEST_EQUAL(results[2].error._errorMessages.size() > 0, true);
+
+    TEST_EQUAL(results[3].success, true);
+    TEST_EQUAL(results[3].lineNumber, 6);
+    TEST_EQUAL(results[3].item.toString(), std::string("[4,5.5,true]"));
+
+    // many records, which are splitted over multiple batches
+    std::string bigInput = "";
+    for(uint32_t i = 0; i < 5000; i++) {
+        bigInput.append("{\"id\": " + std::to_string(i) + "}\n");
+    }
+
+    TEST_EQUAL(parser.parse(bigInput, results), true);
+    TEST_EQUAL(results.size(), 5000);
+    bool ordered = true;
+    for(uint32_t i = 0; i < results.size(); i++) {
+        ordered = ordered && results[i].item["id"].getInt() == static_cast<int>(i);
+    }
+    TEST_EQUAL(ordered, true);
+
+    // empty input
+    TEST_EQUAL(parser.parse("", results), true);
+    TEST_EQUAL(results.size(), 0);
+}
+
+/**
+ * parseCallback_test
+ */
+void
+JsonLinesParser_Test::parseCallback_test()
+{
+    std::string input = "";
+    for(uint32_t i = 0; i < 5000; i++) {
+        input.append("{\"id\": " + std::to_string(i) + "}\n");
+    }
+
+    JsonLinesParser parser(3, JsonItem::SIMD_PARSER);
+
+    // all records have to be delivered in order
+    uint64_t counter = 0;
+    bool ordered = true;
+    bool result = parser.parse(input, [&](JsonLinesParser::Record &record)
+    {
+        ordered = ordered && record.lineNumber == counter + 1;
+        ordered = ordered && record.item["id"].getInt() == static_cast<int>(counter);
+        counter++;
+        return true;
+    });
+    TEST_EQUAL(result, true);
+    TEST_EQUAL(ordered, true);
+    TEST_EQUAL(counter, 5000);
+
+    // stop parsing by the callback
+    counter = 0;
+    result = parser.parse(input, [&](JsonLinesParser::Record &)
+    {
+        counter++;
+        return counter < 10;
+    });
+    TEST_EQUAL(result, false);
+    TEST_EQUAL(counter, 10);
+
+    // invalid record doesn't stop the parsing
+    counter = 0;
+    uint64_t failedLine = 0;
+    result = parser.parse("{\"a\": 1}\n{\"a\": \n[1]", [&](JsonLinesParser::Record &record)
+    {
+        if(record.success == false) {
+            failedLine = record.lineNumber;
+        }
+        counter++;
+        return true;
+    });
+    TEST_EQUAL(result, false);
+    TEST_EQUAL(counter, 3);
+    TEST_EQUAL(failedLine, 2);
+}
+
+/**
+ * parseFile_test
+ */
+void
+JsonLinesParser_Test::parseFile_test()
+{
+    const std::string filePath = "/tmp/libKitsunemimiJson_lines_parseFile_test.jsonl";
+    const std::string content = "{\"id\": 1}\n"
+                                "{\"id\": 2}\n";
+    JsonLinesParser parser(2);
+    ErrorContainer error;
+
+    // write test-file
+    FILE* file = fopen(filePath.c_str(), "w");
+    fwrite(content.c_str(), 1, content.size(), file);
+    fclose(file);
+
+    // positive test
+    std::string output = "";
+    const bool result = parser.parseFile(filePath,
+                                         [&](JsonLinesParser::Record &record)
+    {
+        output.append(record.item.toString());
+        return true;
+    }, error);
+    TEST_EQUAL(result, true);
+    TEST_EQUAL(output, std::string("{\"id\":1}{\"id\":2}"));
+
+    unlink(filePath.c_str());
+
+    // negative test
+    TEST_EQUAL(parser.parseFile(filePath,
+                                [](JsonLinesParser::Record &) { return true; },
+                                error),
+               false);
+}
+
+}  // namespace Kitsunemimi
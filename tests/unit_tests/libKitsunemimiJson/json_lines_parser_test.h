@@ -0,0 +1,30 @@
+/**
+ *  @file    json_lines_parser_test.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_LINES_PARSER_TEST_H
+#define JSON_LINES_PARSER_TEST_H
+
+#include <libKitsunemimiCommon/test_helper/compare_test_helper.h>
+
+namespace Kitsunemimi
+{
+class JsonLinesParser_Test
+        : public Kitsunemimi::CompareTestHelper
+{
+public:
+    JsonLinesParser_Test();
+
+private:
+    void parse_test();
+    void parseCallback_test();
+    void parseFile_test();
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_LINES_PARSER_TEST_H
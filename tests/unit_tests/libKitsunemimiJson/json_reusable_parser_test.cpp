@@ -0,0 +1,220 @@
+/**
+ *  @file    json_reusable_parser_test.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include "json_reusable_parser_test.h"
+#include <libKitsunemimiJson/json_reusable_parser.h>
+#include <libKitsunemimiJson/json_tape_document.h>
+#include <libKitsunemimiJson/json_tree_handler.h>
+
+#include <libKitsunemimiCommon/items/data_items.h>
+
+namespace Kitsunemimi
+{
+
+JsonReusableParser_Test::JsonReusableParser_Test()
+    : Kitsunemimi::CompareTestHelper("JsonReusableParser_Test")
+{
+    parseItem_test();
+    parseError_test();
+    recycle_test();
+    parseTape_test();
+    parseHandler_test();
+}
+
+/**
+ * parseItem_test
+ */
+void
+JsonReusableParser_Test::parseItem_test()
+{
+    const std::vector<std::string> inputs = {
+        "{\"name\": \"first\", \"list\": [1, 2.5, true, null], \"map\": {\"x\": \"a\"}}",
+        "{\"name\": \"a much longer string than before\", \"list\": [3], \"map\": {}}",
+        "[\"short\", {\"y\": false}, -42]",
+        "{\"name\": \"first\", \"name\": \"duplicate\", \"list\": [1, 2.5, true, null]}",
+        "\"only a string\"",
+        ""
+    };
+    const std::vector<std::string> expected = {
+        "{\"list\":[1,2.5,true,null],\"map\":{\"x\":\"a\"},\"name\":\"first\"}",
+        "{\"list\":[3],\"map\":{},\"name\":\"a much longer string than before\"}",
+        "[\"short\",{\"y\":false},-42]",
+        "{\"list\":[1,2.5,true,null],\"name\":\"first\"}",
+        "only a string",
+        "{}"
+    };
+
+    const JsonItem::parserTypes parserTypes[2] = {JsonItem::BISON_PARSER,
+                                                  JsonItem::SIMD_PARSER};
+    for(const JsonItem::parserTypes parserType : parserTypes)
+    {
+        JsonReusableParser parser(parserType);
+        JsonItem item;
+        ErrorContainer error;
+
+        // run twice over the inputs, so the second run uses the items of the first one
+        for(uint32_t run = 0; run < 2; run++)
+        {
+            for(uint64_t i = 0; i < inputs.size(); i++)
+            {
+                TEST_EQUAL(parser.parse(inputs[i], item, error), true);
+                TEST_EQUAL(item.toString(), expected[i]);
+            }
+        }
+
+        // result must be the same like with the normal parse-function
+        JsonItem compare;
+        TEST_EQUAL(parser.parse(inputs[0], item, error), true);
+        TEST_EQUAL(compare.parse(inputs[0], error, parserType), true);
+        TEST_EQUAL(item.toString(true), compare.toString(true));
+    }
+
+    // parse into an item, which is an arena-document
+    JsonReusableParser parser;
+    JsonItem arenaItem;
+    ErrorContainer error;
+    TEST_EQUAL(arenaItem.parse("{\"x\": [1, 2]}", error, JsonItem::DEFAULT_PARSER, false, true),
+               true);
+    TEST_EQUAL(parser.parse("{\"y\": 3}", arenaItem, error), true);
+    TEST_EQUAL(arenaItem.toString(), std::string("{\"y\":3}"));
+    TEST_EQUAL(arenaItem.insert("z", JsonItem(4)), true);
+    TEST_EQUAL(arenaItem.toString(), std::string("{\"y\":3,\"z\":4}"));
+}
+
+/**
+ * parseError_test
+ */
+void
+JsonReusableParser_Test::parseError_test()
+{
+    const JsonItem::parserTypes parserTypes[2] = {JsonItem::BISON_PARSER,
+                                                  JsonItem::SIMD_PARSER};
+    for(const JsonItem::parserTypes parserType : parserTypes)
+    {
+        JsonReusableParser parser(parserType);
+        JsonItem item;
+        ErrorContainer error;
+
+        TEST_EQUAL(parser.parse("{\"x\": [1, 2]}", item, error), true);
+
+        // the item keeps its content in case of an error
+        TEST_EQUAL(parser.parse("{\"x\": [1, 2}", item, error), false);
+        TEST_EQUAL(item.toString(), std::string("{\"x\":[1,2]}"));
+        TEST_EQUAL(parser.parse("null", item, error), false);
+        TEST_EQUAL(item.toString(), std::string("{\"x\":[1,2]}"));
+
+        // the parser is still usable after an error
+        TEST_EQUAL(parser.parse("{\"y\": \"z\"}", item, error), true);
+        TEST_EQUAL(item.toString(), std::string("{\"y\":\"z\"}"));
+
+        // strict mode
+        JsonReusableParser strictParser(parserType, true);
+        TEST_EQUAL(strictParser.parse("[\"a\\qb\"]", item, error), false);
+        TEST_EQUAL(strictParser.parse("[\"a\\nb\"]", item, error), true);
+        TEST_EQUAL(item.get(0).getString(), std::string("a\nb"));
+    }
+}
+
+/**
+ * recycle_test
+ */
+void
+JsonReusableParser_Test::recycle_test()
+{
+    JsonReusableParser parser;
+    JsonItem item;
+    ErrorContainer error;
+
+    TEST_EQUAL(parser.getNumberOfPooledItems(), 0);
+
+    // 1 map, 1 array, 3 values and 2 map-entries
+    TEST_EQUAL(parser.parse("{\"a\": [1, \"b\"], \"c\": true}", item, error), true);
+    TEST_EQUAL(parser.getNumberOfPooledItems(), 0);
+
+    parser.recycle(item);
+    TEST_EQUAL(item.isValid(), false);
+    TEST_EQUAL(parser.getNumberOfPooledItems(), 7);
+
+    // the same shape takes all items out of the pool again
+    TEST_EQUAL(parser.parse("{\"d\": [2, \"e\"], \"f\": false}", item, error), true);
+    TEST_EQUAL(parser.getNumberOfPooledItems(), 0);
+    TEST_EQUAL(item.toString(), std::string("{\"d\":[2,\"e\"],\"f\":false}"));
+
+    // the old content is given to the pool after the parsing
+    TEST_EQUAL(parser.parse("[1]", item, error), true);
+    TEST_EQUAL(parser.getNumberOfPooledItems(), 7);
+
+    parser.clearPool();
+    TEST_EQUAL(parser.getNumberOfPooledItems(), 0);
+    TEST_EQUAL(item.toString(), std::string("[1]"));
+
+    // items, which don't own their content, are not recycled
+    JsonItem root;
+    TEST_EQUAL(root.parse("{\"x\": [1, 2]}", error), true);
+    JsonItem child = root.get("x");
+    parser.recycle(child);
+    TEST_EQUAL(parser.getNumberOfPooledItems(), 0);
+    TEST_EQUAL(root.toString(), std::string("{\"x\":[1,2]}"));
+}
+
+/**
+ * parseTape_test
+ */
+void
+JsonReusableParser_Test::parseTape_test()
+{
+    const JsonItem::parserTypes parserTypes[2] = {JsonItem::BISON_PARSER,
+                                                  JsonItem::SIMD_PARSER};
+    for(const JsonItem::parserTypes parserType : parserTypes)
+    {
+        JsonReusableParser parser(parserType);
+        JsonTapeDocument document;
+        JsonTapeDocument otherDocument;
+        ErrorContainer error;
+
+        TEST_EQUAL(parser.parse("{\"a\": [1, {\"b\": \"c\"}]}", document, error), true);
+        TEST_EQUAL(document["a"][1]["b"].getString(), std::string("c"));
+
+        // the builder can be used for another document
+        TEST_EQUAL(parser.parse("[true, 2.5]", otherDocument, error), true);
+        TEST_EQUAL(otherDocument[0].getBool(), true);
+        TEST_EQUAL(document["a"][0].getLong(), 1);
+
+        TEST_EQUAL(parser.parse("{\"a\": [1, 2}", document, error), false);
+        TEST_EQUAL(document.getRoot().isValid(), false);
+
+        TEST_EQUAL(parser.parse("", document, error), true);
+        TEST_EQUAL(document.getRoot().isMap(), true);
+        TEST_EQUAL(document.getRoot().size(), 0);
+
+        TEST_EQUAL(parser.parse("{\"x\": null}", document, error), true);
+        TEST_EQUAL(document["x"].isNull(), true);
+    }
+}
+
+/**
+ * parseHandler_test
+ */
+void
+JsonReusableParser_Test::parseHandler_test()
+{
+    JsonReusableParser parser(JsonItem::SIMD_PARSER);
+    JsonTreeHandler handler;
+    ErrorContainer error;
+
+    TEST_EQUAL(parser.parse("{\"x\": [1, 2]}", handler, error), true);
+    DataItem* result = handler.stealResult();
+    TEST_EQUAL(result != nullptr, true);
+    TEST_EQUAL(JsonItem(result, true).toString(), std::string("{\"x\":[1,2]}"));
+    delete result;
+
+    TEST_EQUAL(parser.parse("{\"x\": [1, 2}", handler, error), false);
+    handler.reset();
+}
+
+}  // namespace Kitsunemimi
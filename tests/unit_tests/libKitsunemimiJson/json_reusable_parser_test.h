@@ -0,0 +1,32 @@
+/**
+ *  @file    json_reusable_parser_test.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_REUSABLE_PARSER_TEST_H
+#define JSON_REUSABLE_PARSER_TEST_H
+
+#include <libKitsunemimiCommon/test_helper/compare_test_helper.h>
+
+namespace Kitsunemimi
+{
+class JsonReusableParser_Test
+        : public Kitsunemimi::CompareTestHelper
+{
+public:
+    JsonReusableParser_Test();
+
+private:
+    void parseItem_test();
+    void parseError_test();
+    void recycle_test();
+    void parseTape_test();
+    void parseHandler_test();
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_REUSABLE_PARSER_TEST_H
@@ -0,0 +1,130 @@
+/**
+ *  @file    json_stream_parser_test.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include "json_stream_parser_test.h"
+#include <libKitsunemimiJson/json_stream_parser.h>
+#include <libKitsunemimiJson/json_item.h>
+
+namespace Kitsunemimi
+{
+
+JsonStreamParser_Test::JsonStreamParser_Test()
+    : Kitsunemimi::CompareTestHelper("JsonStreamParser_Test")
+{
+    feed_test();
+    finish_test();
+    reset_test();
+}
+
+/**
+ * feed_test
+ */
+void
+JsonStreamParser_Test::feed_test()
+{
+    const std::string input("{\"item\": "
+                            "{ \"sub_item\": \"test_value\"},"
+                            "\"item2\": "
+                            "{ \"sub_item2\": \"some\\\"thing\"},\n"
+                            "\"loop\": "
+                            "[ {\"x\" :42 }, {\"x\" :42.0 }, 1234, {\"x\" :-42.0, \"y\": true}],\n"
+                            "key_pln: a.b-c, \"x\": \"duplicate\""
+                            "}");
+
+    JsonItem expectedItem;
+    ErrorContainer error;
+    TEST_EQUAL(expectedItem.parse(input, error, JsonItem::BISON_PARSER), true);
+
+    // split the input in chunks of different sizes, so tokens are splitted in all variations
+    for(uint64_t chunkSize = 1; chunkSize <= 17; chunkSize++)
+    {
+        JsonStreamParser parser;
+        JsonItem streamItem;
+
+        bool success = true;
+        for(uint64_t pos = 0; pos < input.size(); pos += chunkSize)
+        {
+            const uint64_t size = std::min(chunkSize, input.size() - pos);
+            success = success && parser.feed(&input[pos], size, error);
+        }
+        TEST_EQUAL(success, true);
+        TEST_EQUAL(parser.finish(streamItem, error), true);
+        TEST_EQUAL(streamItem.toString(true), expectedItem.toString(true));
+    }
+
+    // negative test
+    JsonStreamParser parser;
+    TEST_EQUAL(parser.feed("{\"x\": [1, 2", 11, error), true);
+    TEST_EQUAL(parser.feed("}", 1, error), false);
+    TEST_EQUAL(parser.hasFailed(), true);
+    TEST_EQUAL(parser.feed("]}", 2, error), false);
+}
+
+/**
+ * finish_test
+ */
+void
+JsonStreamParser_Test::finish_test()
+{
+    JsonStreamParser parser;
+    JsonItem result;
+    ErrorContainer error;
+
+    // value without quotes at the end of the input is only complete with the finish
+    TEST_EQUAL(parser.feed("12", 2, error), true);
+    TEST_EQUAL(parser.feed("34", 2, error), true);
+    TEST_EQUAL(parser.finish(result, error), true);
+    TEST_EQUAL(result.isInteger(), true);
+    TEST_EQUAL(result.getLong(), 1234);
+
+    // empty input
+    TEST_EQUAL(parser.finish(result, error), true);
+    TEST_EQUAL(result.isMap(), true);
+    TEST_EQUAL(result.size(), 0);
+
+    // incomplete input
+    TEST_EQUAL(parser.feed("[1, 2", 5, error), true);
+    TEST_EQUAL(parser.finish(result, error), false);
+    TEST_EQUAL(parser.feed("[\"not closed", 12, error), true);
+    TEST_EQUAL(parser.finish(result, error), false);
+
+    // result is not changed in case of an error
+    TEST_EQUAL(result.isMap(), true);
+
+    // invalid content behind the value
+    TEST_EQUAL(parser.feed("[1] #", 5, error), false);
+    TEST_EQUAL(parser.finish(result, error), false);
+}
+
+/**
+ * reset_test
+ */
+void
+JsonStreamParser_Test::reset_test()
+{
+    JsonStreamParser parser;
+    JsonItem result;
+    ErrorContainer error;
+
+    TEST_EQUAL(parser.feed("{x: [1, ", 8, error), true);
+    parser.reset();
+    TEST_EQUAL(parser.feed("[true, ", 7, error), true);
+    TEST_EQUAL(parser.feed("false]", 6, error), true);
+    TEST_EQUAL(parser.finish(result, error), true);
+    TEST_EQUAL(result.toString(), std::string("[true,false]"));
+
+    // a failed parser can be used again after a reset
+    TEST_EQUAL(parser.feed("]", 1, error), false);
+    parser.reset();
+    TEST_EQUAL(parser.hasFailed(), false);
+    TEST_EQUAL(parser.feed("{\"a\": \"b\"}", 10, error), true);
+    TEST_EQUAL(parser.finish(result, error), true);
+    TEST_EQUAL(result.toString(), std::string("{\"a\":\"b\"}"));
+}
+
+}  // namespace Kitsunemimi
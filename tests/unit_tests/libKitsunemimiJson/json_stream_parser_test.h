@@ -0,0 +1,30 @@
+/**
+ *  @file    json_stream_parser_test.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_STREAM_PARSER_TEST_H
+#define JSON_STREAM_PARSER_TEST_H
+
+#include <libKitsunemimiCommon/test_helper/compare_test_helper.h>
+
+namespace Kitsunemimi
+{
+class JsonStreamParser_Test
+        : public Kitsunemimi::CompareTestHelper
+{
+public:
+    JsonStreamParser_Test();
+
+private:
+    void feed_test();
+    void finish_test();
+    void reset_test();
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_STREAM_PARSER_TEST_H
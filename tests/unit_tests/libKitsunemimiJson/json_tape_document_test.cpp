@@ -0,0 +1,300 @@
+/**
+ *  @file    json_tape_document_test.cpp
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#include "json_tape_document_test.h"
+#include <libKitsunemimiJson/json_tape_document.h>
+
+#include <unistd.h>
+#include <fstream>
+
+namespace Kitsunemimi
+{
+
+const std::string tapeTestInput("{\"item\": {\"sub_item\": \"test_value\", \"list\": [1, [2, \"]\"], 3]},"
+                                " \"loop\": [{\"x\": 42}, {\"x\": 42.5}, 1234, {\"x\": -42.0, y: true}],"
+                                " key_pln: a.b-c,"
+                                " \"esc\\\"aped\": \"line\\nbreak\","
+                                " \"null_value\": null,"
+                                " \"item\": \"duplicate\"}");
+
+JsonTapeDocument_Test::JsonTapeDocument_Test()
+    : Kitsunemimi::CompareTestHelper("JsonTapeDocument_Test")
+{
+    parse_test();
+    get_test();
+    checks_test();
+    toString_test();
+    hashIndex_test();
+    snapshot_test();
+}
+
+/**
+ * parse_test
+ */
+void
+JsonTapeDocument_Test::parse_test()
+{
+    JsonTapeDocument document;
+    ErrorContainer error;
+
+    // positive test
+    TEST_EQUAL(document.parse(tapeTestInput, error), true);
+    TEST_EQUAL(document.getRoot().isMap(), true);
+    TEST_EQUAL(document.parse("[1, 2]", error, JsonItem::SIMD_PARSER), true);
+    TEST_EQUAL(document.getRoot().isArray(), true);
+    TEST_EQUAL(document.parse("[1, 2]", error, JsonItem::BISON_PARSER), true);
+    TEST_EQUAL(document.getRoot().size(), 2);
+    TEST_EQUAL(document.parse("", error), true);
+    TEST_EQUAL(document.getRoot().isMap(), true);
+    TEST_EQUAL(document.getRoot().size(), 0);
+    TEST_EQUAL(document.getUsedBytes(), 16);
+
+    // negative test
+    TEST_EQUAL(document.parse("{\"x\": [1, 2}", error), false);
+    TEST_EQUAL(document.getRoot().isValid(), false);
+    TEST_EQUAL(document.parse("null", error), false);
+    TEST_EQUAL(document.getRoot().isValid(), false);
+}
+
+/**
+ * get_test
+ */
+void
+JsonTapeDocument_Test::get_test()
+{
+    JsonTapeDocument document;
+    ErrorContainer error;
+    TEST_EQUAL(document.parse(tapeTestInput, error), true);
+
+    // get by key, where the first value of a duplicate key is used
+    TEST_EQUAL(document["item"]["sub_item"].getString(), "test_value");
+    TEST_EQUAL(document["item"].get("list").get(1).get(1).getString(), "]");
+    TEST_EQUAL(document["item"]["list"][2].getInt(), 3);
+    TEST_EQUAL(document["key_pln"].getString(), "a.b-c");
+    TEST_EQUAL(document["esc\"aped"].getString(), "line\nbreak");
+
+    // get by index
+    TEST_EQUAL(document["loop"][0]["x"].getLong(), 42);
+    TEST_EQUAL(document["loop"][1]["x"].getDouble(), 42.5);
+    TEST_EQUAL(document["loop"][1]["x"].getFloat(), 42.5f);
+    TEST_EQUAL(document["loop"][2].getInt(), 1234);
+    TEST_EQUAL(document["loop"][3]["x"].getDouble(), -42.0);
+    TEST_EQUAL(document["loop"][3]["y"].getBool(), true);
+
+    // size and keys
+    TEST_EQUAL(document.getRoot().size(), 5);
+    TEST_EQUAL(document["loop"].size(), 4);
+    TEST_EQUAL(document["item"]["list"].size(), 3);
+    const std::vector<std::string> keys = document.getRoot().getKeys();
+    TEST_EQUAL(keys.size(), 5);
+    TEST_EQUAL(keys.at(0), "esc\"aped");
+    TEST_EQUAL(keys.at(1), "item");
+    TEST_EQUAL(keys.at(2), "key_pln");
+    TEST_EQUAL(document.getRoot().contains("loop"), true);
+    TEST_EQUAL(document.getRoot().contains("fail"), false);
+
+    // negative test
+    TEST_EQUAL(document["fail"].isValid(), false);
+    TEST_EQUAL(document["loop"][4].isValid(), false);
+    TEST_EQUAL(document["loop"]["x"].isValid(), false);
+    TEST_EQUAL(document["item"][0].isValid(), false);
+    TEST_EQUAL(document["fail"]["x"][1].getString(), "");
+    TEST_EQUAL(document["loop"].getString(), "");
+    TEST_EQUAL(document["loop"][2].getString(), "");
+    TEST_EQUAL(document["loop"][2].getDouble(), 0.0);
+    TEST_EQUAL(document["key_pln"].getInt(), 0);
+    TEST_EQUAL(document["key_pln"].size(), 0);
+}
+
+/**
+ * checks_test
+ */
+void
+JsonTapeDocument_Test::checks_test()
+{
+    JsonTapeDocument document;
+    ErrorContainer error;
+    TEST_EQUAL(document.parse(tapeTestInput, error), true);
+
+    TEST_EQUAL(document["item"].isMap(), true);
+    TEST_EQUAL(document["item"].isArray(), false);
+    TEST_EQUAL(document["loop"].isArray(), true);
+    TEST_EQUAL(document["loop"].isValue(), false);
+    TEST_EQUAL(document["key_pln"].isValue(), true);
+    TEST_EQUAL(document["key_pln"].isString(), true);
+    TEST_EQUAL(document["loop"][2].isInteger(), true);
+    TEST_EQUAL(document["loop"][2].isFloat(), false);
+    TEST_EQUAL(document["loop"][1]["x"].isFloat(), true);
+    TEST_EQUAL(document["loop"][3]["y"].isBool(), true);
+    TEST_EQUAL(document["null_value"].isNull(), true);
+    TEST_EQUAL(document["null_value"].isValid(), false);
+    TEST_EQUAL(document["null_value"].isValue(), false);
+}
+
+/**
+ * toString_test
+ */
+void
+JsonTapeDocument_Test::toString_test()
+{
+    JsonTapeDocument document;
+    ErrorContainer error;
+    TEST_EQUAL(document.parse(tapeTestInput, error), true);
+
+    JsonItem completeItem;
+    TEST_EQUAL(completeItem.parse(tapeTestInput, error), true);
+
+    TEST_EQUAL(document.getRoot().toString(), completeItem.toString());
+    TEST_EQUAL(document.getRoot().toString(true), completeItem.toString(true));
+    TEST_EQUAL(document["loop"].toString(true), completeItem["loop"].toString(true));
+    TEST_EQUAL(document["loop"][2].toString(), "1234");
+    TEST_EQUAL(document["key_pln"].toString(), "a.b-c");
+    TEST_EQUAL(document["null_value"].toString(), "");
+
+    // keep the order of the document
+    TEST_EQUAL(document.parse("{\"b\": 1, \"a\": {\"y\": 2, \"x\": 3}, \"b\": 4}", error), true);
+    TEST_EQUAL(document.getRoot().toString(), "{\"a\":{\"x\":3,\"y\":2},\"b\":1}");
+    TEST_EQUAL(document.getRoot().toString(false, true), "{\"b\":1,\"a\":{\"y\":2,\"x\":3}}");
+}
+
+/**
+ * hashIndex_test
+ */
+void
+JsonTapeDocument_Test::hashIndex_test()
+{
+    // big map with keys in reverse order and a duplicate key at the end
+    std::string input = "{";
+    for(uint32_t i = 100; i > 0; i--) {
+        input.append("\"key_" + std::to_string(i) + "\": " + std::to_string(i) + ", ");
+    }
+    input.append("\"key_42\": \"duplicate\"}");
+
+    JsonTapeDocument document;
+    ErrorContainer error;
+    TEST_EQUAL(document.parse(input, error), true);
+
+    JsonTapeItem root = document.getRoot();
+    TEST_EQUAL(root.size(), 100);
+    TEST_EQUAL(root["key_1"].getInt(), 1);
+    TEST_EQUAL(root["key_42"].getInt(), 42);
+    TEST_EQUAL(root["key_100"].getInt(), 100);
+    TEST_EQUAL(root.contains("key_77"), true);
+    TEST_EQUAL(root.contains("key_0"), false);
+    TEST_EQUAL(root.contains("key_1000"), false);
+
+    bool allFound = true;
+    for(uint32_t i = 1; i <= 100; i++) {
+        allFound = allFound && root.get("key_" + std::to_string(i)).getInt() == static_cast<int>(i);
+    }
+    TEST_EQUAL(allFound, true);
+
+    // keys in sorted order and in document order
+    std::vector<std::string> keys = root.getKeys();
+    TEST_EQUAL(keys.size(), 100);
+    TEST_EQUAL(keys.at(0), "key_1");
+    TEST_EQUAL(keys.at(1), "key_10");
+    keys = root.getKeys(true);
+    TEST_EQUAL(keys.size(), 100);
+    TEST_EQUAL(keys.at(0), "key_100");
+    TEST_EQUAL(keys.at(99), "key_1");
+
+    JsonItem completeItem;
+    TEST_EQUAL(completeItem.parse(input, error), true);
+    TEST_EQUAL(root.toString(), completeItem.toString());
+}
+
+/**
+ * snapshot_test
+ */
+void
+JsonTapeDocument_Test::snapshot_test()
+{
+    const std::string filePath = "/tmp/libKitsunemimiJson_snapshot_test.tape";
+    ErrorContainer error;
+
+    JsonTapeDocument document;
+    TEST_EQUAL(document.parse(tapeTestInput, error), true);
+    TEST_EQUAL(document.isSnapshot(), false);
+    TEST_EQUAL(document.saveSnapshot(filePath, error), true);
+
+    // the loaded snapshot contains the same content without parsing
+    JsonTapeDocument snapshot;
+    TEST_EQUAL(snapshot.loadSnapshot(filePath, error), true);
+    TEST_EQUAL(snapshot.isSnapshot(), true);
+    TEST_EQUAL(snapshot.getUsedBytes(), document.getUsedBytes());
+    TEST_EQUAL(snapshot.getRoot().toString(true), document.getRoot().toString(true));
+    TEST_EQUAL(snapshot.getRoot().toString(false, true), document.getRoot().toString(false, true));
+    TEST_EQUAL(snapshot["item"]["sub_item"].getString(), "test_value");
+    TEST_EQUAL(snapshot["item"]["list"][1][1].getStringView(), std::string_view("]"));
+    TEST_EQUAL(snapshot["loop"][1]["x"].getDouble(), 42.5);
+    TEST_EQUAL(snapshot["loop"][2].getLong(), 1234);
+    TEST_EQUAL(snapshot["loop"][3]["y"].getBool(), true);
+    TEST_EQUAL(snapshot["null_value"].isNull(), true);
+
+    // big maps are searched with the hash-tables of the snapshot
+    std::string input = "{";
+    for(uint32_t i = 0; i < 100; i++) {
+        input.append("\"key_" + std::to_string(i) + "\": " + std::to_string(i) + ", ");
+    }
+    input.append("\"last\": [\"a\", \"b\"]}");
+    TEST_EQUAL(document.parse(input, error), true);
+    TEST_EQUAL(document.saveSnapshot(filePath, error), true);
+    TEST_EQUAL(snapshot.loadSnapshot(filePath, error), true);
+    TEST_EQUAL(snapshot.getRoot().size(), 101);
+    TEST_EQUAL(snapshot["key_77"].getInt(), 77);
+    TEST_EQUAL(snapshot["last"][1].getString(), "b");
+    TEST_EQUAL(snapshot.getRoot().contains("key_100"), false);
+
+    // a document, which parses again, doesn't use the snapshot anymore
+    TEST_EQUAL(snapshot.parse("[1]", error), true);
+    TEST_EQUAL(snapshot.isSnapshot(), false);
+    TEST_EQUAL(snapshot.getRoot().toString(), "[1]");
+
+    // snapshot of a json-item
+    JsonItem item;
+    TEST_EQUAL(item.parse(tapeTestInput, error), true);
+    TEST_EQUAL(item.saveSnapshot(filePath, error), true);
+    TEST_EQUAL(snapshot.loadSnapshot(filePath, error), true);
+    TEST_EQUAL(snapshot.getRoot().toString(), item.toString());
+    TEST_EQUAL(JsonItem("single").saveSnapshot(filePath, error), true);
+    TEST_EQUAL(snapshot.loadSnapshot(filePath, error), true);
+    TEST_EQUAL(snapshot.getRoot().getString(), "single");
+
+    // negative test
+    TEST_EQUAL(JsonItem().saveSnapshot(filePath, error), false);
+    TEST_EQUAL(JsonTapeDocument().saveSnapshot(filePath, error), false);
+    TEST_EQUAL(document.saveSnapshot("/tmp/not_existing_dir/snapshot.tape", error), false);
+    TEST_EQUAL(snapshot.loadSnapshot("/tmp/not_existing_file.tape", error), false);
+    TEST_EQUAL(snapshot.getRoot().isValid(), false);
+
+    // files, which are no snapshot or incomplete
+    TEST_EQUAL(document.saveSnapshot(filePath, error), true);
+    std::string content;
+    {
+        std::ifstream file(filePath, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    const std::string brokenContents[3] = {tapeTestInput,
+                                           content.substr(0, content.size() - 1),
+                                           content.substr(0, 40)};
+    for(const std::string &brokenContent : brokenContents)
+    {
+        {
+            std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+            file << brokenContent;
+        }
+        TEST_EQUAL(snapshot.loadSnapshot(filePath, error), false);
+        TEST_EQUAL(snapshot.isSnapshot(), false);
+    }
+
+    unlink(filePath.c_str());
+}
+
+}  // namespace Kitsunemimi
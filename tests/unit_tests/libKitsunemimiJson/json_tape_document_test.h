@@ -0,0 +1,33 @@
+/**
+ *  @file    json_tape_document_test.h
+ *
+ *  @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ *  @copyright MIT License
+ */
+
+#ifndef JSON_TAPE_DOCUMENT_TEST_H
+#define JSON_TAPE_DOCUMENT_TEST_H
+
+#include <libKitsunemimiCommon/test_helper/compare_test_helper.h>
+
+namespace Kitsunemimi
+{
+class JsonTapeDocument_Test
+        : public Kitsunemimi::CompareTestHelper
+{
+public:
+    JsonTapeDocument_Test();
+
+private:
+    void parse_test();
+    void get_test();
+    void checks_test();
+    void toString_test();
+    void hashIndex_test();
+    void snapshot_test();
+};
+
+}  // namespace Kitsunemimi
+
+#endif // JSON_TAPE_DOCUMENT_TEST_H
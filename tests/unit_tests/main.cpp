@@ -8,10 +8,28 @@
 
 #include <iostream>
 #include <libKitsunemimiJson/json_item_parseString_test.h>
+#include <libKitsunemimiJson/json_item_parseView_test.h>
 #include <libKitsunemimiJson/json_item_test.h>
+#include <libKitsunemimiJson/json_stream_parser_test.h>
+#include <libKitsunemimiJson/json_handler_test.h>
+#include <libKitsunemimiJson/json_lines_parser_test.h>
+#include <libKitsunemimiJson/json_document_test.h>
+#include <libKitsunemimiJson/json_tape_document_test.h>
+#include <libKitsunemimiJson/json_reusable_parser_test.h>
+#include <libKitsunemimiJson/json_item_binary_test.h>
+#include <libKitsunemimiJson/json_item_canonical_test.h>
 
 int main()
 {
     Kitsunemimi::JsonItem_ParseString_Test();
+    Kitsunemimi::JsonItem_ParseView_Test();
     Kitsunemimi::JsonItem_Test();
+    Kitsunemimi::JsonStreamParser_Test();
+    Kitsunemimi::JsonHandler_Test();
+    Kitsunemimi::JsonLinesParser_Test();
+    Kitsunemimi::JsonDocument_Test();
+    Kitsunemimi::JsonTapeDocument_Test();
+    Kitsunemimi::JsonReusableParser_Test();
+    Kitsunemimi::JsonItem_Binary_Test();
+    Kitsunemimi::JsonItem_Canonical_Test();
 }
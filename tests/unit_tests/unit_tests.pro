@@ -16,9 +16,27 @@ INCLUDEPATH += ../../../libKitsunemimiCommon/include
 SOURCES += \
     main.cpp \
     libKitsunemimiJson/json_item_parseString_test.cpp \
-    libKitsunemimiJson/json_item_test.cpp
+    libKitsunemimiJson/json_item_parseView_test.cpp \
+    libKitsunemimiJson/json_item_test.cpp \
+    libKitsunemimiJson/json_stream_parser_test.cpp \
+    libKitsunemimiJson/json_handler_test.cpp \
+    libKitsunemimiJson/json_lines_parser_test.cpp \
+    libKitsunemimiJson/json_document_test.cpp \
+    libKitsunemimiJson/json_tape_document_test.cpp \
+    libKitsunemimiJson/json_reusable_parser_test.cpp \
+    libKitsunemimiJson/json_item_binary_test.cpp \
+    libKitsunemimiJson/json_item_canonical_test.cpp
 
 HEADERS += \
     libKitsunemimiJson/json_item_parseString_test.h \
-    libKitsunemimiJson/json_item_test.h
+    libKitsunemimiJson/json_item_parseView_test.h \
+    libKitsunemimiJson/json_item_test.h \
+    libKitsunemimiJson/json_stream_parser_test.h \
+    libKitsunemimiJson/json_handler_test.h \
+    libKitsunemimiJson/json_lines_parser_test.h \
+    libKitsunemimiJson/json_document_test.h \
+    libKitsunemimiJson/json_tape_document_test.h \
+    libKitsunemimiJson/json_reusable_parser_test.h \
+    libKitsunemimiJson/json_item_binary_test.h \
+    libKitsunemimiJson/json_item_canonical_test.h
 